@@ -0,0 +1,895 @@
+#include "bench.hpp"
+
+#include "memory_system.hpp"
+#include "memory_allocators/gpu_free_list_allocator.hpp"
+#include "memory_allocators/gpu_offset_allocator.hpp"
+#include "object_pool.hpp"
+#include "string.hpp"
+#include "unordered_map.hpp"
+#include "resources/texture.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_map>
+
+// ///////////// //
+// BENCH TARGETS //
+// ///////////// //
+
+/// @brief Allocation interface shared by all benchmarked implementations
+class BenchTarget {
+  public:
+    /// @brief Fixed allocation size (0 if any size is supported)
+    uint64 fixed_size     = 0;
+    /// @brief Only frees in reverse allocation order are supported
+    bool   lifo_only      = false;
+    /// @brief Returned pointers can be written to
+    bool   touches_memory = true;
+    /// @brief Allocations can be made from multiple threads at once
+    bool   thread_safe    = false;
+
+    virtual ~BenchTarget() {}
+
+    virtual void*  allocate(const uint64 size) = 0;
+    virtual void   free(void* ptr)             = 0;
+    virtual uint64 get_used() const { return 0; }
+    virtual uint64 get_peak() const { return 0; }
+    virtual uint64 get_reserved() const { return 0; }
+};
+
+/// @brief Allocator used directly, without any synchronization
+class AllocatorTarget : public BenchTarget {
+  public:
+    AllocatorTarget(Allocator* const allocator) : _allocator(allocator) {
+        _allocator->init();
+    }
+    ~AllocatorTarget() { delete _allocator; }
+
+    void* allocate(const uint64 size) override {
+        return _allocator->allocate(size, 8);
+    }
+    void   free(void* ptr) override { _allocator->free(ptr); }
+    uint64 get_used() const override { return _allocator->get_used(); }
+    uint64 get_peak() const override { return _allocator->get_peak(); }
+    uint64 get_reserved() const override {
+        return _allocator->get_reserved();
+    }
+
+  private:
+    Allocator* _allocator;
+};
+
+/// @brief Allocator guarded by a mutex, same as MemorySystem does it
+class LockedTarget : public BenchTarget {
+  public:
+    LockedTarget(BenchTarget* const target) : _target(target) {
+        fixed_size     = target->fixed_size;
+        lifo_only      = target->lifo_only;
+        touches_memory = target->touches_memory;
+        thread_safe    = true;
+    }
+    ~LockedTarget() { delete _target; }
+
+    void* allocate(const uint64 size) override {
+        std::lock_guard<std::mutex> lock { _lock };
+        return _target->allocate(size);
+    }
+    void free(void* ptr) override {
+        std::lock_guard<std::mutex> lock { _lock };
+        _target->free(ptr);
+    }
+    uint64 get_used() const override { return _target->get_used(); }
+    uint64 get_peak() const override { return _target->get_peak(); }
+    uint64 get_reserved() const override { return _target->get_reserved(); }
+
+  private:
+    BenchTarget* _target;
+    std::mutex   _lock {};
+};
+
+/// @brief Tagged operator new & delete going through MemorySystem
+class TaggedTarget : public BenchTarget {
+  public:
+    TaggedTarget(const MemoryTag tag, const uint64 fixed_size = 0)
+        : _tag(tag) {
+        this->fixed_size = fixed_size;
+        thread_safe      = true;
+    }
+
+    void* allocate(const uint64 size) override {
+        return operator new(size, _tag);
+    }
+    void free(void* ptr) override { operator delete(ptr); }
+
+  private:
+    MemoryTag _tag;
+};
+
+/// @brief GPU offset allocator, handle is packed into the returned "pointer"
+class GPUOffsetTarget : public BenchTarget {
+  public:
+    GPUOffsetTarget(const uint32 total_size, const uint32 max_allocations)
+        : _allocator(total_size, max_allocations) {
+        touches_memory = false;
+    }
+
+    void* allocate(const uint64 size) override {
+        const auto allocation = _allocator.allocate((uint32) size, 8);
+        if (!allocation.is_valid()) return nullptr;
+        // Handle is offset by one, so that no result is null
+        return (void*) ((((uint64) allocation.handle + 1) << 32) |
+                        allocation.offset);
+    }
+    void free(void* ptr) override {
+        _allocator.free((uint32) (((uint64) ptr >> 32) - 1));
+    }
+    uint64 get_used() const override { return _allocator.get_used(); }
+    uint64 get_peak() const override { return _allocator.get_peak(); }
+    uint64 get_reserved() const override {
+        return _allocator.get_total_size();
+    }
+
+  private:
+    GPUOffsetAllocator _allocator;
+};
+
+/// @brief Named target factory
+struct TargetInfo {
+    const char*                   name;
+    std::function<BenchTarget*()> create;
+};
+
+static std::vector<TargetInfo> get_targets() {
+    const uint64 size = 1024 * 1024;
+    // GPU allocators return offsets, start above 0 so none of them is null
+    return {
+        { "c_allocator",
+          [] { return new AllocatorTarget(new CAllocator()); } },
+        { "linear",
+          [=] { return new AllocatorTarget(new LinearAllocator(size)); } },
+        { "stack",
+          [=] {
+              auto target = new AllocatorTarget(new StackAllocator(size));
+              target->lifo_only = true;
+              return target;
+          } },
+        { "pool",
+          [=] {
+              auto target = new AllocatorTarget(new PoolAllocator(size, 64));
+              target->fixed_size = 64;
+              return target;
+          } },
+        { "concurrent_pool",
+          [=] {
+              auto target = new AllocatorTarget(
+                  new ConcurrentPoolAllocator(size, 64)
+              );
+              target->fixed_size  = 64;
+              target->thread_safe = true;
+              return target;
+          } },
+        { "free_list_first",
+          [=] {
+              return new AllocatorTarget(new FreeListAllocator(
+                  size, FreeListAllocator::PlacementPolicy::FindFirst
+              ));
+          } },
+        { "free_list_best",
+          [=] {
+              return new AllocatorTarget(new FreeListAllocator(
+                  size, FreeListAllocator::PlacementPolicy::FindBest
+              ));
+          } },
+        { "free_list_segregated",
+          [=] {
+              return new AllocatorTarget(new FreeListAllocator(
+                  size, FreeListAllocator::PlacementPolicy::SegregatedFit
+              ));
+          } },
+        { "gpu_free_list",
+          [=] {
+              auto target = new AllocatorTarget(new GPUFreeListAllocator(
+                  256 * size,
+                  256,
+                  GPUFreeListAllocator::PlacementPolicy::FindFirst
+              ));
+              target->touches_memory = false;
+              return target;
+          } },
+        { "gpu_offset",
+          [=] {
+              return new GPUOffsetTarget(256 * size, 256 * 1024);
+          } },
+        { "tagged_new_array",
+          [] { return new TaggedTarget(MemoryTag::Array); } },
+        { "tagged_new_texture",
+          [] {
+              // Texture pool hands out object pool slot chunks
+              return new TaggedTarget(
+                  MemoryTag::Texture,
+                  sizeof(Texture) * ObjectPool<Texture>::chunk_capacity
+              );
+          } },
+    };
+}
+
+// ////////////// //
+// TRACE BUILDERS //
+// ////////////// //
+
+/// @brief Single allocation or deallocation of a trace
+struct Operation {
+    uint32 slot;
+    uint32 size;
+    bool   allocate;
+};
+
+/// @brief Pre-generated operation sequence (keeps RNG out of measurements)
+struct Trace {
+    std::vector<Operation> operations {};
+    uint32                 slot_count = 0;
+    /// @brief Fragmentation is sampled after each this many operations
+    uint64                 sample_interval = 0;
+};
+
+static Trace make_random_trace(
+    const uint32 seed,
+    const uint64 count,
+    const uint32 max_live,
+    const uint32 min_size,
+    const uint32 max_size
+) {
+    std::mt19937                            random { seed };
+    std::uniform_int_distribution<uint32>   sizes { min_size, max_size };
+    std::vector<uint32>                     live {};
+    std::vector<uint32>                     free_slots {};
+    Trace                                   trace {};
+
+    trace.slot_count = max_live;
+    for (uint32 i = 0; i < max_live; i++)
+        free_slots.push_back(max_live - 1 - i);
+
+    while (trace.operations.size() < count) {
+        // Allocate with 50% chance (always if nothing is live, never if full)
+        const bool allocate =
+            live.empty() || (!free_slots.empty() && random() % 2 == 0);
+        if (allocate) {
+            const uint32 slot = free_slots.back();
+            free_slots.pop_back();
+            live.push_back(slot);
+            trace.operations.push_back({ slot, sizes(random), true });
+        } else {
+            const uint32 index = random() % live.size();
+            const uint32 slot  = live[index];
+            live[index]        = live.back();
+            live.pop_back();
+            free_slots.push_back(slot);
+            trace.operations.push_back({ slot, 0, false });
+        }
+    }
+
+    // Free what remains
+    for (const auto slot : live)
+        trace.operations.push_back({ slot, 0, false });
+    return trace;
+}
+
+static Trace make_churn_trace(
+    const uint32 seed,
+    const uint32 live_count,
+    const uint64 churn_count,
+    const uint32 min_size,
+    const uint32 max_size
+) {
+    std::mt19937                          random { seed };
+    std::uniform_int_distribution<uint32> sizes { min_size, max_size };
+    std::vector<uint32>                   live {};
+    Trace                                 trace {};
+
+    trace.slot_count = live_count;
+
+    // Fill up, then keep the live set full by replacing random allocations
+    for (uint32 slot = 0; slot < live_count; slot++) {
+        live.push_back(slot);
+        trace.operations.push_back({ slot, sizes(random), true });
+    }
+    for (uint64 i = 0; i < churn_count; i++) {
+        const uint32 slot = live[random() % live.size()];
+        trace.operations.push_back({ slot, 0, false });
+        trace.operations.push_back({ slot, sizes(random), true });
+    }
+    for (const auto slot : live)
+        trace.operations.push_back({ slot, 0, false });
+    return trace;
+}
+
+static Trace make_ordered_trace(
+    const uint32 seed,
+    const uint64 count,
+    const uint32 batch,
+    const bool   lifo
+) {
+    std::mt19937                          random { seed };
+    std::uniform_int_distribution<uint32> sizes { 16, 512 };
+    Trace                                 trace {};
+
+    trace.slot_count = batch;
+    for (uint64 done = 0; done < count; done += 2 * batch) {
+        for (uint32 i = 0; i < batch; i++)
+            trace.operations.push_back({ i, sizes(random), true });
+        for (uint32 i = 0; i < batch; i++)
+            trace.operations.push_back({ lifo ? batch - 1 - i : i, 0, false }
+            );
+    }
+    return trace;
+}
+
+static Trace make_fragmentation_trace(
+    const uint32 seed, const uint32 rounds, const uint32 max_live
+) {
+    std::mt19937 random { seed };
+    std::vector<uint32> live {};
+    std::vector<uint32> free_slots {};
+    Trace               trace {};
+
+    trace.slot_count = max_live;
+    for (uint32 i = 0; i < max_live; i++)
+        free_slots.push_back(max_live - 1 - i);
+
+    for (uint32 round = 0; round < rounds; round++) {
+        // Size distribution drifts between small and large blocks, so freed
+        // holes often don't fit the next requests
+        const uint32 min_size = (round % 2 == 0) ? 16 : 256;
+        const uint32 max_size = (round % 2 == 0) ? 128 : 2048 + round * 64;
+        std::uniform_int_distribution<uint32> sizes { min_size, max_size };
+
+        // Fill up
+        while (!free_slots.empty()) {
+            const uint32 slot = free_slots.back();
+            free_slots.pop_back();
+            live.push_back(slot);
+            trace.operations.push_back({ slot, sizes(random), true });
+        }
+        // Free a random 3/4
+        for (uint32 i = 0; i < max_live * 3 / 4; i++) {
+            const uint32 index = random() % live.size();
+            const uint32 slot  = live[index];
+            live[index]        = live.back();
+            live.pop_back();
+            free_slots.push_back(slot);
+            trace.operations.push_back({ slot, 0, false });
+        }
+    }
+    trace.sample_interval = trace.operations.size() / rounds;
+
+    for (const auto slot : live)
+        trace.operations.push_back({ slot, 0, false });
+    return trace;
+}
+
+// ///////// //
+// WORKLOADS //
+// ///////// //
+
+static BenchResult run_trace(
+    const TargetInfo&  info,
+    const std::string& workload,
+    const Trace&       trace
+) {
+    BenchResult result {};
+    result.group      = "allocator";
+    result.target     = info.name;
+    result.workload   = workload;
+    result.operations = trace.operations.size();
+
+    std::vector<void*>  slots(trace.slot_count, nullptr);
+    std::vector<uint32> sizes(trace.slot_count, 0);
+
+    // Throughput pass
+    {
+        std::unique_ptr<BenchTarget> target { info.create() };
+        const uint64                 fixed_size = target->fixed_size;
+        const bool                   touch      = target->touches_memory;
+
+        const uint64 start = bench_now();
+        for (const auto& operation : trace.operations) {
+            if (operation.allocate) {
+                void* ptr = target->allocate(
+                    fixed_size != 0 ? fixed_size : operation.size
+                );
+                if (touch) *(uint64*) ptr = operation.size;
+                slots[operation.slot] = ptr;
+            } else target->free(slots[operation.slot]);
+        }
+        result.seconds = (bench_now() - start) * 1e-9;
+    }
+
+    // Latency & memory pass
+    std::unique_ptr<BenchTarget> target { info.create() };
+    const uint64                 fixed_size = target->fixed_size;
+    const bool                   touch      = target->touches_memory;
+    LatencyRecorder              latency {};
+    latency.reserve(trace.operations.size());
+
+    uint64 live      = 0;
+    uint64 operation_index = 0;
+    for (const auto& operation : trace.operations) {
+        const uint64 start = bench_now();
+        if (operation.allocate) {
+            const uint64 size = fixed_size != 0 ? fixed_size : operation.size;
+            void*        ptr  = target->allocate(size);
+            if (touch) *(uint64*) ptr = size;
+            slots[operation.slot] = ptr;
+            sizes[operation.slot] = size;
+            live += size;
+        } else {
+            target->free(slots[operation.slot]);
+            live -= sizes[operation.slot];
+        }
+        latency.add(bench_now() - start);
+
+        // Memory stats
+        const uint64 used = target->get_used();
+        if (live > result.peak_live_bytes) {
+            result.peak_live_bytes = live;
+            if (used > 0) result.fragmentation = 1.0 - (float64) live / used;
+        }
+        operation_index++;
+        if (trace.sample_interval != 0 &&
+            operation_index % trace.sample_interval == 0)
+            result.fragmentation_timeline.push_back(
+                used > 0 ? 1.0 - (float64) live / used : 0.0
+            );
+    }
+
+    result.p50_ns          = latency.percentile(50.0);
+    result.p99_ns          = latency.percentile(99.0);
+    result.peak_used_bytes = target->get_peak();
+    result.reserved_bytes  = target->get_reserved();
+    return result;
+}
+
+static BenchResult run_producer_consumer(
+    const TargetInfo& info, const uint64 count
+) {
+    BenchResult result {};
+    result.group      = "allocator";
+    result.target     = info.name;
+    result.workload   = "producer_consumer";
+    result.threads    = 2;
+    result.operations = 2 * count;
+
+    std::unique_ptr<BenchTarget> target { info.create() };
+    if (!target->thread_safe) target.reset(new LockedTarget(target.release()));
+    const uint64 fixed_size = target->fixed_size;
+    const bool   touch      = target->touches_memory;
+
+    // Single producer, single consumer ring buffer
+    const uint64                    capacity = 1024;
+    std::vector<std::atomic<void*>> ring(capacity);
+    for (auto& element : ring)
+        element.store(nullptr);
+
+    LatencyRecorder producer_latency {}, consumer_latency {};
+    producer_latency.reserve(count);
+    consumer_latency.reserve(count);
+
+    const uint64 start = bench_now();
+    std::thread  producer { [&] {
+        std::mt19937                          random { 7 };
+        std::uniform_int_distribution<uint32> sizes { 16, 512 };
+        for (uint64 i = 0; i < count; i++) {
+            const uint64 size = fixed_size != 0 ? fixed_size : sizes(random);
+            const uint64 begin = bench_now();
+            void*        ptr   = target->allocate(size);
+            producer_latency.add(bench_now() - begin);
+            if (touch) *(uint64*) ptr = size;
+
+            auto& element = ring[i % capacity];
+            while (element.load(std::memory_order_acquire) != nullptr)
+                std::this_thread::yield();
+            element.store(ptr, std::memory_order_release);
+        }
+    } };
+    std::thread consumer { [&] {
+        for (uint64 i = 0; i < count; i++) {
+            auto& element = ring[i % capacity];
+            void* ptr     = nullptr;
+            while ((ptr = element.load(std::memory_order_acquire)) == nullptr)
+                std::this_thread::yield();
+            element.store(nullptr, std::memory_order_release);
+
+            const uint64 begin = bench_now();
+            target->free(ptr);
+            consumer_latency.add(bench_now() - begin);
+        }
+    } };
+    producer.join();
+    consumer.join();
+    result.seconds = (bench_now() - start) * 1e-9;
+
+    producer_latency.add(consumer_latency);
+    result.p50_ns          = producer_latency.percentile(50.0);
+    result.p99_ns          = producer_latency.percentile(99.0);
+    result.peak_used_bytes = target->get_peak();
+    result.reserved_bytes  = target->get_reserved();
+    return result;
+}
+
+static BenchResult run_thread_scaling(
+    const TargetInfo& info, const Trace& trace, const uint32 thread_count
+) {
+    BenchResult result {};
+    result.group      = "allocator";
+    result.target     = info.name;
+    result.workload   = "random_sizes_mt";
+    result.threads    = thread_count;
+    result.operations = thread_count * trace.operations.size();
+
+    std::unique_ptr<BenchTarget> target { info.create() };
+    if (!target->thread_safe) target.reset(new LockedTarget(target.release()));
+    const uint64 fixed_size = target->fixed_size;
+
+    std::vector<LatencyRecorder> latencies(thread_count);
+    std::vector<std::thread>     threads {};
+    std::atomic<uint32>          ready { 0 };
+
+    const auto run = [&](const uint32 thread_index) {
+        std::vector<void*> slots(trace.slot_count, nullptr);
+        auto&              latency = latencies[thread_index];
+        latency.reserve(trace.operations.size());
+
+        // Start all at once
+        ready++;
+        while (ready.load() != thread_count)
+            std::this_thread::yield();
+
+        for (const auto& operation : trace.operations) {
+            const uint64 begin = bench_now();
+            if (operation.allocate) {
+                const uint64 size =
+                    fixed_size != 0 ? fixed_size : operation.size;
+                void* ptr = target->allocate(size);
+                *(uint64*) ptr        = size;
+                slots[operation.slot] = ptr;
+            } else target->free(slots[operation.slot]);
+            latency.add(bench_now() - begin);
+        }
+    };
+
+    const uint64 start = bench_now();
+    for (uint32 i = 0; i < thread_count; i++)
+        threads.emplace_back(run, i);
+    for (auto& thread : threads)
+        thread.join();
+    result.seconds = (bench_now() - start) * 1e-9;
+
+    for (uint32 i = 1; i < thread_count; i++)
+        latencies[0].add(latencies[i]);
+    result.p50_ns          = latencies[0].percentile(50.0);
+    result.p99_ns          = latencies[0].percentile(99.0);
+    result.peak_used_bytes = target->get_peak();
+    result.reserved_bytes  = target->get_reserved();
+    return result;
+}
+
+template<typename VectorT, typename StringT, typename MapT>
+static BenchResult run_container_workload(
+    const char* const target_name, const uint64 iterations
+) {
+    BenchResult result {};
+    result.group      = "allocator";
+    result.target     = target_name;
+    result.workload   = "container_heavy";
+    result.operations = iterations;
+
+    std::mt19937    random { 11 };
+    LatencyRecorder latency {};
+    latency.reserve(iterations);
+
+    MapT         map {};
+    const uint64 start = bench_now();
+    for (uint64 i = 0; i < iterations; i++) {
+        const uint64 begin = bench_now();
+
+        // Grow a vector
+        VectorT numbers {};
+        const uint32 count = 8 + random() % 120;
+        for (uint32 j = 0; j < count; j++)
+            numbers.push_back(j);
+
+        // Build a string
+        StringT text {};
+        for (uint32 j = 0; j < count / 8; j++)
+            text += "segment_";
+
+        // Churn a map
+        map[random() % 4096] = text;
+        map.erase(random() % 4096);
+
+        latency.add(bench_now() - begin);
+    }
+    result.seconds = (bench_now() - start) * 1e-9;
+
+    result.p50_ns = latency.percentile(50.0);
+    result.p99_ns = latency.percentile(99.0);
+    return result;
+}
+
+/// @brief Abort the run if a correctness check of a workload fails
+static void bench_check(const bool passed, const char* const description) {
+    if (passed) return;
+    std::cout << "Check failed: " << description << std::endl;
+    std::exit(EXIT_FAILURE);
+}
+
+/// @brief Live allocation of GPU offset allocator workloads
+struct GPUAllocation {
+    GPUOffsetAllocator::Allocation allocation;
+    uint32                         size;
+};
+
+/// @brief Check that live allocations lie within used regions, don't overlap
+/// and account for all used bytes
+static void check_gpu_allocations(
+    const GPUOffsetAllocator& allocator, std::vector<GPUAllocation> live
+) {
+    std::sort(live.begin(), live.end(), [](const auto& a, const auto& b) {
+        return a.allocation.offset < b.allocation.offset;
+    });
+    const auto regions = allocator.get_used_regions();
+
+    uint64 live_bytes = 0;
+    uint64 region     = 0;
+    for (uint64 i = 0; i < live.size(); i++) {
+        const uint64 start = live[i].allocation.offset;
+        const uint64 end   = start + live[i].size;
+        if (i > 0)
+            bench_check(
+                live[i - 1].allocation.offset + live[i - 1].size <= start,
+                "Live allocations overlap."
+            );
+
+        while (region < regions.size() &&
+               regions[region].offset + regions[region].size <= start)
+            region++;
+        bench_check(
+            region < regions.size() && regions[region].offset <= start &&
+                end <= regions[region].offset + regions[region].size,
+            "Live allocation is outside of used regions."
+        );
+        live_bytes += live[i].size;
+    }
+    bench_check(
+        live_bytes == allocator.get_used(),
+        "Used bytes don't match live allocations."
+    );
+}
+
+static BenchResult run_gpu_defragmentation(
+    const uint32 rounds, const uint32 max_live
+) {
+    BenchResult result {};
+    result.group    = "allocator";
+    result.target   = "gpu_offset";
+    result.workload = "defragmentation";
+
+    // Sizes are multiples of the alignment, so regions carry no padding
+    const uint32                          alignment = 8;
+    const uint32                          step_size = 64 * 1024;
+    std::mt19937                          random { 9 };
+    std::uniform_int_distribution<uint32> sizes { 2, 256 };
+
+    GPUOffsetAllocator allocator { max_live * 1024, 2 * max_live };
+
+    std::vector<GPUAllocation>       live {};
+    // Index into live of each allocation handle
+    std::vector<uint32>              live_index(4 * max_live + 1, 0);
+    Vector<GPUOffsetAllocator::Move> moves {};
+    LatencyRecorder                  latency {};
+    float64                          seconds = 0.0;
+
+    for (uint32 round = 0; round < rounds; round++) {
+        // Fill up, then free a random 3/4
+        while (live.size() < max_live) {
+            const uint32 size       = alignment * sizes(random);
+            const auto   allocation = allocator.allocate(size, alignment);
+            if (!allocation.is_valid()) break;
+            live_index[allocation.handle] = live.size();
+            live.push_back({ allocation, size });
+        }
+        const uint32 freed = live.size() * 3 / 4;
+        for (uint32 i = 0; i < freed; i++) {
+            const uint32 index = random() % live.size();
+            allocator.free(live[index].allocation.handle);
+            live[index]                               = live.back();
+            live_index[live[index].allocation.handle] = index;
+            live.pop_back();
+        }
+        check_gpu_allocations(allocator, live);
+
+        // Defragment in steps, applying each step's moves before the next
+        const uint32 used   = allocator.get_used();
+        const auto   before = allocator.get_fragmentation();
+        do {
+            moves.clear();
+            const uint64 start = bench_now();
+            allocator.plan_defragmentation(step_size, alignment, moves);
+            for (const auto& move : moves) {
+                const uint32 index = live_index[move.source_handle];
+                bench_check(
+                    live[index].allocation.handle == move.source_handle,
+                    "Move source isn't a live allocation."
+                );
+                live[index].allocation = move.apply(live[index].allocation);
+                live_index[move.destination_handle] = index;
+                allocator.free(move.source_handle);
+            }
+            const uint64 time = bench_now() - start;
+            latency.add(time);
+            seconds           += time * 1e-9;
+            result.operations += moves.size();
+
+            bench_check(
+                allocator.get_used() == used,
+                "Defragmentation changed used bytes."
+            );
+            check_gpu_allocations(allocator, live);
+        } while (!moves.empty());
+
+        const auto after = allocator.get_fragmentation();
+        bench_check(
+            (before.fragmentation == 0.0f ||
+             after.fragmentation < before.fragmentation) &&
+                after.largest_free_region >= before.largest_free_region,
+            "Defragmentation didn't reduce fragmentation."
+        );
+        result.fragmentation_timeline.push_back(after.fragmentation);
+    }
+
+    // Reported fragmentation is that of the free space, after the last round
+    result.seconds         = seconds;
+    result.p50_ns          = latency.percentile(50.0);
+    result.p99_ns          = latency.percentile(99.0);
+    result.fragmentation   = result.fragmentation_timeline.back();
+    result.peak_used_bytes = allocator.get_peak();
+    result.reserved_bytes  = allocator.get_total_size();
+    return result;
+}
+
+static BenchResult run_gpu_grow(const uint32 count, const bool free_last) {
+    BenchResult result {};
+    result.group      = "allocator";
+    result.target     = "gpu_offset";
+    result.workload   = free_last ? "grow_free_last" : "grow_used_last";
+    result.operations = count;
+
+    const uint32    block_size  = 1024;
+    const uint32    block_count = 64;
+    LatencyRecorder latency {};
+    latency.reserve(count);
+
+    for (uint32 i = 0; i < count; i++) {
+        GPUOffsetAllocator allocator { block_size * block_count, 256 };
+
+        // Fill up, last region is either a used block or 4 freed ones
+        std::vector<GPUAllocation> live {};
+        for (uint32 block = 0; block < block_count; block++)
+            live.push_back({ allocator.allocate(block_size, 8), block_size });
+        const uint32 free_tail = free_last ? 4 * block_size : 0;
+        for (uint32 block = 0; block < free_tail / block_size; block++) {
+            allocator.free(live.back().allocation.handle);
+            live.pop_back();
+        }
+
+        const uint32 old_size = allocator.get_total_size();
+        const uint64 start    = bench_now();
+        allocator.grow(2 * old_size);
+        const uint64 time = bench_now() - start;
+        latency.add(time);
+        result.seconds += time * 1e-9;
+
+        // Existing allocations are kept, added space forms a single free
+        // region together with the free tail
+        check_gpu_allocations(allocator, live);
+        const auto stats = allocator.get_fragmentation();
+        bench_check(
+            stats.free_region_count == 1 &&
+                stats.largest_free_region == old_size + free_tail,
+            "Grown space doesn't form a single free region."
+        );
+        const auto allocation = allocator.allocate(old_size + free_tail, 8);
+        bench_check(
+            allocation.is_valid() && allocation.offset == old_size - free_tail,
+            "Grown space can't be allocated."
+        );
+    }
+
+    result.p50_ns = latency.percentile(50.0);
+    result.p99_ns = latency.percentile(99.0);
+    return result;
+}
+
+// //////////////////// //
+// ALLOCATOR BENCHMARKS //
+// //////////////////// //
+
+void run_allocator_benchmarks(BenchReport& report) {
+    const auto targets = get_targets();
+
+    // Single threaded traces
+    const Trace random_trace =
+        make_random_trace(1, report.scaled(200000), 4096, 16, 1024);
+    const Trace lifo_trace =
+        make_ordered_trace(2, report.scaled(200000), 1024, true);
+    const Trace fifo_trace =
+        make_ordered_trace(3, report.scaled(200000), 1024, false);
+    const Trace fragmentation_trace = make_fragmentation_trace(
+        4, (uint32) report.scaled(32), (uint32) report.scaled(8192)
+    );
+
+    for (const auto& info : targets) {
+        std::unique_ptr<BenchTarget> probe { info.create() };
+        if (!probe->lifo_only) {
+            report.add(run_trace(info, "random_sizes", random_trace));
+            report.add(run_trace(info, "fifo", fifo_trace));
+            report.add(run_trace(info, "fragmentation", fragmentation_trace)
+            );
+        }
+        report.add(run_trace(info, "lifo", lifo_trace));
+        if (!probe->lifo_only)
+            report.add(run_producer_consumer(info, report.scaled(200000)));
+    }
+
+    // Large live set (sizes of typical vertex & index ranges)
+    const Trace large_live_trace = make_churn_trace(
+        6, (uint32) report.scaled(131072), report.scaled(100000), 64, 1024
+    );
+    for (const auto& info : targets) {
+        const std::string name = info.name;
+        if (name != "gpu_free_list" && name != "gpu_offset") continue;
+        report.add(run_trace(info, "large_live_set", large_live_trace));
+    }
+
+    // GPU offset allocator maintenance, results are checked along the way
+    report.add(run_gpu_defragmentation(
+        (uint32) report.scaled(32), (uint32) report.scaled(16384)
+    ));
+    report.add(run_gpu_grow((uint32) report.scaled(10000), false));
+    report.add(run_gpu_grow((uint32) report.scaled(10000), true));
+
+    // Thread scaling (allocators which aren't thread safe are locked)
+    const uint32 max_threads =
+        std::max(2u, std::min(8u, std::thread::hardware_concurrency()));
+    const Trace thread_trace =
+        make_random_trace(5, report.scaled(100000), 256, 16, 512);
+    for (const auto& info : targets) {
+        const std::string name = info.name;
+        if (name != "c_allocator" && name != "pool" &&
+            name != "concurrent_pool" && name != "free_list_segregated" &&
+            name != "tagged_new_array" && name != "tagged_new_texture")
+            continue;
+        for (uint32 threads = 1; threads <= max_threads; threads *= 2)
+            report.add(run_thread_scaling(info, thread_trace, threads));
+    }
+
+    // Containers
+    const uint64 iterations = report.scaled(50000);
+    report.add(run_container_workload<
+               Vector<uint32>,
+               String,
+               UnorderedMap<uint32, String>>("engine_containers", iterations)
+    );
+    report.add(run_container_workload<
+               std::vector<uint32>,
+               std::string,
+               std::unordered_map<uint32, std::string>>(
+        "std_containers", iterations
+    ));
+}
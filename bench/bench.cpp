@@ -0,0 +1,98 @@
+#include "bench.hpp"
+
+#include "memory_system.hpp"
+
+#include <algorithm> // nth_element
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+// /////////////////////////// //
+// BENCH REPORT PUBLIC METHODS //
+// /////////////////////////// //
+
+void BenchReport::add(const BenchResult& result) {
+    // Print table header for each new group
+    if (result.group != _last_group) {
+        _last_group = result.group;
+        std::cout << "\n=== " << result.group << " ===\n"
+                  << std::left << std::setw(24) << "Target" << std::setw(24)
+                  << "Workload" << std::right << std::setw(4) << "Thr"
+                  << std::setw(12) << "Mops/s" << std::setw(10) << "p50 ns"
+                  << std::setw(10) << "p99 ns" << std::setw(14) << "Peak live"
+                  << std::setw(14) << "Peak used" << std::setw(8) << "Frag"
+                  << "\n";
+    }
+
+    std::cout << std::left << std::setw(24) << result.target << std::setw(24)
+              << result.workload << std::right << std::setw(4)
+              << result.threads << std::fixed << std::setprecision(2)
+              << std::setw(12) << result.throughput() / 1e6
+              << std::setprecision(0) << std::setw(10) << result.p50_ns
+              << std::setw(10) << result.p99_ns << std::setw(14)
+              << result.peak_live_bytes << std::setw(14)
+              << result.peak_used_bytes << std::setprecision(3)
+              << std::setw(8);
+    if (result.fragmentation < 0.0) std::cout << "-";
+    else std::cout << result.fragmentation;
+    std::cout << std::defaultfloat << std::endl;
+
+    _results.push_back(result);
+}
+
+std::string BenchReport::to_json() const {
+    std::ostringstream out {};
+
+    // Build configuration
+    out << "{\"build\":{\"ndebug\":"
+#ifdef NDEBUG
+        << "true"
+#else
+        << "false"
+#endif
+        << ",\"memory_telemetry\":" << MEMORY_TELEMETRY_ENABLED
+        << ",\"memory_headerless_pools\":" << MEMORY_HEADERLESS_POOLS
+        << ",\"quick\":" << (quick ? "true" : "false") << "},\"results\":[";
+
+    for (uint64 i = 0; i < _results.size(); i++) {
+        const auto& result = _results[i];
+        out << (i > 0 ? "," : "") << "{\"group\":\"" << result.group << "\""
+            << ",\"target\":\"" << result.target << "\""
+            << ",\"workload\":\"" << result.workload << "\""
+            << ",\"threads\":" << result.threads
+            << ",\"operations\":" << result.operations
+            << ",\"seconds\":" << result.seconds
+            << ",\"throughput\":" << result.throughput()
+            << ",\"p50_ns\":" << result.p50_ns
+            << ",\"p99_ns\":" << result.p99_ns
+            << ",\"peak_live_bytes\":" << result.peak_live_bytes
+            << ",\"peak_used_bytes\":" << result.peak_used_bytes
+            << ",\"reserved_bytes\":" << result.reserved_bytes
+            << ",\"fragmentation\":";
+        if (result.fragmentation < 0.0) out << "null";
+        else out << result.fragmentation;
+        out << ",\"fragmentation_timeline\":[";
+        for (uint64 j = 0; j < result.fragmentation_timeline.size(); j++)
+            out << (j > 0 ? "," : "") << result.fragmentation_timeline[j];
+        out << "]}";
+    }
+    out << "]}";
+
+    return out.str();
+}
+
+// /////////////////////////////// //
+// LATENCY RECORDER PUBLIC METHODS //
+// /////////////////////////////// //
+
+float64 LatencyRecorder::percentile(const float64 percentile) {
+    if (_samples.empty()) return 0.0;
+
+    const uint64 index = std::min<uint64>(
+        (uint64) (percentile / 100.0 * _samples.size()), _samples.size() - 1
+    );
+    std::nth_element(
+        _samples.begin(), _samples.begin() + index, _samples.end()
+    );
+    return (float64) _samples[index];
+}
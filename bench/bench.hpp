@@ -0,0 +1,123 @@
+#pragma once
+
+#include "defines.hpp"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+// NOTE: Benchmark bookkeeping uses std containers on purpose, so that it
+// doesn't go through (and perturb) the measured memory system.
+
+/// @brief Outcome of a single benchmark run
+struct BenchResult {
+    /// @brief Benchmark group (allocator, container, ...)
+    std::string          group;
+    /// @brief Name of the measured implementation
+    std::string          target;
+    /// @brief Name of the workload
+    std::string          workload;
+    /// @brief Number of threads used
+    uint32               threads         = 1;
+    /// @brief Number of measured operations
+    uint64               operations      = 0;
+    /// @brief Wall time of the run (without per operation timers)
+    float64              seconds         = 0.0;
+    /// @brief Median operation latency in nanoseconds
+    float64              p50_ns          = 0.0;
+    /// @brief 99th percentile operation latency in nanoseconds
+    float64              p99_ns          = 0.0;
+    /// @brief Highest number of requested bytes alive at once
+    uint64               peak_live_bytes = 0;
+    /// @brief Highest number of bytes used by the allocator (0 if unknown)
+    uint64               peak_used_bytes = 0;
+    /// @brief Bytes reserved from the OS at the end of the run (0 if unknown)
+    uint64               reserved_bytes  = 0;
+    /// @brief Share of used memory not holding live data at the peak of live
+    /// bytes (negative if unknown)
+    float64              fragmentation   = -1.0;
+    /// @brief Fragmentation sampled at regular intervals during the run
+    std::vector<float64> fragmentation_timeline {};
+
+    /// @brief Operations per second
+    float64 throughput() const {
+        return (seconds > 0.0) ? operations / seconds : 0.0;
+    }
+};
+
+/**
+ * @brief Collects benchmark results. Each result is printed as a table row
+ * when added, while the whole collection can be exported as JSON.
+ */
+class BenchReport {
+  public:
+    /// @brief Scale down workloads for a fast smoke run
+    bool quick = false;
+
+    /**
+     * @brief Add and print a result
+     *
+     * @param result Result of a finished run
+     */
+    void add(const BenchResult& result);
+
+    /**
+     * @brief Export all results as a JSON document. Build configuration is
+     * included, so that results of different builds can be compared.
+     *
+     * @return std::string JSON document
+     */
+    std::string to_json() const;
+
+    /**
+     * @brief Scale an iteration count by the report mode
+     *
+     * @param count Full iteration count
+     * @return uint64 Count used for this run
+     */
+    uint64 scaled(const uint64 count) const {
+        return quick ? (count + 9) / 10 : count;
+    }
+
+  private:
+    std::vector<BenchResult> _results {};
+    std::string              _last_group {};
+};
+
+/**
+ * @brief Collects operation latency samples
+ */
+class LatencyRecorder {
+  public:
+    void reserve(const uint64 count) { _samples.reserve(count); }
+    void add(const uint64 nanoseconds) { _samples.push_back(nanoseconds); }
+    void add(const LatencyRecorder& other) {
+        _samples.insert(
+            _samples.end(), other._samples.begin(), other._samples.end()
+        );
+    }
+
+    /**
+     * @brief Compute latency percentile
+     *
+     * @param percentile Percentile in range [0, 100]
+     * @return float64 Latency in nanoseconds (0 if no samples were taken)
+     */
+    float64 percentile(const float64 percentile);
+
+  private:
+    std::vector<uint64> _samples {};
+};
+
+/// @brief Monotonic time in nanoseconds
+inline uint64 bench_now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()
+    )
+        .count();
+}
+
+// Benchmark groups
+void run_allocator_benchmarks(BenchReport& report);
+void run_container_benchmarks(BenchReport& report);
+void run_string_benchmarks(BenchReport& report);
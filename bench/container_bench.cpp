@@ -0,0 +1,570 @@
+#include "bench.hpp"
+
+#include "flat_hash_map.hpp"
+#include "flat_map.hpp"
+#include "intrusive_list.hpp"
+#include "list.hpp"
+#include "map.hpp"
+#include "slot_map.hpp"
+#include "string.hpp"
+#include "unordered_map.hpp"
+
+#include <algorithm> // min, shuffle
+#include <random>
+
+/// @brief Measured map operation
+enum class MapOperation { Insert, FindHit, FindMiss, Churn, Iterate };
+
+// Operations are timed in batches, a single lookup is too short for the timer
+static constexpr uint64 batch_size = 256;
+
+// Keeps lookups from being optimized out
+static volatile uint64 map_sink = 0;
+
+// ////////////// //
+// KEY GENERATION //
+// ////////////// //
+
+static std::vector<String> make_string_keys(
+    const uint64 count, const uint64 first, const char* const prefix
+) {
+    std::vector<String> keys {};
+    keys.reserve(count);
+    for (uint64 i = 0; i < count; i++)
+        keys.push_back(String::build(prefix, first + i));
+    return keys;
+}
+
+static std::vector<uint32> make_id_keys(
+    const uint64 count, const uint64 first
+) {
+    std::vector<uint32> keys {};
+    keys.reserve(count);
+    for (uint64 i = 0; i < count; i++)
+        keys.push_back((uint32) (first + i));
+    return keys;
+}
+
+// ///////////// //
+// MAP WORKLOADS //
+// ///////////// //
+
+template<typename MapT, typename KeyT>
+static BenchResult run_map_workload(
+    const char* const        group,
+    const char* const        target_name,
+    const std::string&       workload,
+    const MapOperation       operation,
+    const std::vector<KeyT>& keys,
+    const std::vector<KeyT>& missing_keys,
+    const uint64             operations
+) {
+    BenchResult result {};
+    result.group      = group;
+    result.target     = target_name;
+    result.workload   = workload;
+    result.operations = operations;
+
+    // Random access order, same for every target
+    std::mt19937        random { 13 };
+    std::vector<uint32> order(operations);
+    for (auto& index : order)
+        index = random() % keys.size();
+
+    MapT map {};
+    if (operation != MapOperation::Insert)
+        for (uint64 i = 0; i < keys.size(); i++)
+            map[keys[i]] = i;
+
+    LatencyRecorder latency {};
+    latency.reserve(operations / batch_size + 1);
+
+    uint64       sum      = 0;
+    uint64       inserted = 0;
+    const uint64 start    = bench_now();
+    for (uint64 i = 0; i < operations; i += batch_size) {
+        const uint64 count = std::min(batch_size, operations - i);
+        const uint64 begin = bench_now();
+
+        switch (operation) {
+        case MapOperation::Insert:
+            // Fill a new map once all keys are in, growth is measured too
+            for (uint64 j = 0; j < count; j++, inserted++) {
+                if (inserted == keys.size()) {
+                    map      = MapT {};
+                    inserted = 0;
+                }
+                map[keys[inserted]] = inserted;
+            }
+            break;
+        case MapOperation::FindHit:
+            for (uint64 j = 0; j < count; j++) {
+                auto it = map.find(keys[order[i + j]]);
+                if (it != map.end()) sum += it->second;
+            }
+            break;
+        case MapOperation::FindMiss:
+            for (uint64 j = 0; j < count; j++)
+                sum += map.find(missing_keys[order[i + j]]) == map.end();
+            break;
+        case MapOperation::Churn:
+            // Erase & insert back, as registries do on release & acquire
+            for (uint64 j = 0; j < count; j++) {
+                const auto& key = keys[order[i + j]];
+                map.erase(key);
+                map[key] = j;
+            }
+            break;
+        case MapOperation::Iterate:
+            // Full traversal per operation
+            for (uint64 j = 0; j < count; j++)
+                for (const auto& entry : map)
+                    sum += entry.second;
+            break;
+        }
+
+        // Average operation latency of the batch
+        latency.add((bench_now() - begin) / count);
+    }
+    result.seconds = (bench_now() - start) * 1e-9;
+    map_sink       = map_sink + sum + map.size();
+
+    result.p50_ns = latency.percentile(50.0);
+    result.p99_ns = latency.percentile(99.0);
+    return result;
+}
+
+template<typename KeyT>
+static void run_map_workloads(
+    BenchReport&             report,
+    const char* const        key_name,
+    const std::vector<KeyT>& keys,
+    const std::vector<KeyT>& missing_keys
+) {
+    const uint64 operations = report.scaled(1000000);
+
+    const std::pair<const char*, MapOperation> workloads[] = {
+        { "insert", MapOperation::Insert },
+        { "find_hit", MapOperation::FindHit },
+        { "find_miss", MapOperation::FindMiss },
+        { "churn", MapOperation::Churn }
+    };
+    for (const auto& workload : workloads) {
+        const std::string name = std::string(key_name) + "_" +
+                                 workload.first + "_" +
+                                 std::to_string(keys.size());
+        report.add(run_map_workload<UnorderedMap<KeyT, uint64>>(
+            "hash_map",
+            "unordered_map",
+            name,
+            workload.second,
+            keys,
+            missing_keys,
+            operations
+        ));
+        report.add(run_map_workload<FlatHashMap<KeyT, uint64>>(
+            "hash_map",
+            "flat_hash_map",
+            name,
+            workload.second,
+            keys,
+            missing_keys,
+            operations
+        ));
+    }
+}
+
+// Ordered maps are mostly small (sampler cache, allocation headers)
+static void run_ordered_map_workloads(
+    BenchReport& report, const uint64 count
+) {
+    const uint64 operations = report.scaled(1000000);
+    const auto   keys       = make_id_keys(count, 0);
+    const auto   missing    = make_id_keys(count, count);
+
+    const std::pair<const char*, MapOperation> workloads[] = {
+        { "find_hit", MapOperation::FindHit },
+        { "find_miss", MapOperation::FindMiss },
+        { "churn", MapOperation::Churn },
+        { "iterate", MapOperation::Iterate }
+    };
+    for (const auto& workload : workloads) {
+        const std::string name =
+            std::string(workload.first) + "_" + std::to_string(count);
+        // Each traversal visits all entries
+        const uint64 workload_operations =
+            workload.second == MapOperation::Iterate
+                ? std::max(operations / count, (uint64) 1)
+                : operations;
+        report.add(run_map_workload<Map<uint32, uint64>>(
+            "ordered_map",
+            "map",
+            name,
+            workload.second,
+            keys,
+            missing,
+            workload_operations
+        ));
+        report.add(run_map_workload<FlatMap<uint32, uint64>>(
+            "ordered_map",
+            "flat_map",
+            name,
+            workload.second,
+            keys,
+            missing,
+            workload_operations
+        ));
+    }
+}
+
+// ////////////// //
+// LIST WORKLOADS //
+// ////////////// //
+
+/// @brief List element, sized like a queued job
+struct ListElement : public IntrusiveListNode {
+    uint64 value;
+    uint64 payload[3];
+};
+
+/// @brief Node based list, every push allocates a node
+class NodeListTarget {
+  public:
+    static constexpr const char* target_name = "list";
+
+    explicit NodeListTarget(std::vector<ListElement>&) {}
+
+    void   push_back(const uint64 index) { _list.push_back({ {}, index }); }
+    uint64 pop_front() {
+        const uint64 value = _list.front().value;
+        _list.pop_front();
+        return value;
+    }
+    uint64 sum() const {
+        uint64 sum = 0;
+        for (const auto& element : _list)
+            sum += element.value;
+        return sum;
+    }
+
+  private:
+    List<ListElement> _list {};
+};
+
+/// @brief Intrusive list linking elements owned by an array
+class IntrusiveListTarget {
+  public:
+    static constexpr const char* target_name = "intrusive_list";
+
+    explicit IntrusiveListTarget(std::vector<ListElement>& elements)
+        : _elements(elements) {}
+    ~IntrusiveListTarget() { _list.clear(); }
+
+    void   push_back(const uint64 index) { _list.push_back(_elements[index]); }
+    uint64 pop_front() {
+        const uint64 value = _list.front().value;
+        _list.pop_front();
+        return value;
+    }
+    uint64 sum() const {
+        uint64 sum = 0;
+        for (const auto& element : _list)
+            sum += element.value;
+        return sum;
+    }
+
+  private:
+    std::vector<ListElement>& _elements;
+    IntrusiveList<ListElement> _list {};
+};
+
+/// @brief Measured list operation
+enum class ListOperation { Queue, Iterate };
+
+template<typename ListT>
+static BenchResult run_list_workload(
+    const std::string&  workload,
+    const ListOperation operation,
+    const uint64        count,
+    const uint64        operations
+) {
+    BenchResult result {};
+    result.group      = "list";
+    result.target     = ListT::target_name;
+    result.workload   = workload;
+    result.operations = operations;
+
+    std::vector<ListElement> elements(count);
+    for (uint64 i = 0; i < count; i++)
+        elements[i].value = i;
+
+    // Elements are linked in random order, as they would be after churn
+    std::mt19937        random { 13 };
+    std::vector<uint64> order(count);
+    for (uint64 i = 0; i < count; i++)
+        order[i] = i;
+    std::shuffle(order.begin(), order.end(), random);
+
+    ListT list { elements };
+    for (const auto index : order)
+        list.push_back(index);
+
+    LatencyRecorder latency {};
+    latency.reserve(operations / batch_size + 1);
+
+    uint64       sum   = 0;
+    const uint64 start = bench_now();
+    for (uint64 i = 0; i < operations; i += batch_size) {
+        const uint64 batch = std::min(batch_size, operations - i);
+        const uint64 begin = bench_now();
+
+        switch (operation) {
+        case ListOperation::Queue:
+            // Oldest element is requeued, as a job queue would
+            for (uint64 j = 0; j < batch; j++) {
+                const uint64 value = list.pop_front();
+                list.push_back(value);
+                sum += value;
+            }
+            break;
+        case ListOperation::Iterate:
+            for (uint64 j = 0; j < batch; j++)
+                sum += list.sum();
+            break;
+        }
+
+        latency.add((bench_now() - begin) / batch);
+    }
+    result.seconds = (bench_now() - start) * 1e-9;
+    map_sink       = map_sink + sum;
+
+    result.p50_ns = latency.percentile(50.0);
+    result.p99_ns = latency.percentile(99.0);
+    return result;
+}
+
+static void run_list_workloads(BenchReport& report, const uint64 count) {
+    const uint64 operations = report.scaled(1000000);
+    const uint64 traversals = std::max(operations / count, (uint64) 1);
+
+    const auto queue_name   = "queue_" + std::to_string(count);
+    const auto iterate_name = "iterate_" + std::to_string(count);
+    report.add(run_list_workload<NodeListTarget>(
+        queue_name, ListOperation::Queue, count, operations
+    ));
+    report.add(run_list_workload<IntrusiveListTarget>(
+        queue_name, ListOperation::Queue, count, operations
+    ));
+    report.add(run_list_workload<NodeListTarget>(
+        iterate_name, ListOperation::Iterate, count, traversals
+    ));
+    report.add(run_list_workload<IntrusiveListTarget>(
+        iterate_name, ListOperation::Iterate, count, traversals
+    ));
+}
+
+// ////////////////// //
+// SLOT MAP WORKLOADS //
+// ////////////////// //
+
+/// @brief Stored object, sized like renderer geometry data
+struct SlotElement {
+    uint64 values[6];
+};
+
+/// @brief Objects in a node based map, keyed by increasing ids (the way
+/// geometries were kept by the renderer)
+class MapRegistryTarget {
+  public:
+    static constexpr const char* target_name = "map";
+
+    uint32 insert(const SlotElement& element) {
+        _objects[_next_id] = element;
+        return _next_id++;
+    }
+    void         erase(const uint32 id) { _objects.erase(id); }
+    SlotElement* get(const uint32 id) {
+        auto it = _objects.find(id);
+        return it != _objects.end() ? &it->second : nullptr;
+    }
+    template<typename Function>
+    void for_each(Function function) {
+        for (auto& object : _objects)
+            function(object.second);
+    }
+
+  private:
+    Map<uint32, SlotElement> _objects {};
+    uint32                   _next_id = 0;
+};
+
+/// @brief Objects in a fixed capacity object pool
+class ObjectPoolTarget {
+  public:
+    static constexpr const char* target_name = "object_pool";
+
+    ObjectPoolTarget() : _objects(1 << 16, MemoryTag::Array) {}
+
+    uint32 insert(const SlotElement& element) {
+        return _objects.acquire(element).value;
+    }
+    void         erase(const uint32 id) { _objects.release(ObjectHandle(id)); }
+    SlotElement* get(const uint32 id) { return _objects.get(ObjectHandle(id)); }
+    template<typename Function>
+    void for_each(Function function) {
+        _objects.for_each([&](ObjectHandle, SlotElement& object) {
+            function(object);
+        });
+    }
+
+  private:
+    ObjectPool<SlotElement> _objects;
+};
+
+/// @brief Objects densely packed in a slot map
+class SlotMapTarget {
+  public:
+    static constexpr const char* target_name = "slot_map";
+
+    uint32 insert(const SlotElement& element) {
+        return _objects.insert(element).value;
+    }
+    void         erase(const uint32 id) { _objects.erase(ObjectHandle(id)); }
+    SlotElement* get(const uint32 id) { return _objects.get(ObjectHandle(id)); }
+    template<typename Function>
+    void for_each(Function function) {
+        for (auto& object : _objects)
+            function(object);
+    }
+
+  private:
+    SlotMap<SlotElement> _objects {};
+};
+
+/// @brief Measured slot map operation
+enum class SlotOperation { Get, Churn, Iterate };
+
+template<typename RegistryT>
+static BenchResult run_slot_workload(
+    const std::string&  workload,
+    const SlotOperation operation,
+    const uint64        count,
+    const uint64        operations
+) {
+    BenchResult result {};
+    result.group      = "slot_map";
+    result.target     = RegistryT::target_name;
+    result.workload   = workload;
+    result.operations = operations;
+
+    // Fill, then erase every other object so the live set has holes
+    RegistryT           registry {};
+    std::vector<uint32> ids {};
+    for (uint64 i = 0; i < 2 * count; i++) {
+        const auto id = registry.insert({ { i } });
+        if (i % 2 == 0) ids.push_back(id);
+        else registry.erase(id);
+    }
+
+    // Random access order, same for every target
+    std::mt19937        random { 13 };
+    std::vector<uint32> order(operations);
+    for (auto& index : order)
+        index = random() % count;
+
+    LatencyRecorder latency {};
+    latency.reserve(operations / batch_size + 1);
+
+    uint64       sum   = 0;
+    const uint64 start = bench_now();
+    for (uint64 i = 0; i < operations; i += batch_size) {
+        const uint64 batch = std::min(batch_size, operations - i);
+        const uint64 begin = bench_now();
+
+        switch (operation) {
+        case SlotOperation::Get:
+            for (uint64 j = 0; j < batch; j++)
+                sum += registry.get(ids[order[i + j]])->values[0];
+            break;
+        case SlotOperation::Churn:
+            // Destroy & recreate, as geometry reuploads do
+            for (uint64 j = 0; j < batch; j++) {
+                auto& id = ids[order[i + j]];
+                registry.erase(id);
+                id = registry.insert({ { j } });
+            }
+            break;
+        case SlotOperation::Iterate:
+            // Full traversal per operation, as renderer defragmentation does
+            for (uint64 j = 0; j < batch; j++)
+                registry.for_each([&](SlotElement& object) {
+                    sum += object.values[0];
+                });
+            break;
+        }
+
+        latency.add((bench_now() - begin) / batch);
+    }
+    result.seconds = (bench_now() - start) * 1e-9;
+    map_sink       = map_sink + sum;
+
+    result.p50_ns = latency.percentile(50.0);
+    result.p99_ns = latency.percentile(99.0);
+    return result;
+}
+
+template<typename RegistryT>
+static void run_slot_workloads(BenchReport& report, const uint64 count) {
+    const uint64 operations = report.scaled(1000000);
+    const uint64 traversals = std::max(operations / count, (uint64) 1);
+
+    report.add(run_slot_workload<RegistryT>(
+        "get_" + std::to_string(count), SlotOperation::Get, count, operations
+    ));
+    report.add(run_slot_workload<RegistryT>(
+        "churn_" + std::to_string(count),
+        SlotOperation::Churn,
+        count,
+        operations
+    ));
+    report.add(run_slot_workload<RegistryT>(
+        "iterate_" + std::to_string(count),
+        SlotOperation::Iterate,
+        count,
+        traversals
+    ));
+}
+
+// //////////////////// //
+// CONTAINER BENCHMARKS //
+// //////////////////// //
+
+void run_container_benchmarks(BenchReport& report) {
+    // Registry sized (texture & material names, geometry ids) and cache
+    // exceeding key sets
+    for (const uint64 count : { (uint64) 1000, report.scaled(100000) }) {
+        // Keys resemble resource names
+        run_map_workloads(
+            report,
+            "string",
+            make_string_keys(count, 0, "textures/material_diffuse_"),
+            make_string_keys(count, count, "textures/material_diffuse_")
+        );
+        run_map_workloads(
+            report, "id", make_id_keys(count, 0), make_id_keys(count, count)
+        );
+    }
+
+    for (const uint64 count : { (uint64) 16, (uint64) 256, (uint64) 4096 })
+        run_ordered_map_workloads(report, count);
+
+    for (const uint64 count : { (uint64) 64, (uint64) 4096 })
+        run_list_workloads(report, count);
+
+    // Scene sized & large geometry counts
+    for (const uint64 count : { (uint64) 1024, (uint64) 32768 }) {
+        run_slot_workloads<MapRegistryTarget>(report, count);
+        run_slot_workloads<ObjectPoolTarget>(report, count);
+        run_slot_workloads<SlotMapTarget>(report, count);
+    }
+}
@@ -0,0 +1,35 @@
+#include "bench.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+// Usage: VulkanEngine_bench [--quick] [output.json]
+int main(int argc, char** argv) {
+    BenchReport report {};
+    std::string output_path = "bench_results.json";
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--quick") == 0) report.quick = true;
+        else output_path = argv[i];
+    }
+
+#ifndef NDEBUG
+    std::cout << "WARNING: Benchmarking a debug build." << std::endl;
+#endif
+
+    run_allocator_benchmarks(report);
+    run_container_benchmarks(report);
+    run_string_benchmarks(report);
+
+    std::ofstream output { output_path };
+    if (!output) {
+        std::cout << "Failed to write results to " << output_path << "."
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+    output << report.to_json() << std::endl;
+    std::cout << "\nResults written to " << output_path << "." << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,199 @@
+#include "bench.hpp"
+
+#include "flat_hash_map.hpp"
+#include "string_id.hpp"
+
+#include <algorithm> // min
+#include <random>
+
+// Operations are timed in batches, a single lookup is too short for the timer
+static constexpr uint64 batch_size = 256;
+
+// Keeps lookups from being optimized out
+static volatile uint64 registry_sink = 0;
+
+/// @brief Registry entry, as kept by the texture & material systems
+struct RegistryRef {
+    uint32 handle;
+    uint64 reference_count;
+};
+
+// //////////////// //
+// REGISTRY TARGETS //
+// //////////////// //
+
+/// @brief Registry keyed by lower case names. Every call copies the name to
+/// fold its case (the way systems worked before StringId).
+class StringKeyRegistry {
+  public:
+    static constexpr const char* target_name = "string_key";
+
+    void add(const String& name, const uint32 handle) {
+        String key = name;
+        key.to_lower();
+        _refs[key] = { handle, 0 };
+    }
+    uint32 acquire(const String& name) {
+        String key = name;
+        key.to_lower();
+        auto ref = _refs.find(key);
+        ref->second.reference_count++;
+        return ref->second.handle;
+    }
+    void release(const String& name) {
+        String key = name;
+        key.to_lower();
+        _refs.find(key)->second.reference_count--;
+    }
+    uint32 find_uniform(const char* const name) {
+        return _refs.find(name)->second.handle;
+    }
+
+  private:
+    FlatHashMap<String, RegistryRef> _refs {};
+};
+
+/// @brief Registry keyed by StringId
+class StringIdRegistry {
+  public:
+    static constexpr const char* target_name = "string_id";
+
+    void add(const String& name, const uint32 handle) {
+        _refs[StringId::intern(name)] = { handle, 0 };
+    }
+    uint32 acquire(const StringView name) {
+        auto ref = _refs.find(name);
+        ref->second.reference_count++;
+        return ref->second.handle;
+    }
+    void release(const StringId id) {
+        _refs.find(id)->second.reference_count--;
+    }
+    uint32 find_uniform(const StringId id) {
+        return _refs.find(id)->second.handle;
+    }
+
+  private:
+    FlatHashMap<StringId, RegistryRef> _refs {};
+};
+
+// ////////////////// //
+// REGISTRY WORKLOADS //
+// ////////////////// //
+
+static BenchResult make_result(
+    const char* const target, const std::string& workload, const uint64 ops
+) {
+    BenchResult result {};
+    result.group      = "string_id";
+    result.target     = target;
+    result.workload   = workload;
+    result.operations = ops;
+    return result;
+}
+
+// Acquire & release of resources by name, as done by materials & geometries
+template<typename RegistryT>
+static BenchResult run_acquire_release(
+    const std::vector<String>& names, const uint64 operations
+) {
+    auto result = make_result(
+        RegistryT::target_name,
+        "acquire_release_" + std::to_string(names.size()),
+        operations
+    );
+
+    RegistryT registry {};
+    for (uint64 i = 0; i < names.size(); i++)
+        registry.add(names[i], (uint32) i);
+
+    // Random access order, same for every target
+    std::mt19937        random { 13 };
+    std::vector<uint32> order(operations);
+    for (auto& index : order)
+        index = random() % names.size();
+
+    LatencyRecorder latency {};
+    latency.reserve(operations / batch_size + 1);
+
+    uint64       sum   = 0;
+    const uint64 start = bench_now();
+    for (uint64 i = 0; i < operations; i += batch_size) {
+        const uint64 count = std::min(batch_size, operations - i);
+        const uint64 begin = bench_now();
+        for (uint64 j = 0; j < count; j++) {
+            const auto& name = names[order[i + j]];
+            sum += registry.acquire(name);
+            registry.release(name);
+        }
+        latency.add((bench_now() - begin) / count);
+    }
+    result.seconds = (bench_now() - start) * 1e-9;
+    registry_sink  = registry_sink + sum;
+
+    result.p50_ns = latency.percentile(50.0);
+    result.p99_ns = latency.percentile(99.0);
+    return result;
+}
+
+// Uniform lookup by literal name, as done by materials on every draw
+template<typename RegistryT>
+static BenchResult run_uniform_lookup(const uint64 operations) {
+    // Each iteration looks up 3 uniforms
+    const uint64 iterations = operations / 3;
+    auto         result     = make_result(
+        RegistryT::target_name, "uniform_lookup", iterations * 3
+    );
+
+    RegistryT registry {};
+    registry.add("projection", 0);
+    registry.add("view", 1);
+    registry.add("model", 2);
+    registry.add("diffuse_color", 3);
+    registry.add("diffuse_texture", 4);
+
+    LatencyRecorder latency {};
+    latency.reserve(iterations / batch_size + 1);
+
+    uint64       sum   = 0;
+    const uint64 start = bench_now();
+    for (uint64 i = 0; i < iterations; i += batch_size) {
+        const uint64 count = std::min(batch_size, iterations - i);
+        const uint64 begin = bench_now();
+        for (uint64 j = 0; j < count; j++) {
+            sum += registry.find_uniform("model");
+            sum += registry.find_uniform("diffuse_color");
+            sum += registry.find_uniform("diffuse_texture");
+        }
+        latency.add((bench_now() - begin) / (count * 3));
+    }
+    result.seconds = (bench_now() - start) * 1e-9;
+    registry_sink  = registry_sink + sum;
+
+    result.p50_ns = latency.percentile(50.0);
+    result.p99_ns = latency.percentile(99.0);
+    return result;
+}
+
+// ///////////////// //
+// STRING BENCHMARKS //
+// ///////////////// //
+
+void run_string_benchmarks(BenchReport& report) {
+    const uint64 operations = report.scaled(1000000);
+
+    // Small scene & texture system limit
+    for (const uint64 count : { (uint64) 64, (uint64) 1024 }) {
+        // Names resemble texture names, too long for small string storage
+        std::vector<String> names {};
+        names.reserve(count);
+        for (uint64 i = 0; i < count; i++)
+            names.push_back(String::build("Textures/Material_Diffuse_", i));
+
+        report.add(run_acquire_release<StringKeyRegistry>(names, operations));
+        report.add(run_acquire_release<StringIdRegistry>(names, operations));
+    }
+
+    report.add(run_uniform_lookup<StringKeyRegistry>(operations));
+    report.add(run_uniform_lookup<StringIdRegistry>(operations));
+}
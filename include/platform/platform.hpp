@@ -57,6 +57,24 @@ class Platform {
         static void write(
             std::string message, uint32 kind = 0, bool new_line = true
         );
+        /**
+         * @brief Write already formatted text to the console in a single
+         * call, without flushing per line. Meant for batched output.
+         *
+         * @param text Text, may span multiple lines
+         * @param length Text length in bytes
+         */
+        static void write_raw(const char* const text, const uint64 length);
+        /**
+         * @brief Get the control sequence which styles following text the
+         * same way write styles messages of the given kind
+         *
+         * @param kind Determins message look and importance
+         * @return const char* Control sequence, terminated by 0
+         */
+        static const char* get_style(const uint32 kind);
+        /// @brief Control sequence restoring the default text style
+        static const char* get_default_style();
         /**
          * @brief Read plain text from console
          *
@@ -65,6 +83,71 @@ class Platform {
         static std::string read();
     };
 
+    /**
+     * @brief A platform agnostic virtual memory interface. Used for reserving
+     * large memory regions directly from the OS. Physical pages of a reserved
+     * region are committed lazily, once they are first accessed.
+     */
+    class Memory {
+      public:
+        /**
+         * @brief Reserve a region of virtual memory. Its pages must be
+         * committed before they are accessed.
+         *
+         * @param size Region size in bytes (multiple of page size)
+         * @return void* Start of the reserved region, nullptr on failure
+         */
+        static void*  reserve(const uint64 size);
+        /**
+         * @brief Back a part of a reserved region with physical pages. Must
+         * be called before the pages are first accessed (no-op on platforms
+         * which commit pages on first access).
+         *
+         * @param ptr Start of the region (page aligned)
+         * @param size Region size in bytes (multiple of page size)
+         * @return true on success, false if the OS is out of memory
+         */
+        static bool   commit(void* ptr, const uint64 size);
+        /**
+         * @brief Return physical pages of a reserved region back to the OS.
+         * Region stays reserved, but its contents are discarded and pages
+         * must be committed again before reuse.
+         *
+         * @param ptr Start of the region (page aligned)
+         * @param size Region size in bytes (multiple of page size)
+         */
+        static void   decommit(void* ptr, const uint64 size);
+        /**
+         * @brief Release a region reserved with reserve
+         *
+         * @param ptr Start of the reserved region
+         * @param size Region size in bytes
+         */
+        static void   release(void* ptr, const uint64 size);
+        /**
+         * @brief Get virtual memory page size
+         * @return Page size in bytes
+         */
+        static uint64 get_page_size();
+
+        /**
+         * @brief Map a file into memory, read only. Pages are read from disk
+         * lazily, once they are first accessed.
+         *
+         * @param file_path Path to the mapped file
+         * @param size Set to the file size in bytes
+         * @return const void* Start of the mapped file, nullptr on failure
+         */
+        static const void* map_file(const char* file_path, uint64& size);
+        /**
+         * @brief Unmap a file mapped with map_file
+         *
+         * @param ptr Start of the mapped file
+         * @param size File size in bytes
+         */
+        static void        unmap_file(const void* ptr, const uint64 size);
+    };
+
     /**
      * @brief A platform agnostic render-able surface. Can be a window or the
      * entire screen.
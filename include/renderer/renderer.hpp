@@ -54,10 +54,17 @@ class Renderer {
      */
     Result<void, RuntimeError> draw_frame(const float32 delta_time);
 
+    /**
+     * @brief Check whether textures of a given pixel format can be created
+     * @param format Queried format
+     * @returns True if format is supported
+     */
+    bool supports_image_format(const ImageFormat format) const;
     /**
      * @brief Create a texture and upload its relevant data to the GPU
      * @param texture Texture to be upload
-     * @param data Raw texture image data
+     * @param data Raw texture image data, all mip levels of the texture's
+     * format
      */
     void create_texture(Texture* texture, const byte* const data);
     /**
@@ -66,6 +73,36 @@ class Renderer {
      */
     void destroy_texture(Texture* texture);
 
+    /**
+     * @brief Get a ticket covering all uploads issued so far. Texture and
+     * geometry data is uploaded asynchronously; use the ticket to find out
+     * when it is done.
+     * @return UploadTicket Ticket to poll or wait on
+     */
+    UploadTicket get_upload_ticket() const;
+    /**
+     * @brief Check whether uploads covered by a ticket are done. Doesn't block.
+     * @param ticket Ticket returned by get_upload_ticket
+     */
+    bool         is_upload_complete(const UploadTicket ticket) const;
+    /**
+     * @brief Block until uploads covered by a ticket are done
+     * @param ticket Ticket returned by get_upload_ticket
+     */
+    void         wait_for_upload(const UploadTicket ticket);
+
+    /**
+     * @brief Start grouping uploads (e.g. while loading a level). All texture
+     * and geometry uploads until the matching end_upload_batch are submitted
+     * together. Batches can be nested, only the outermost one has effect.
+     */
+    void             begin_upload_batch();
+    /**
+     * @brief Submit all uploads made since begin_upload_batch
+     * @return UploadBatchStats Batch summary, empty for nested batches
+     */
+    UploadBatchStats end_upload_batch();
+
     /**
      * @brief Create a geometry and upload its relevant data to the GPU
      * @tparam VertexType Vertex (Vertex3D) or Vertex2D
@@ -75,11 +75,22 @@ class RendererBackend {
      */
     virtual void draw_geometry(const GeometryRenderData data) {}
 
+    /**
+     * @brief Check whether textures of a given pixel format can be created
+     *
+     * @param format Queried format
+     * @return true If format is supported
+     * @return false Otherwise
+     */
+    virtual bool supports_image_format(const ImageFormat format) const {
+        return format == ImageFormat::RGBA8;
+    }
     /**
      * @brief Create a texture and upload its relevant data to the GPU
      *
      * @param texture Texture to be upload
-     * @param data Raw texture image data
+     * @param data Raw texture image data, all mip levels of the texture's
+     * format
      */
     virtual void create_texture(Texture* texture, const byte* const data) {}
     /**
@@ -89,6 +100,44 @@ class RendererBackend {
      */
     virtual void destroy_texture(Texture* texture) {}
 
+    /**
+     * @brief Get a ticket covering all uploads issued so far (texture and
+     * geometry creation). Uploads are performed asynchronously.
+     *
+     * @return UploadTicket Ticket to poll or wait on
+     */
+    virtual UploadTicket get_upload_ticket() const { return 0; }
+    /**
+     * @brief Check whether uploads covered by a ticket are done, without
+     * blocking
+     *
+     * @param ticket Ticket returned by get_upload_ticket
+     * @return true If covered uploads are done
+     * @return false Otherwise
+     */
+    virtual bool is_upload_complete(const UploadTicket ticket) const {
+        return true;
+    }
+    /**
+     * @brief Block until uploads covered by a ticket are done
+     *
+     * @param ticket Ticket returned by get_upload_ticket
+     */
+    virtual void wait_for_upload(const UploadTicket ticket) {}
+
+    /**
+     * @brief Start grouping uploads. All uploads until the matching
+     * end_upload_batch are submitted together. Batches can be nested, only the
+     * outermost one has effect.
+     */
+    virtual void             begin_upload_batch() {}
+    /**
+     * @brief Submit all uploads made since begin_upload_batch
+     *
+     * @return UploadBatchStats Batch summary, empty for nested batches
+     */
+    virtual UploadBatchStats end_upload_batch() { return {}; }
+
     /**
      * @brief Create a geometry and upload its relevant data to the GPU
      *
@@ -49,6 +49,27 @@ struct hash<Vertex> {
  */
 enum BuiltinRenderPass : uint8 { World = 0x1, UI = 0x2 };
 
+/**
+ * @brief Marks a point in the stream of GPU uploads. Once a ticket completes,
+ * all uploads issued before it was taken are finished and safe to use.
+ */
+typedef uint64 UploadTicket;
+
+/**
+ * @brief Summary of an upload batch
+ */
+struct UploadBatchStats {
+    /// @brief Bytes of texture and geometry data uploaded
+    uint64       bytes            = 0;
+    /// @brief Number of GPU submissions used. Only more than one if staging
+    /// space ran out or a frame ended during the batch.
+    uint32       submission_count = 0;
+    /// @brief Time in seconds between the start and the end of the batch
+    float64      wall_time        = 0.0;
+    /// @brief Ticket covering all uploads of the batch
+    UploadTicket ticket           = 0;
+};
+
 /**
  * @brief Geometry render packet
  */
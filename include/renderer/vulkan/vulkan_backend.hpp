@@ -4,10 +4,13 @@
 #include "vulkan_render_pass.hpp"
 #include "vulkan_command_pool.hpp"
 #include "vulkan_managed_buffer.hpp"
+#include "vulkan_staging_buffer.hpp"
+#include "vulkan_deletion_queue.hpp"
+#include "vulkan_sampler_cache.hpp"
 #include "vulkan_shader.hpp"
 #include "vulkan_settings.hpp"
 
-#include "map.hpp"
+#include "slot_map.hpp"
 
 /**
  * @brief Vulkan implementation of RendererBackend abstract class. Central class
@@ -30,9 +33,17 @@ class VulkanBackend : public RendererBackend {
 
     void draw_geometry(const GeometryRenderData data);
 
+    bool supports_image_format(const ImageFormat format) const;
     void create_texture(Texture* texture, const byte* const data);
     void destroy_texture(Texture* texture);
 
+    UploadTicket get_upload_ticket() const;
+    bool         is_upload_complete(const UploadTicket ticket) const;
+    void         wait_for_upload(const UploadTicket ticket);
+
+    void             begin_upload_batch();
+    UploadBatchStats end_upload_batch();
+
     void create_geometry(
         Geometry*             geometry,
         const Vector<Vertex>& vertices,
@@ -71,6 +82,8 @@ class VulkanBackend : public RendererBackend {
         _semaphores_render_finished;
     std::array<vk::Fence, VulkanSettings::max_frames_in_flight>
         _fences_in_flight;
+    // Number of the frame last submitted with each fence
+    std::array<uint64, VulkanSettings::max_frames_in_flight> _frame_numbers {};
 
     void create_sync_objects();
 
@@ -86,18 +99,52 @@ class VulkanBackend : public RendererBackend {
     VulkanRenderPass* _ui_render_pass;
 
     // GEOMETRY CODE
-    Map<uint32, VulkanGeometryData> _geometries;
-
-    uint32 generate_geometry_id();
+    // Indexed by geometry internal id (a slot map handle)
+    SlotMap<VulkanGeometryData> _geometries { MemoryTag::Renderer };
 
     // COMMAND CODE
     VulkanCommandPool*   _command_pool;
     VulkanCommandBuffer* _command_buffer;
 
+    // Ring through which all data is uploaded to the device
+    VulkanStagingBuffer* _staging_buffer;
+
+    // Resources waiting for the GPU to stop using them
+    VulkanDeletionQueue* _deletion_queue;
+
+    // TEXTURE CODE
+    VulkanSamplerCache* _sampler_cache;
+
+    // Upload batch state
+    uint32           _upload_batch_depth = 0;
+    float64          _upload_batch_start_time;
+    UploadBatchStats _upload_batch_start_counters;
+
     // TODO: TEMP BUFFER CODE
     VulkanManagedBuffer* _vertex_buffer;
     VulkanManagedBuffer* _index_buffer;
 
+    // Defragmentation moves made while recording each frame. Their old
+    // regions are released once the same frame is recorded again.
+    std::array<
+        Vector<VulkanManagedBuffer::Move>,
+        VulkanSettings::max_frames_in_flight>
+        _vertex_buffer_moves;
+    std::array<
+        Vector<VulkanManagedBuffer::Move>,
+        VulkanSettings::max_frames_in_flight>
+        _index_buffer_moves;
+    // Regions of geometries destroyed or re-uploaded while recording each
+    // frame. Released once the same frame is recorded again.
+    std::array<
+        Vector<VulkanManagedBuffer::Allocation>,
+        VulkanSettings::max_frames_in_flight>
+        _vertex_buffer_releases;
+    std::array<
+        Vector<VulkanManagedBuffer::Allocation>,
+        VulkanSettings::max_frames_in_flight>
+        _index_buffer_releases;
+
     // Utility buffer methods
     void create_buffers();
     void upload_data_to_buffer(
@@ -106,6 +153,8 @@ class VulkanBackend : public RendererBackend {
         vk::DeviceSize       offset,
         VulkanManagedBuffer* buffer
     );
+    void defragment_geometry_buffers(const vk::CommandBuffer& command_buffer);
+    void release_geometry_data(const VulkanGeometryData& data);
 
     // Utility geometry methods
     void create_geometry_internal(
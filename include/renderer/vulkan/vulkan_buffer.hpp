@@ -11,8 +11,9 @@ class VulkanBuffer {
     Property<vk::Buffer> handle {
         GET { return _handle; }
     };
-    /// @brief Pointer to on device memory of the allocated buffer
-    Property<vk::DeviceMemory> memory {
+    /// @brief Device memory region of the buffer. Memory is shared with other
+    /// resources, the buffer starts at the region's offset.
+    Property<VulkanMemoryAllocator::Allocation> memory {
         GET { return _memory; }
     };
     /// @brief Total buffer size in bytes
@@ -47,7 +48,8 @@ class VulkanBuffer {
     );
 
     /// @brief Bind buffer to memory
-    /// @param offset Offset at which the bind should start at
+    /// @param offset Offset at which the bind should start at, relative to the
+    /// buffer's memory region
     virtual void bind(const vk::DeviceSize offset) const;
 
     /// @brief Resize buffer. Only works for increased buffer the size.
@@ -69,7 +71,8 @@ class VulkanBuffer {
     ) const;
 
     /// @brief Locks (or maps) the buffer memory to a temporary location of host
-    /// memory, which should be unlocked before shutdown or destruction.
+    /// memory, which should be unlocked before shutdown or destruction. Host
+    /// visible memory is persistently mapped, so this is free.
     /// @param offset An offset in bytes to lock the memory at
     /// @param size The amount of memory to lock
     /// @return A pointer to a block of memory, mapped to the buffer's memory
@@ -108,21 +111,39 @@ class VulkanBuffer {
             vk::ImageAspectFlagBits::eColor
     ) const;
 
-  private:
-
+  protected:
     const VulkanDevice*                  _device;
     const vk::AllocationCallbacks* const _allocator;
 
-    vk::Buffer              _handle;
-    vk::DeviceMemory        _memory;
-    vk::DeviceSize          _size;
-    vk::BufferUsageFlags    _usage;
-    vk::MemoryPropertyFlags _properties;
+    /// @brief Copy data to the buffer replacing this one during resize. Whole
+    /// buffer is copied by default.
+    /// @param command_buffer Command buffer to which the transfer command will
+    /// be submitted
+    /// @param new_handle Handle of the replacement buffer
+    virtual void copy_data_to_resized(
+        const vk::CommandBuffer& command_buffer, const vk::Buffer& new_handle
+    ) const;
+
+    /// @brief Release buffer handle and memory replaced during resize. They
+    /// are destroyed right away by default.
+    /// @param old_handle Replaced buffer handle
+    /// @param old_memory Replaced buffer memory
+    virtual void release_replaced(
+        const vk::Buffer                  old_handle,
+        VulkanMemoryAllocator::Allocation old_memory
+    );
+
+  private:
+    vk::Buffer                        _handle;
+    VulkanMemoryAllocator::Allocation _memory;
+    vk::DeviceSize                    _size;
+    vk::BufferUsageFlags              _usage;
+    vk::MemoryPropertyFlags           _properties;
 
     vk::Buffer create_buffer(
         const vk::DeviceSize size, const vk::BufferUsageFlags usage
     ) const;
-    vk::DeviceMemory allocate_buffer_memory(
+    VulkanMemoryAllocator::Allocation allocate_buffer_memory(
         const vk::Buffer buffer, const vk::MemoryPropertyFlags properties
     ) const;
 };
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "vulkan_staging_buffer.hpp"
+
+/**
+ * @brief Deferred destruction of GPU resources. Resources are destroyed once
+ * every frame which might have used them has finished (its in-flight fence
+ * was waited on), and all uploads issued before they were queued are done.
+ * The device is never idled.
+ */
+class VulkanDeletionQueue {
+  public:
+    /**
+     * @brief Construct a new Vulkan Deletion Queue object
+     *
+     * @param device Vulkan device reference
+     * @param allocator Allocation callback used
+     * @param staging_buffer Staging buffer whose uploads might reference
+     * queued resources
+     */
+    VulkanDeletionQueue(
+        const VulkanDevice* const            device,
+        const vk::AllocationCallbacks* const allocator,
+        const VulkanStagingBuffer* const     staging_buffer
+    );
+    /// @brief Destroys all queued resources right away, device has to be idle
+    ~VulkanDeletionQueue();
+
+    // Prevent accidental copying
+    VulkanDeletionQueue(VulkanDeletionQueue const&)            = delete;
+    VulkanDeletionQueue& operator=(VulkanDeletionQueue const&) = delete;
+
+    /// @brief Queue image for destruction, queue takes ownership
+    void enqueue(VulkanImage* const image);
+    /// @brief Queue buffer for destruction, queue takes ownership
+    void enqueue(VulkanBuffer* const buffer);
+    /// @brief Queue sampler for destruction
+    void enqueue(const vk::Sampler sampler);
+
+    /// @brief End the frame being recorded. Resources queued from now on
+    /// belong to the next frame.
+    /// @returns Number of the ended frame, to be passed to release once its
+    /// fence signals
+    uint64 end_frame();
+    /// @brief Destroy resources no longer used by the GPU. Doesn't block.
+    /// @param completed_frame Number of the last frame known to be finished
+    void   release(const uint64 completed_frame);
+
+  private:
+    struct Entry {
+        VulkanImage*  image;
+        VulkanBuffer* buffer;
+        vk::Sampler   sampler;
+        // Last frame which might use the resource
+        uint64        frame;
+        // Last upload which might use the resource
+        UploadTicket  ticket;
+    };
+
+    const VulkanDevice*                  _device;
+    const vk::AllocationCallbacks* const _allocator;
+    const VulkanStagingBuffer*           _staging_buffer;
+
+    // Number of the frame being recorded
+    uint64        _frame = 1;
+    // Queued resources, in queuing order
+    Vector<Entry> _entries {};
+
+    void push(Entry entry);
+    void destroy(const Entry& entry) const;
+};
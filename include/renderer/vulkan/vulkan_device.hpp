@@ -1,6 +1,7 @@
 #pragma once
 
 #include "vulkan_types.hpp"
+#include "vulkan_memory_allocator.hpp"
 #include "logger.hpp"
 #include "property.hpp"
 
@@ -19,6 +20,10 @@ class VulkanDevice {
     Property<PhysicalDeviceInfo> info {
         GET { return _info; }
     };
+    /// @brief Allocator of device memory used by all resources
+    Property<VulkanMemoryAllocator*> memory_allocator {
+        GET { return _memory_allocator; }
+    };
 
     /**
      * @brief Construct a new Vulkan Device object
@@ -53,8 +58,9 @@ class VulkanDevice {
   private:
     const vk::AllocationCallbacks* const _allocator = nullptr;
 
-    vk::Device         _handle;
-    PhysicalDeviceInfo _info;
+    vk::Device             _handle;
+    PhysicalDeviceInfo     _info;
+    VulkanMemoryAllocator* _memory_allocator;
 
     vk::PhysicalDevice pick_physical_device(
         const vk::Instance&   vulkan_instance,
@@ -11,8 +11,8 @@ class VulkanImage {
     Property<vk::Image> handle {
         GET { return _handle; }
     };
-    /// @brief Pointer to on device memory the allocated image
-    Property<vk::DeviceMemory> memory {
+    /// @brief Device memory region of the image
+    Property<VulkanMemoryAllocator::Allocation> memory {
         GET { return _memory; }
     };
     /// @brief Image view
@@ -140,10 +140,10 @@ class VulkanImage {
     const VulkanDevice*                  _device;
     const vk::AllocationCallbacks* const _allocator;
 
-    vk::Image        _handle;
-    vk::DeviceMemory _memory;
-    vk::ImageView    _view;
-    bool             _has_view = false;
+    vk::Image                         _handle;
+    VulkanMemoryAllocator::Allocation _memory;
+    vk::ImageView                     _view;
+    bool                              _has_view = false;
 
     uint32               _width;
     uint32               _height;
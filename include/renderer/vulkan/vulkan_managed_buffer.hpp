@@ -1,17 +1,29 @@
 #pragma once
 
 #include "vulkan_buffer.hpp"
-#include "memory_allocators/gpu_free_list_allocator.hpp"
+#include "vulkan_staging_buffer.hpp"
+#include "memory_allocators/gpu_offset_allocator.hpp"
 
 /**
- * @brief Managed specification of VulkanBuffer. Utilizes a client side Free
- * list allocation method for on-device memory management of the buffer it
- * allocates.
+ * @brief Managed specification of VulkanBuffer. Utilizes a client side offset
+ * allocator for on-device memory management of the buffer it allocates. If
+ * growth is enabled, the buffer is resized whenever an allocation doesn't fit.
+ * Growth never blocks, data is copied over by the next upload batch.
  */
 class VulkanManagedBuffer : public VulkanBuffer {
   public:
     using VulkanBuffer::VulkanBuffer;
 
+    /// @brief Region of the buffer
+    typedef GPUOffsetAllocator::Allocation         Allocation;
+    /// @brief Relocation of a region made by defragmentation
+    typedef GPUOffsetAllocator::Move               Move;
+    /// @brief Free space fragmentation metrics
+    typedef GPUOffsetAllocator::FragmentationStats FragmentationStats;
+
+    /// @brief Maximum number of live allocations in a single buffer
+    static constexpr uint32 max_allocations = 32 * 1024;
+
     /**
      * @brief Construct a new Vulkan Managed Buffer object
      *
@@ -38,7 +50,9 @@ class VulkanManagedBuffer : public VulkanBuffer {
         const bool                    bind_on_create = true
     ) override;
 
-    /// @brief Resize buffer
+    /// @brief Resize buffer. Only allocated ranges are copied, all
+    /// allocations keep their offsets. Replaced buffer is destroyed once no
+    /// frame in flight can use it (see begin_frame).
     /// @param command_buffer Command buffer to witch the resize command will be
     /// submitted
     /// @param new_size New buffer size in bytes
@@ -57,15 +71,84 @@ class VulkanManagedBuffer : public VulkanBuffer {
         const vk::DeviceSize size
     ) const override;
 
-    /// @brief Allocates buffer memory.
+    /// @brief Enables growth on demand. When an allocation doesn't fit, the
+    /// buffer is resized to growth_factor times its current size (more if the
+    /// allocation requires it), up to max_size.
+    /// @param staging_buffer Staging buffer into whose upload batches the
+    /// resize copies are recorded
+    /// @param growth_factor Size multiplier applied on each growth
+    /// @param max_size Maximum buffer size in bytes (4GB at most)
+    void enable_growth(
+        VulkanStagingBuffer* const staging_buffer,
+        const float32              growth_factor,
+        const vk::DeviceSize       max_size
+    );
+
+    /// @brief Marks the start of a new frame. Should be called once per frame,
+    /// after waiting for the frame's fence. Buffers replaced by resize are
+    /// released once every frame which could have used them is done.
+    void begin_frame();
+
+    /// @brief Allocates buffer memory. Grows the buffer if enabled.
     /// @param size Requested allocation size
-    /// @returns In buffer offset at which the allocated region starts.
-    vk::DeviceSize allocate(const uint64 size, const uint64 alignment = 8);
+    /// @param alignment Required offset alignment
+    /// @returns Allocated region. Its offset is the in buffer offset at which
+    /// the region starts, its handle is required for deallocation.
+    Allocation allocate(const uint64 size, const uint64 alignment = 8);
 
     /// @brief Deallocates part of the buffer memory.
-    /// @param offset In buffer offset at which the allocated region starts.
-    void deallocate(vk::DeviceSize offset);
+    /// @param allocation Previously allocated region
+    void deallocate(const Allocation allocation);
+
+    /// @brief Records a single incremental defragmentation step. Allocations
+    /// at the end of the buffer are copied into free regions closer to its
+    /// start, followed by a barrier making the copies visible to later
+    /// transfers and vertex input. Old regions stay allocated: the caller
+    /// switches its references with Move::apply right away and deallocates
+    /// the old regions once no frame in flight can read them.
+    /// @param command_buffer Command buffer to which the copy commands will be
+    /// submitted
+    /// @param max_bytes Maximum number of bytes copied
+    /// @param alignment Alignment which all moved allocations were made with
+    /// @returns Moves made
+    Vector<Move> defragment(
+        const vk::CommandBuffer& command_buffer,
+        const uint32             max_bytes,
+        const uint32             alignment = 8
+    );
+
+    /// @brief Computes current fragmentation of the buffer memory
+    FragmentationStats get_fragmentation() const {
+        return _memory_allocator->get_fragmentation();
+    }
+
+  protected:
+    void copy_data_to_resized(
+        const vk::CommandBuffer& command_buffer, const vk::Buffer& new_handle
+    ) const override;
+    void release_replaced(
+        const vk::Buffer                  old_handle,
+        VulkanMemoryAllocator::Allocation old_memory
+    ) override;
 
   private:
-    GPUFreeListAllocator* _memory_allocator;
+    struct ReplacedBuffer {
+        vk::Buffer                        handle;
+        VulkanMemoryAllocator::Allocation memory;
+        // Frames left until no frame in flight uses the buffer
+        uint32                            frames_left;
+    };
+
+    GPUOffsetAllocator* _memory_allocator;
+
+    // Growth
+    VulkanStagingBuffer* _staging_buffer = nullptr;
+    float32              _growth_factor  = 2.0f;
+    vk::DeviceSize       _max_size       = 0;
+
+    // Moves recorded this frame, their copies haven't executed yet
+    Vector<Move>           _recorded_moves {};
+    Vector<ReplacedBuffer> _replaced_buffers {};
+
+    void grow(const uint64 required_size);
 };
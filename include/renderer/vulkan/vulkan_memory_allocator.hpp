@@ -0,0 +1,153 @@
+#pragma once
+
+#include "vulkan_types.hpp"
+#include "logger.hpp"
+#include "memory_allocators/gpu_offset_allocator.hpp"
+
+class VulkanDevice;
+
+/**
+ * @brief Device memory allocator. Instead of a separate device memory object
+ * per resource, memory is allocated in large blocks per memory type, which
+ * are then sub-allocated to buffers and images (using GPUOffsetAllocator for
+ * bookkeeping). Linear resources (buffers, linear images) and optimal images
+ * use separate blocks if the device has a buffer-image granularity, so they
+ * never share a granularity page. Resources above a size threshold get
+ * dedicated allocations. Host visible blocks are persistently mapped. Usage
+ * is tracked per memory heap.
+ */
+class VulkanMemoryAllocator {
+    // Device memory block, sub-allocated to resources
+    struct Block;
+
+  public:
+    /// @brief Region of device memory assigned to a single resource
+    struct Allocation {
+        /// @brief Device memory containing the region
+        vk::DeviceMemory memory {};
+        /// @brief Region offset within memory
+        vk::DeviceSize   offset = 0;
+        /// @brief Region size in bytes
+        vk::DeviceSize   size   = 0;
+        /// @brief Host address of the region, nullptr if memory isn't host
+        /// visible
+        byte*            mapped = nullptr;
+
+        // Owning block (nullptr for dedicated allocations) & handle in it
+        Block* block       = nullptr;
+        uint32 handle      = GPUOffsetAllocator::invalid_handle;
+        uint32 memory_type = 0;
+
+        /// @brief False if allocation failed or was freed
+        bool is_valid() const { return (bool) memory; }
+    };
+
+    /// @brief Memory usage of a single heap
+    struct HeapStats {
+        /// @brief Heap size in bytes
+        vk::DeviceSize size             = 0;
+        /// @brief Bytes the renderer is meant to stay under
+        vk::DeviceSize budget           = 0;
+        /// @brief Bytes of device memory allocated (blocks & dedicated)
+        vk::DeviceSize reserved         = 0;
+        /// @brief Bytes of device memory assigned to resources
+        vk::DeviceSize used             = 0;
+        /// @brief Number of memory blocks
+        uint32         block_count      = 0;
+        /// @brief Number of dedicated allocations
+        uint32         dedicated_count  = 0;
+        /// @brief Number of live resource allocations (dedicated included)
+        uint32         allocation_count = 0;
+    };
+
+    /**
+     * @brief Construct a new Vulkan Memory Allocator object
+     *
+     * @param device Vulkan device memory is allocated on
+     * @param allocator Allocation callback used
+     */
+    VulkanMemoryAllocator(
+        const VulkanDevice* const            device,
+        const vk::AllocationCallbacks* const allocator
+    );
+    ~VulkanMemoryAllocator();
+
+    // Prevent accidental copying
+    VulkanMemoryAllocator(VulkanMemoryAllocator const&)            = delete;
+    VulkanMemoryAllocator& operator=(VulkanMemoryAllocator const&) = delete;
+
+    /**
+     * @brief Allocate device memory for a resource. If all memory of the
+     * preferred memory type is exhausted other suitable types are tried.
+     *
+     * @param requirements Memory requirements of the resource
+     * @param properties Required memory properties
+     * @param linear True for buffers & linearly tiled images, false for
+     * optimally tiled images
+     * @return Allocation Allocated region
+     * @throws RuntimeError If no suitable memory type exists, or all of them
+     * are out of memory
+     */
+    Result<Allocation, RuntimeError> allocate(
+        const vk::MemoryRequirements& requirements,
+        const vk::MemoryPropertyFlags properties,
+        const bool                    linear
+    );
+    /**
+     * @brief Free an allocated region. Allocation is invalidated.
+     *
+     * @param allocation Region to free
+     */
+    void free(Allocation& allocation);
+
+    /// @brief Number of memory heaps
+    uint32    get_heap_count() const { return (uint32) _heap_stats.size(); }
+    /// @brief Usage statistics of a memory heap
+    HeapStats get_heap_stats(const uint32 heap_index) const {
+        return _heap_stats[heap_index];
+    }
+    /// @brief Log usage statistics of all heaps
+    void      log_stats() const;
+
+  private:
+    const VulkanDevice*                  _device;
+    const vk::AllocationCallbacks* const _allocator;
+
+    // Device memory info
+    Vector<vk::MemoryType> _memory_types {};
+    uint32                 _max_memory_object_count;
+
+    // Blocks of each pool, pools are indexed by (memory_type * 2 + !linear)
+    Vector<Vector<Block*>> _pools {};
+    Vector<HeapStats>      _heap_stats {};
+    // Block size used for each heap
+    Vector<vk::DeviceSize> _block_sizes {};
+    bool                   _separate_linear;
+    // Number of live device memory objects
+    uint32                 _memory_object_count = 0;
+
+    Allocation allocate_from_type(
+        const vk::MemoryRequirements& requirements,
+        const uint32                  memory_type,
+        const bool                    linear
+    );
+    Allocation allocate_dedicated(
+        const vk::DeviceSize size, const uint32 memory_type
+    );
+
+    Block* create_block(
+        const vk::DeviceSize size, const uint32 memory_type, const uint32 pool
+    );
+    void   destroy_block(Block* const block);
+
+    vk::DeviceMemory allocate_memory(
+        const vk::DeviceSize size, const uint32 memory_type
+    );
+    void free_memory(
+        const vk::DeviceMemory memory,
+        const vk::DeviceSize   size,
+        const uint32           memory_type
+    );
+
+    HeapStats& heap_of(const uint32 memory_type);
+};
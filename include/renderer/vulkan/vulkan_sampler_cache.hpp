@@ -0,0 +1,80 @@
+#pragma once
+
+#include "vulkan_device.hpp"
+#include "flat_map.hpp"
+
+#include <tuple> // tie
+
+/**
+ * @brief Sampler state. Samplers with equal state are interchangeable, so
+ * only one is created per state.
+ */
+struct VulkanSamplerState {
+    vk::Filter             mag_filter     = vk::Filter::eLinear;
+    vk::Filter             min_filter     = vk::Filter::eLinear;
+    vk::SamplerMipmapMode  mipmap_mode    = vk::SamplerMipmapMode::eLinear;
+    vk::SamplerAddressMode address_mode_u = vk::SamplerAddressMode::eRepeat;
+    vk::SamplerAddressMode address_mode_v = vk::SamplerAddressMode::eRepeat;
+    vk::SamplerAddressMode address_mode_w = vk::SamplerAddressMode::eRepeat;
+    /// @brief Use the maximum anisotropy supported by the device
+    bool                   anisotropy     = true;
+
+    bool operator<(const VulkanSamplerState& other) const {
+        return std::tie(
+                   mag_filter,
+                   min_filter,
+                   mipmap_mode,
+                   address_mode_u,
+                   address_mode_v,
+                   address_mode_w,
+                   anisotropy
+               ) <
+               std::tie(
+                   other.mag_filter,
+                   other.min_filter,
+                   other.mipmap_mode,
+                   other.address_mode_u,
+                   other.address_mode_v,
+                   other.address_mode_w,
+                   other.anisotropy
+               );
+    }
+};
+
+/**
+ * @brief Cache of immutable samplers, keyed by sampler state. Samplers live
+ * until the cache is destroyed. Mip level count isn't part of the state (max
+ * LOD is unclamped), the image view limits sampled levels instead.
+ */
+class VulkanSamplerCache {
+  public:
+    /**
+     * @brief Construct a new Vulkan Sampler Cache object
+     *
+     * @param device Vulkan device reference
+     * @param allocator Allocation callback used
+     */
+    VulkanSamplerCache(
+        const VulkanDevice* const            device,
+        const vk::AllocationCallbacks* const allocator
+    );
+    ~VulkanSamplerCache();
+
+    // Prevent accidental copying
+    VulkanSamplerCache(VulkanSamplerCache const&)            = delete;
+    VulkanSamplerCache& operator=(VulkanSamplerCache const&) = delete;
+
+    /// @brief Get a sampler with the given state, created on first request
+    /// @param state Requested sampler state
+    /// @returns Sampler owned by the cache
+    vk::Sampler get(const VulkanSamplerState& state);
+
+    /// @brief Number of distinct samplers created
+    uint32 get_sampler_count() const { return (uint32) _samplers.size(); }
+
+  private:
+    const VulkanDevice*                  _device;
+    const vk::AllocationCallbacks* const _allocator;
+
+    FlatMap<VulkanSamplerState, vk::Sampler> _samplers {};
+};
@@ -115,9 +115,48 @@ class VulkanSettings {
     // Anti-aliasing
     constexpr static auto max_msaa_samples = vk::SampleCountFlagBits::e16;
 
+    // Device memory
+    /// Size of memory blocks resources are sub-allocated from (smaller on
+    /// small heaps)
+    constexpr static vk::DeviceSize memory_block_size = 64 * 1024 * 1024;
+    /// Maximum number of resources in a single memory block
+    constexpr static uint32         memory_block_max_allocations = 4096;
+    /// Resources at least this large get a dedicated allocation
+    constexpr static vk::DeviceSize dedicated_allocation_threshold =
+        memory_block_size / 2;
+    /// Share of each heap's size the renderer is meant to stay under
+    constexpr static float32        memory_heap_budget = 0.8f;
+
+    // Staging
+    /// Size of the ring buffer all uploads go through. Larger uploads are
+    /// streamed through it in chunks.
+    constexpr static vk::DeviceSize staging_buffer_size = 16 * 1024 * 1024;
+
+    // Geometry buffers
+    constexpr static vk::DeviceSize vertex_buffer_initial_size =
+        4 * 1024 * 1024;
+    constexpr static vk::DeviceSize index_buffer_initial_size =
+        1024 * 1024;
+    /// Buffer size multiplier applied each time an allocation doesn't fit
+    constexpr static float32        geometry_buffer_growth_factor = 2.0f;
+    constexpr static vk::DeviceSize geometry_buffer_max_size =
+        1024 * 1024 * 1024;
+
+    // Geometry buffer defragmentation
+    /// Fragmentation (share of free memory outside of the largest free region)
+    /// above which buffers get defragmented
+    constexpr static float32 defragmentation_threshold = 0.5f;
+    /// Maximum number of bytes moved per buffer each frame
+    constexpr static uint32  defragmentation_budget    = 1024 * 1024;
+
     // Maximum object counts // TODO: Make configurable
     constexpr static uint32 max_material_count = 1024;
     constexpr static uint32 max_geometry_count = 1024;
 };
 
+static_assert(
+    VulkanSettings::max_frames_in_flight <= MemorySystem::max_frames_in_flight,
+    "Frame tagged memory doesn't support this many frames in flight."
+);
+
 // TODO: TEMP CODE
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include "vulkan_managed_buffer.hpp"
 #include "vulkan_settings.hpp"
 #include "resources/shader.hpp"
+#include "small_vector.hpp"
+#include "static_vector.hpp"
 
 class ResourceSystem;
 
@@ -20,7 +22,8 @@ struct VulkanDescriptorSetConfig {
  * @brief An instance-level shader state.
  */
 struct VulkanInstanceState {
-    uint64 offset;
+    uint64                          offset;
+    VulkanManagedBuffer::Allocation allocation;
 
     Vector<Texture*> instance_textures;
     std::array<vk::DescriptorSet, VulkanSettings::max_frames_in_flight>
@@ -68,6 +71,17 @@ class VulkanShader : public Shader {
     bool set_uniform(const uint16 id, void* value) override;
 
   private:
+    // Vertex, geometry, fragment & compute
+    const static uint32 max_stage_count         = 4;
+    // Samplers per descriptor set stored without allocation
+    const static uint32 inline_image_info_count = 8;
+
+    typedef StaticVector<vk::ShaderStageFlagBits, max_stage_count> StageList;
+    typedef StaticVector<vk::PipelineShaderStageCreateInfo, max_stage_count>
+        StageInfoList;
+    typedef SmallVector<vk::DescriptorImageInfo, inline_image_info_count>
+        ImageInfoList;
+
     const VulkanDevice*                  _device;
     const vk::AllocationCallbacks* const _allocator;
     const VulkanRenderPass*              _render_pass;
@@ -99,21 +113,17 @@ class VulkanShader : public Shader {
     vk::ShaderModule create_shader_module(
         const vk::ShaderStageFlagBits shader_stage
     ) const;
-    Vector<vk::PipelineShaderStageCreateInfo> compute_stage_infos(
-        const Vector<vk::ShaderStageFlagBits>& shader_stages
-    ) const;
+    StageInfoList compute_stage_infos(const StageList& shader_stages) const;
     Vector<vk::VertexInputAttributeDescription> compute_attributes() const;
     Vector<VulkanDescriptorSetConfig*>          compute_uniforms(
-                 const Vector<vk::ShaderStageFlagBits>& shader_stages
+                 const StageList& shader_stages
              ) const;
 
     void create_pipeline(
-        const Vector<vk::PipelineShaderStageCreateInfo>& shader_stages,
-        const vk::PipelineVertexInputStateCreateInfo&    vertex_input_info,
-        const bool                                       is_wire_frame = false
+        const StageInfoList&                          shader_stages,
+        const vk::PipelineVertexInputStateCreateInfo& vertex_input_info,
+        const bool                                    is_wire_frame = false
     );
 
-    Vector<vk::DescriptorImageInfo>& get_image_infos(
-        const Vector<Texture*>& textures
-    ) const;
+    ImageInfoList get_image_infos(const Vector<Texture*>& textures) const;
 };
\ No newline at end of file
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "renderer/renderer_types.hpp"
+#include "vulkan_buffer.hpp"
+#include "vulkan_command_pool.hpp"
+
+/**
+ * @brief Persistent, persistently mapped host visible ring buffer, used for
+ * all uploads to device local memory. Upload data is copied into the ring and
+ * transfers from it are recorded into the current batch, which executes on
+ * the dedicated transfer queue. Each batch has a graphics queue counterpart
+ * which acquires ownership of the uploaded resources and does the work
+ * transfer queues can't (e.g. mipmap generation). Both parts are tracked by a
+ * single timeline semaphore: the transfer part signals an odd value, the
+ * graphics part waits on it and signals the following even value, which is
+ * the batch's upload ticket. Ring space of a batch is reused once its ticket
+ * is reached. Uploads which don't fit into the ring are streamed through it in
+ * chunks.
+ */
+class VulkanStagingBuffer {
+  public:
+    /**
+     * @brief Construct a new Vulkan Staging Buffer object
+     *
+     * @param device Vulkan device reference
+     * @param allocator Allocation callback used
+     * @param command_pool Graphics queue command pool, used for the graphics
+     * part of each batch
+     * @param size Ring size in bytes
+     */
+    VulkanStagingBuffer(
+        const VulkanDevice* const            device,
+        const vk::AllocationCallbacks* const allocator,
+        const VulkanCommandPool* const       command_pool,
+        const vk::DeviceSize                 size
+    );
+    ~VulkanStagingBuffer();
+
+    // Prevent accidental copying
+    VulkanStagingBuffer(VulkanStagingBuffer const&)            = delete;
+    VulkanStagingBuffer& operator=(VulkanStagingBuffer const&) = delete;
+
+    /// @brief Upload data to a device buffer. Copy commands are recorded on
+    /// submit, so they always target the current handle of a buffer, even if
+    /// it was resized in between.
+    /// @param data Uploaded data, copied right away
+    /// @param size Data size in bytes
+    /// @param buffer Destination buffer
+    /// @param offset Destination offset
+    void upload_to_buffer(
+        const void* const         data,
+        const vk::DeviceSize      size,
+        const VulkanBuffer* const buffer,
+        const vk::DeviceSize      offset
+    );
+
+    /// @brief Upload a tightly packed mip chain to an image. Levels follow
+    /// each other, largest first, block compressed ones as rows of blocks.
+    /// Image has to be in transfer destination optimal layout. Its ownership
+    /// is passed to the graphics queue afterwards, with the layout unchanged.
+    /// Chains which fit into a single chunk are uploaded with a single copy.
+    /// @param data Uploaded pixel data of all mip levels, copied right away
+    /// @param block_size Size of a single texel block in bytes
+    /// @param block_extent Width & height of a texel block in texels (1 for
+    /// uncompressed formats)
+    /// @param image Destination image
+    void upload_to_image(
+        const void* const  data,
+        const uint32       block_size,
+        const uint32       block_extent,
+        VulkanImage* const image
+    );
+
+    /// @brief Get the current transfer command buffer, for commands which need
+    /// to execute in order with uploads (e.g. layout transitions). Might
+    /// change after each upload, since a full ring forces a submit.
+    /// @returns Command buffer in recording state
+    vk::CommandBuffer transfer_command_buffer();
+    /// @brief Get the current graphics command buffer, executed after the
+    /// transfers of the current batch, with ownership of uploaded resources
+    /// already acquired
+    /// @returns Command buffer in recording state
+    vk::CommandBuffer graphics_command_buffer();
+
+    /// @brief Submit all recorded uploads. Results are visible to all graphics
+    /// queue work submitted afterwards. Doesn't block.
+    void submit();
+
+    /// @brief Reclaim ring space of submitted uploads which have finished.
+    /// Doesn't block.
+    void reclaim();
+
+    /// @brief Get a ticket covering all uploads issued so far
+    UploadTicket get_ticket() const;
+    /// @brief Check whether uploads covered by a ticket are done. Doesn't
+    /// block.
+    bool         is_complete(const UploadTicket ticket) const;
+    /// @brief Block until uploads covered by a ticket are done. Submits them
+    /// first if needed.
+    void         wait(const UploadTicket ticket);
+
+    /// @brief Total bytes uploaded through the ring
+    uint64 get_uploaded_bytes() const { return _uploaded_bytes; }
+    /// @brief Total number of submitted batches
+    uint32 get_submission_count() const { return _submission_count; }
+
+  private:
+    struct Batch {
+        vk::CommandBuffer transfer_command_buffer;
+        vk::CommandBuffer graphics_command_buffer;
+        // Timeline value signaled once the whole batch is done
+        UploadTicket      ticket;
+        // Ring bytes used by this batch
+        vk::DeviceSize    size;
+    };
+    struct BufferCopy {
+        const VulkanBuffer* buffer;
+        vk::BufferCopy      region;
+    };
+
+    const VulkanDevice*                  _device;
+    const vk::AllocationCallbacks* const _allocator;
+    const VulkanCommandPool*             _command_pool;
+    VulkanCommandPool*                   _transfer_command_pool;
+
+    // Ownership transfers are only needed between different queue families
+    uint32 _transfer_family;
+    uint32 _graphics_family;
+    bool   _transfer_ownership;
+
+    VulkanBuffer*  _buffer;
+    byte*          _mapped_memory;
+    vk::DeviceSize _size;
+    vk::DeviceSize _max_chunk_size;
+    vk::DeviceSize _head = 0;
+    vk::DeviceSize _used = 0;
+
+    // Signaled by both batch parts, see class description
+    vk::Semaphore _timeline;
+    // Ticket of the last submitted batch
+    UploadTicket  _submitted_ticket = 0;
+
+    // Statistics
+    uint64 _uploaded_bytes   = 0;
+    uint32 _submission_count = 0;
+
+    // Batch being recorded
+    Batch              _batch {};
+    bool               _recording = false;
+    Vector<BufferCopy> _buffer_copies {};
+
+    // Submitted batches in submission order, and ones ready for reuse
+    Vector<Batch> _submitted_batches {};
+    Vector<Batch> _idle_batches {};
+
+    vk::DeviceSize reserve(
+        const vk::DeviceSize size, const vk::DeviceSize alignment
+    );
+    void begin_batch();
+    void record_buffer_copies();
+    void wait_for_oldest_batch();
+};
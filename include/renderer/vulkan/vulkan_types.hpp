@@ -53,8 +53,14 @@ struct PhysicalDeviceInfo {
 
     Vector<float32>        memory_size_in_gb;
     Vector<vk::MemoryType> memory_types;
+    Vector<vk::MemoryHeap> memory_heaps;
     Vector<bool>           memory_is_local;
     bool                   supports_device_local_host_visible_memory = false;
+    // BC1-7 block compressed texture formats
+    bool                   supports_texture_compression_bc           = false;
+    // Separation required between linear & optimal resources sharing memory
+    vk::DeviceSize         buffer_image_granularity;
+    uint32                 max_memory_allocation_count;
 
     // Swapchain
     std::function<SwapchainSupportDetails(const vk::SurfaceKHR&)>
@@ -107,7 +113,9 @@ struct VulkanGeometryData {
     uint32 vertex_count;
     uint32 vertex_size;
     uint32 vertex_offset;
+    uint32 vertex_allocation;
     uint32 index_count;
     uint32 index_size;
     uint32 index_offset;
+    uint32 index_allocation;
 };
\ No newline at end of file
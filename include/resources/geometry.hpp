@@ -18,7 +18,7 @@ class Geometry : public Resource {
     Geometry(String name);
     ~Geometry();
 
-    const static uint32 max_name_length = 256;
+    constexpr static uint32 max_name_length = 256;
 
   private:
     Material* _material = nullptr;
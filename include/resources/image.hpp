@@ -2,8 +2,21 @@
 
 #include "resource.hpp"
 
+/// @brief Image pixel data formats
+enum class ImageFormat : uint8 {
+    /// @brief 8 bits per channel sRGB RGBA, 4 bytes per pixel
+    RGBA8,
+    /// @brief BC1 (DXT1) block compressed opaque sRGB RGB, 8 bytes per 4x4
+    /// pixel block
+    BC1,
+    /// @brief BC3 (DXT5) block compressed sRGB RGBA, 16 bytes per 4x4 pixel
+    /// block
+    BC3
+};
+
 /**
- * @brief Image resource.
+ * @brief Image resource. Pixel data holds the whole mip chain, levels are
+ * tightly packed one after another, starting with the largest.
  *
  */
 class Image : public Resource {
@@ -24,37 +37,107 @@ class Image : public Resource {
     Property<const byte*> pixels {
         GET { return _pixels; }
     };
+    /// @brief Pixel data format
+    Property<ImageFormat> format {
+        GET { return _format; }
+    };
+    /// @brief Number of mip levels in pixel data
+    Property<uint32> mip_level_count {
+        GET { return _mip_level_count; }
+    };
+    /// @brief True if image uses any transparency
+    Property<bool> has_transparency {
+        GET { return _has_transparency; }
+    };
 
+    /**
+     * @brief Construct a new Image object
+     *
+     * @param name Image name
+     * @param width Image width in pixels
+     * @param height Image height in pixels
+     * @param channel_count Channel count
+     * @param has_transparency True if any pixel isn't fully opaque
+     * @param pixels Pixel data. Image takes ownership.
+     * @param format Pixel data format
+     * @param mip_level_count Number of mip levels in pixel data
+     * @param file_mapping File mapping pixels point into (see
+     * Platform::Memory::map_file), released instead of pixels. Nullptr if
+     * pixels were allocated with new[].
+     * @param file_mapping_size Size of the file mapping in bytes
+     */
     Image(
         const String      name,
         const uint32      width,
         const uint32      height,
         const uint8       channel_count,
-        const byte* const pixels
+        const bool        has_transparency,
+        const byte* const pixels,
+        const ImageFormat format            = ImageFormat::RGBA8,
+        const uint32      mip_level_count   = 1,
+        const void* const file_mapping      = nullptr,
+        const uint64      file_mapping_size = 0
     )
         : Resource(name), _width(width), _height(height),
-          _channel_count(channel_count), _pixels(pixels) {}
-    ~Image() { delete _pixels; }
+          _channel_count(channel_count), _has_transparency(has_transparency),
+          _pixels(pixels), _format(format), _mip_level_count(mip_level_count),
+          _file_mapping(file_mapping), _file_mapping_size(file_mapping_size) {}
+    ~Image() { release_pixels(); }
+
+    /// @brief Total pixel data size in bytes (all mip levels)
+    uint64 get_size() const {
+        return get_mip_chain_size(_format, _width, _height, _mip_level_count);
+    }
 
     /**
-     * @brief Check for image transparency
+     * @brief Block compress pixel data (all mip levels)
      *
-     * @return true If image has transparency
-     * @return false Otherwise
+     * @param format Compressed format used
+     * @throws RuntimeError If image isn't RGBA8 or format isn't compressed
      */
-    bool has_transparency() {
-        if (_channel_count < 4) return false;
+    Result<void, RuntimeError> compress(const ImageFormat format);
 
-        uint64 total_size = _width * _height * _channel_count;
-        for (uint64 i = 3; i < total_size; i += _channel_count)
-            if (_pixels[i] < (byte) 255) return true;
+    /**
+     * @brief Create a full mip chain from RGBA8 pixel data. Levels are
+     * downsampled with a box filter, colors are averaged in linear space.
+     *
+     * @param pixels Level 0 pixel data
+     * @param width Level 0 width in pixels
+     * @param height Level 0 height in pixels
+     * @return byte* Pixel data of all levels, allocated with new[]
+     */
+    static byte* create_mip_chain(
+        const byte* const pixels, const uint32 width, const uint32 height
+    );
 
-        return false;
-    }
+    /// @brief Number of levels in a full mip chain
+    static uint32 get_mip_level_count(const uint32 width, const uint32 height);
+    /// @brief Size of a single pixel (or a pixel block) in bytes
+    static uint32 get_block_size(const ImageFormat format);
+    /// @brief Width & height of a pixel block (1 for uncompressed formats)
+    static uint32 get_block_extent(const ImageFormat format);
+    /// @brief Size of a single mip level in bytes
+    static uint64 get_level_size(
+        const ImageFormat format, const uint32 width, const uint32 height
+    );
+    /// @brief Size of the first level_count levels of a mip chain in bytes
+    static uint64 get_mip_chain_size(
+        const ImageFormat format,
+        const uint32      width,
+        const uint32      height,
+        const uint32      level_count
+    );
 
   private:
     uint32      _width;
     uint32      _height;
     uint8       _channel_count;
+    bool        _has_transparency;
     const byte* _pixels;
-};
\ No newline at end of file
+    ImageFormat _format;
+    uint32      _mip_level_count;
+    const void* _file_mapping;
+    uint64      _file_mapping_size;
+
+    void release_pixels();
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "resource_loader.hpp"
+#include "resources/image.hpp"
 
 /**
  * @brief Resource loader that handles image files.
@@ -15,4 +16,7 @@ class ImageLoader : public ResourceLoader {
     void                            unload(Resource* resource);
 
   private:
+    /// @brief Load a packed .vktex image by mapping the file. Nullptr if the
+    /// file is missing or invalid.
+    Image* load_vktex(const String& name, const String& file_path);
 };
\ No newline at end of file
@@ -94,11 +94,25 @@ class Material {
      */
     void apply_local(const glm::mat4 model);
 
-    const static uint32 max_name_length = 256;
+    constexpr static uint32 max_name_length = 256;
 
   private:
-    String        _name = "";
-    Shader* const _shader;
-    TextureMap    _diffuse_map;
-    glm::vec4     _diffuse_color;
+    // Shader uniform indices, resolved once on construction
+    struct UniformIndices {
+        uint16 projection;
+        uint16 view;
+        uint16 model;
+        uint16 diffuse_color;
+        uint16 diffuse_texture;
+    };
+
+    const static uint16 invalid_uniform_index = 0xFFFF;
+
+    String         _name = "";
+    Shader* const  _shader;
+    TextureMap     _diffuse_map;
+    glm::vec4      _diffuse_color;
+    UniformIndices _uniform_index;
+
+    uint16 find_uniform_index(const StringId id) const;
 };
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "texture.hpp"
+#include "flat_hash_map.hpp"
+#include "string_id.hpp"
 #include "unordered_map.hpp"
 
 class ResourceSystem;
@@ -163,7 +165,7 @@ class Shader {
      * @returns Uniform index if found
      * @throws InvalidArgument exception if no uniform is found
      */
-    Result<uint16, InvalidArgument> get_uniform_index(const String name);
+    Result<uint16, InvalidArgument> get_uniform_index(const StringId name);
 
     /**
      * @brief Set the uniform value by uniform name
@@ -175,7 +177,7 @@ class Shader {
      */
     template<typename T>
     Result<void, InvalidArgument> set_uniform(
-        const String name, const T* value
+        const StringId name, const T* value
     ) {
         // Get id
         auto id = get_uniform_index(name);
@@ -216,7 +218,7 @@ class Shader {
      * @throws InvalidArgument exception if no sampler is found
      */
     Result<void, InvalidArgument> set_sampler(
-        const String name, const Texture* const texture
+        const StringId name, const Texture* const texture
     );
     /**
      * @brief Set the sampler texture by sampler id
@@ -229,8 +231,8 @@ class Shader {
         const uint16 id, const Texture* const texture
     );
 
-    const static uint32 max_name_length    = 256;
-    const static uint32 max_instance_count = 1024;
+    constexpr static uint32 max_name_length    = 256;
+    constexpr static uint32 max_instance_count = 1024;
 
   protected:
     TextureSystem*  _texture_system;
@@ -251,8 +253,8 @@ class Shader {
     uint16                  _attribute_stride = 0;
 
     // Uniforms
-    UnorderedMap<String, uint32> _uniforms_hash {};
-    Vector<ShaderUniform>        _uniforms {};
+    FlatHashMap<StringId, uint32> _uniforms_hash {};
+    Vector<ShaderUniform>         _uniforms {};
 
     // Global uniforms
     uint64 _global_ubo_size   = 0;
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "resource.hpp"
+#include "image.hpp"
 
 struct InternalTextureData {};
 
@@ -30,7 +30,15 @@ class Texture {
     Property<int32> channel_count {
         GET { return _channel_count; }
     };
-    /// @brief Total texture data size in bytes
+    /// @brief Pixel data format
+    Property<ImageFormat> format {
+        GET { return _format; }
+    };
+    /// @brief Number of mip levels
+    Property<uint32> mip_level_count {
+        GET { return _mip_level_count; }
+    };
+    /// @brief Total texture data size in bytes (all mip levels)
     Property<uint64> total_size {
         GET { return _total_size; }
     };
@@ -54,17 +62,41 @@ class Texture {
      * transparency channel is counted.
      * @param has_transparency True if texture uses transparency (Has alpha
      * chanel)
+     * @param format Pixel data format
+     * @param mip_level_count Number of mip levels in pixel data
      */
     Texture(
-        const String name,
-        const int32  width,
-        const int32  height,
-        const int32  channel_count,
-        const bool   has_transparency
+        const String      name,
+        const int32       width,
+        const int32       height,
+        const int32       channel_count,
+        const bool        has_transparency,
+        const ImageFormat format          = ImageFormat::RGBA8,
+        const uint32      mip_level_count = 1
     );
     ~Texture() {}
 
-    const static uint32 max_name_length = 256;
+    /**
+     * @brief Replace texture description, once a placeholder texture gets its
+     * pixel data. Internal data has to be recreated afterwards.
+     *
+     * @param width Texture width in pixels
+     * @param height Texture height in pixels
+     * @param channel_count Channel count
+     * @param has_transparency True if texture uses transparency
+     * @param format Pixel data format
+     * @param mip_level_count Number of mip levels in pixel data
+     */
+    void set_description(
+        const int32       width,
+        const int32       height,
+        const int32       channel_count,
+        const bool        has_transparency,
+        const ImageFormat format,
+        const uint32      mip_level_count
+    );
+
+    constexpr static uint32 max_name_length = 256;
 
   private:
     String               _name = "";
@@ -72,6 +104,8 @@ class Texture {
     int32                _height;
     int32                _channel_count;
     bool                 _has_transparency;
+    ImageFormat          _format;
+    uint32               _mip_level_count;
     uint64               _total_size;
-    InternalTextureData* _internal_data;
+    InternalTextureData* _internal_data = nullptr;
 };
\ No newline at end of file
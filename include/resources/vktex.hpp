@@ -0,0 +1,62 @@
+#pragma once
+
+#include "image.hpp"
+
+/**
+ * @brief Engine-native texture container (.vktex). A fixed size header is
+ * followed by the full mip chain in its final GPU format, so loading it is a
+ * file mapping and a copy, with no decoding.
+ */
+class VktexFile {
+  public:
+    /// @brief File identifier, "VKTX" in little endian
+    static constexpr uint32 magic       = 0x58544B56;
+    /// @brief Current container version
+    static constexpr uint32 version     = 1;
+    /// @brief Offset of pixel data from the start of the file
+    static constexpr uint64 data_offset = 64;
+
+    /// @brief Container header, stored at the start of the file
+    struct Header {
+        uint32 magic;
+        uint32 version;
+        uint32 width;
+        uint32 height;
+        uint32 mip_level_count;
+        uint8  format;
+        uint8  channel_count;
+        uint8  has_transparency;
+        uint8  reserved;
+        /// @brief Pixel data size in bytes (all mip levels)
+        uint64 data_size;
+        /// @brief FNV-1a hash of pixel data
+        uint64 content_hash;
+    };
+    static_assert(sizeof(Header) <= data_offset);
+
+    /**
+     * @brief Write image to a .vktex file
+     *
+     * @param file_path Path of the written file
+     * @param image Image written, in its current format
+     * @throws RuntimeError If the file couldn't be written
+     */
+    static Result<void, RuntimeError> write(
+        const String& file_path, Image* const image
+    );
+
+    /**
+     * @brief Validate .vktex file contents
+     *
+     * @param data Start of the file
+     * @param size File size in bytes
+     * @return const Header* File header
+     * @throws RuntimeError If the file is malformed or of different version
+     */
+    static Result<const Header*, RuntimeError> validate(
+        const void* const data, const uint64 size
+    );
+
+    /// @brief 64-bit FNV-1a hash of given data
+    static uint64 hash(const void* const data, const uint64 size);
+};
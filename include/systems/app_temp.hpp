@@ -71,6 +71,9 @@ inline void TestApplication::run() {
 
         auto delta_time = calculate_delta_time();
 
+        // Swap in textures which finished loading
+        _texture_system.update();
+
         auto result = _app_renderer.draw_frame(delta_time);
         if (result.has_error()) {
             // TODO: PROCESS ERROR
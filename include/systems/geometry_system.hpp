@@ -87,7 +87,7 @@ class GeometrySystem {
     Geometry* _default_geometry    = nullptr;
     Geometry* _default_2d_geometry = nullptr;
 
-    UnorderedMap<uint32, GeometryRef> _registered_geometries = {};
+    FlatHashMap<uint32, GeometryRef> _registered_geometries = {};
 
     void create_default_geometries();
 };
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "shader_system.hpp"
+#include "object_pool.hpp"
+#include "string_id.hpp"
 
 /**
  * @brief Material system is responsible for management of materials in the
@@ -41,7 +43,7 @@ class MaterialSystem {
     /// the material resource from memory if no references to it are detected.
     /// Can only be set if the material resource isn't loaded yet.
     /// @returns Requested material resource
-    Material* acquire(const String name);
+    Material* acquire(const StringView name);
     /// @brief Acquire material resource from the material system. Materia
     /// system will create requested material with the given settings if
     /// material with config.name isn't already loaded.
@@ -51,14 +53,14 @@ class MaterialSystem {
     /// @brief Releases material resource. Material system will automatically
     /// release this material from memory if no other references to it are
     /// detected and auto release flag is set to true.
-    /// @param name Name of the released material
-    void      release(const String name);
+    /// @param id Name id of the released material
+    void      release(const StringId id);
 
   private:
     struct MaterialRef {
-        Material* handle;
-        uint64    reference_count;
-        bool      auto_release;
+        ObjectHandle handle;
+        uint64       reference_count;
+        bool         auto_release;
     };
 
     Renderer*       _renderer;
@@ -66,14 +68,16 @@ class MaterialSystem {
     TextureSystem*  _texture_system;
     ShaderSystem*   _shader_system;
 
-    const uint64 _max_material_count    = 1024;
-    const String _default_material_name = "default";
+    const uint32   _max_material_count    = 1024;
+    const String   _default_material_name = "default";
+    const StringId _default_material_id   = "default";
 
-    Material*                         _default_material     = nullptr;
-    UnorderedMap<String, MaterialRef> _registered_materials = {};
+    Material*                          _default_material     = nullptr;
+    ObjectPool<Material>               _materials;
+    FlatHashMap<StringId, MaterialRef> _registered_materials = {};
 
     void create_default_material();
 
     Result<MaterialRef, bool> create_material(const MaterialConfig config);
-    void                      destroy_material(Material* material);
+    void                      destroy_material(const ObjectHandle handle);
 };
@@ -2,6 +2,13 @@
 
 #include "renderer/renderer.hpp"
 #include "resource_system.hpp"
+#include "object_pool.hpp"
+#include "flat_hash_map.hpp"
+#include "string_id.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 /**
  * @brief Texture system is responsible for management of textures in the
@@ -36,28 +43,82 @@ class TextureSystem {
     /// the texture resource from memory if no references to the texture are
     /// detected. Can only be set if the texture resource isn't loaded yet.
     /// @returns Requested texture resource
-    Texture* acquire(const String name, const bool auto_release);
+    Texture* acquire(const StringView name, const bool auto_release);
+    /// @brief Acquire texture resource from texture system without waiting
+    /// for it to load. Texture is decoded on a worker thread and uses the
+    /// default texture data until then. Decoded data is uploaded and swapped
+    /// in by update.
+    /// @param name Name of the requested texture
+    /// @param auto_release If enabled texture system will automaticaly release
+    /// the texture resource from memory if no references to the texture are
+    /// detected. Can only be set if the texture resource isn't loaded yet.
+    /// @returns Requested texture resource, possibly still a placeholder
+    Texture* acquire_async(const StringView name, const bool auto_release);
     /// @brief Releases texture resource. Texture system will automatically
     /// release this texture from memory if no other references to it are
     /// detected and auto release flag is set to true.
-    /// @param name Name of the released texture
-    void     release(const String name);
+    /// @param id Name id of the released texture
+    void     release(const StringId id);
+
+    /// @brief Upload textures decoded since the last call, replacing their
+    /// placeholder data. Should be called once per frame, from the thread
+    /// using the renderer.
+    void update();
 
   private:
     struct TextureRef {
-        Texture* handle;
-        uint64   reference_count;
-        bool     auto_release;
+        ObjectHandle handle;
+        uint64       reference_count;
+        bool         auto_release;
+    };
+    struct LoadJob {
+        String       name;
+        ObjectHandle handle;
+        // Decoded image, nullptr if loading failed
+        Image*       image;
     };
 
     Renderer*       _renderer;
     ResourceSystem* _resource_system;
 
-    const uint64 _max_texture_count    = 1024;
-    const String _default_texture_name = "default";
+    const uint32   _max_texture_count    = 1024;
+    const String   _default_texture_name = "default";
+    const StringId _default_texture_id   = "default";
+    // Block compress textures on load, if the renderer supports it
+    const bool     _compress_textures    = true;
+    // Upper limit of texture decoding threads
+    const uint32   _max_worker_count     = 4;
+
+    Texture*                          _default_texture     = nullptr;
+    ObjectPool<Texture>               _textures;
+    FlatHashMap<StringId, TextureRef> _registered_textures = {};
+
+    // Asynchronous loading
+    Vector<std::thread>     _workers {};
+    std::mutex              _job_lock {};
+    std::condition_variable _job_signal {};
+    bool                    _stopping = false;
+    // Queued jobs, taken from _next_pending_job on. Storage is reused once
+    // the queue drains.
+    Vector<LoadJob>         _pending_jobs {};
+    uint64                  _next_pending_job = 0;
+    Vector<LoadJob>         _completed_jobs {};
+    // Jobs being uploaded, kept to reuse their storage
+    Vector<LoadJob>         _uploaded_jobs {};
 
-    Texture*                         _default_texture     = nullptr;
-    UnorderedMap<String, TextureRef> _registered_textures = {};
+    Result<Texture*, bool> acquire_registered(
+        const StringView name, const StringId id
+    );
+
+    Image*   load_image(const String& name);
+    Texture* create_texture(
+        const StringView name,
+        const StringId   id,
+        const bool       auto_release,
+        Image* const     image
+    );
+    bool     is_placeholder(const Texture* const texture) const;
+    void     worker_loop();
 
     void create_default_textures();
     void destroy_default_textures();
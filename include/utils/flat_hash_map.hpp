@@ -0,0 +1,471 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#    include <emmintrin.h>
+#    define FLAT_HASH_MAP_SSE2
+#endif
+
+#include "memory_system.hpp"
+
+/**
+ * @brief Open addressing hash map. Entries are stored inline in a single
+ * allocation, next to an array of control bytes (one per slot) holding 7 bits
+ * of the key hash, or an empty marker. Lookups compare a group of 16 control
+ * bytes at once (SSE2 where available) and only touch entries whose control
+ * byte matches.
+ *
+ * Slots are probed linearly and erased entries are backward shifted into the
+ * freed slot, so no tombstones are ever left behind and lookup cost doesn't
+ * degrade with churn.
+ *
+ * Unlike %UnorderedMap, inserting or erasing invalidates all iterators,
+ * pointers & references to entries.
+ *
+ * @tparam Key Type of key objects
+ * @tparam Tp Type of mapped objects
+ * @tparam Hash Hashing function object type
+ * @tparam Pred Key equality function object type
+ */
+template<
+    typename Key,
+    typename Tp,
+    typename Hash = std::hash<Key>,
+    typename Pred = std::equal_to<Key>>
+class FlatHashMap {
+  public:
+    typedef Key                key_type;
+    typedef Tp                 mapped_type;
+    typedef std::pair<Key, Tp> value_type;
+    typedef uint64             size_type;
+    typedef Hash               hasher;
+    typedef Pred               key_equal;
+
+  private:
+    typedef int8 ctrl_t;
+
+    static constexpr ctrl_t empty_ctrl     = (ctrl_t) 0x80;
+    static constexpr uint32 group_width    = 16;
+    static constexpr uint64 min_capacity   = group_width;
+    // Max load factor of 7 / 8
+    static constexpr uint64 max_load_numer = 7;
+    static constexpr uint64 max_load_denom = 8;
+    static constexpr uint64 npos           = (uint64) -1;
+
+    /// @brief Control bytes of group_width consecutive slots
+    struct Group {
+#ifdef FLAT_HASH_MAP_SSE2
+        __m128i ctrl;
+
+        explicit Group(const ctrl_t* const pos)
+            : ctrl(_mm_loadu_si128((const __m128i*) pos)) {}
+
+        /// @brief Bit mask of slots whose control byte equals h2
+        uint32 match(const ctrl_t h2) const {
+            return (uint32) _mm_movemask_epi8(
+                _mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)
+            );
+        }
+        /// @brief Bit mask of empty slots (only they have the top bit set)
+        uint32 match_empty() const {
+            return (uint32) _mm_movemask_epi8(ctrl);
+        }
+#else
+        ctrl_t ctrl[group_width];
+
+        explicit Group(const ctrl_t* const pos) {
+            memcpy(ctrl, pos, group_width);
+        }
+
+        uint32 match(const ctrl_t h2) const {
+            uint32 mask = 0;
+            for (uint32 i = 0; i < group_width; i++)
+                mask |= (uint32) (ctrl[i] == h2) << i;
+            return mask;
+        }
+        uint32 match_empty() const { return match(empty_ctrl); }
+#endif
+    };
+
+  public:
+    template<bool Const>
+    class Iterator {
+      public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef FlatHashMap::value_type   value_type;
+        typedef std::ptrdiff_t            difference_type;
+        typedef typename std::
+            conditional<Const, const value_type*, value_type*>::type pointer;
+        typedef typename std::
+            conditional<Const, const value_type&, value_type&>::type reference;
+
+        Iterator() {}
+        // Allow iterator -> const_iterator conversion
+        template<bool C = Const, typename = std::enable_if_t<C>>
+        Iterator(const Iterator<false>& other)
+            : _ctrl(other._ctrl), _slot(other._slot), _end(other._end) {}
+
+        reference operator*() const { return *_slot; }
+        pointer   operator->() const { return _slot; }
+
+        Iterator& operator++() {
+            _ctrl++;
+            _slot++;
+            skip_empty();
+            return *this;
+        }
+        Iterator operator++(int) {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return _ctrl == other._ctrl;
+        }
+        bool operator!=(const Iterator& other) const {
+            return _ctrl != other._ctrl;
+        }
+
+      private:
+        friend class FlatHashMap;
+        friend class Iterator<!Const>;
+
+        const ctrl_t* _ctrl = nullptr;
+        pointer       _slot = nullptr;
+        const ctrl_t* _end  = nullptr;
+
+        Iterator(const ctrl_t* const ctrl, pointer slot, const ctrl_t* end)
+            : _ctrl(ctrl), _slot(slot), _end(end) {}
+
+        void skip_empty() {
+            while (_ctrl != _end && *_ctrl == empty_ctrl) {
+                _ctrl++;
+                _slot++;
+            }
+        }
+    };
+    typedef Iterator<false> iterator;
+    typedef Iterator<true>  const_iterator;
+
+    /// @brief Construct a new Flat Hash Map object. No memory is allocated
+    /// until the first insertion.
+    FlatHashMap() : _tag(MemoryTag::Map) {}
+    /**
+     * @brief Construct a new Flat Hash Map object. No memory is allocated
+     * until the first insertion.
+     *
+     * @param tag Memory tag of the entry storage
+     */
+    explicit FlatHashMap(const MemoryTag tag) : _tag(tag) {}
+    /**
+     * @brief Construct a new Flat Hash Map object, with room for at least
+     * given number of entries
+     *
+     * @param count Number of entries reserved
+     * @param tag Memory tag of the entry storage
+     */
+    explicit FlatHashMap(
+        const uint64 count, const MemoryTag tag = MemoryTag::Map
+    )
+        : _tag(tag) {
+        reserve(count);
+    }
+    FlatHashMap(std::initializer_list<value_type> list) : FlatHashMap() {
+        reserve(list.size());
+        for (const auto& value : list)
+            insert(value);
+    }
+    ~FlatHashMap() { destroy(); }
+
+    FlatHashMap(const FlatHashMap& other) : _tag(other._tag) {
+        reserve(other._size);
+        for (const auto& value : other)
+            insert_unique(hash_of(value.first), value);
+    }
+    FlatHashMap(FlatHashMap&& other) noexcept
+        : _slots(other._slots), _ctrl(other._ctrl),
+          _capacity(other._capacity), _size(other._size), _tag(other._tag) {
+        other.reset_storage();
+    }
+    FlatHashMap& operator=(const FlatHashMap& other) {
+        if (this == &other) return *this;
+        clear();
+        reserve(other._size);
+        for (const auto& value : other)
+            insert_unique(hash_of(value.first), value);
+        return *this;
+    }
+    FlatHashMap& operator=(FlatHashMap&& other) noexcept {
+        if (this == &other) return *this;
+        destroy();
+        _slots    = other._slots;
+        _ctrl     = other._ctrl;
+        _capacity = other._capacity;
+        _size     = other._size;
+        _tag      = other._tag;
+        other.reset_storage();
+        return *this;
+    }
+
+    // Iterators
+    iterator begin() {
+        iterator it { _ctrl, _slots, _ctrl + _capacity };
+        it.skip_empty();
+        return it;
+    }
+    const_iterator begin() const {
+        const_iterator it { _ctrl, _slots, _ctrl + _capacity };
+        it.skip_empty();
+        return it;
+    }
+    iterator end() {
+        return { _ctrl + _capacity, _slots + _capacity, _ctrl + _capacity };
+    }
+    const_iterator end() const {
+        return { _ctrl + _capacity, _slots + _capacity, _ctrl + _capacity };
+    }
+
+    // Capacity
+    bool      empty() const { return _size == 0; }
+    size_type size() const { return _size; }
+    /// @brief Number of slots, entries will fit up to 7 / 8 of it
+    size_type capacity() const { return _capacity; }
+
+    // Lookup
+    iterator find(const Key& key) {
+        const auto index = find_index(key, hash_of(key));
+        return index == npos ? end() : iterator_at(index);
+    }
+    const_iterator find(const Key& key) const {
+        const auto index = find_index(key, hash_of(key));
+        return index == npos ? end() : const_iterator_at(index);
+    }
+    bool contains(const Key& key) const {
+        return find_index(key, hash_of(key)) != npos;
+    }
+    size_type count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+    /// @brief Access mapped value, default constructing it if missing
+    Tp& operator[](const Key& key) {
+        return try_emplace(key).first->second;
+    }
+    Tp& operator[](Key&& key) {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    // Modifiers
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return try_emplace(value.first, value.second);
+    }
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return try_emplace(std::move(value.first), std::move(value.second));
+    }
+    /// @brief Insert value constructed from args if key is missing, otherwise
+    /// leave args untouched
+    template<typename K, typename... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+        const auto hash  = hash_of(key);
+        auto       index = find_index(key, hash);
+        if (index != npos) return { iterator_at(index), false };
+
+        if (_size + 1 > max_load(_capacity)) grow(_size + 1);
+        index = insert_unique(
+            hash,
+            std::piecewise_construct,
+            std::forward_as_tuple(std::forward<K>(key)),
+            std::forward_as_tuple(std::forward<Args>(args)...)
+        );
+        return { iterator_at(index), true };
+    }
+    template<typename K, typename... Args>
+    std::pair<iterator, bool> emplace(K&& key, Args&&... args) {
+        return try_emplace(std::forward<K>(key), std::forward<Args>(args)...);
+    }
+
+    /// @brief Erase entry with the given key, if present
+    /// @returns Number of erased entries
+    size_type erase(const Key& key) {
+        const auto index = find_index(key, hash_of(key));
+        if (index == npos) return 0;
+        erase_index(index);
+        return 1;
+    }
+    void erase(const const_iterator position) {
+        erase_index(position._ctrl - _ctrl);
+    }
+
+    /// @brief Destroy all entries, keeping the allocated storage
+    void clear() {
+        if (_size == 0) return;
+        for (uint64 i = 0; i < _capacity; i++)
+            if (_ctrl[i] != empty_ctrl) _slots[i].~value_type();
+        memset(_ctrl, empty_ctrl, _capacity + group_width - 1);
+        _size = 0;
+    }
+    /// @brief Make room for at least count entries without rehashing
+    void reserve(const size_type count) {
+        if (count > max_load(_capacity)) grow(count);
+    }
+
+  private:
+    value_type* _slots    = nullptr;
+    // Capacity + group_width - 1 bytes. Trailing bytes mirror the first ones,
+    // so groups starting near the end wrap around without a branch.
+    ctrl_t*     _ctrl     = nullptr;
+    // Power of 2, at least min_capacity (or 0)
+    uint64      _capacity = 0;
+    uint64      _size     = 0;
+    MemoryTag   _tag;
+
+    static uint64 max_load(const uint64 capacity) {
+        return capacity * max_load_numer / max_load_denom;
+    }
+
+    // Mix the hash, std::hash of integers is the identity. Top bits of the
+    // product are best distributed, they are folded into the low ones.
+    static uint64 mix(uint64 hash) {
+        hash *= 0x9E3779B97F4A7C15;
+        return hash ^ (hash >> 32);
+    }
+    template<typename K>
+    static uint64 hash_of(const K& key) {
+        return mix(Hash {}(key));
+    }
+    static ctrl_t h2(const uint64 hash) { return (ctrl_t) (hash & 0x7F); }
+    uint64        h1(const uint64 hash) const {
+        return (hash >> 7) & (_capacity - 1);
+    }
+
+    iterator iterator_at(const uint64 index) {
+        return { _ctrl + index, _slots + index, _ctrl + _capacity };
+    }
+    const_iterator const_iterator_at(const uint64 index) const {
+        return { _ctrl + index, _slots + index, _ctrl + _capacity };
+    }
+
+    void set_ctrl(const uint64 index, const ctrl_t value) {
+        _ctrl[index] = value;
+        // Mirrored tail
+        if (index < group_width - 1) _ctrl[_capacity + index] = value;
+    }
+
+    template<typename K>
+    uint64 find_index(const K& key, const uint64 hash) const {
+        if (_capacity == 0) return npos;
+
+        const auto mask  = _capacity - 1;
+        const auto tag   = h2(hash);
+        uint64     probe = h1(hash);
+        while (true) {
+            const Group group { _ctrl + probe };
+            for (uint32 m = group.match(tag); m != 0; m &= m - 1) {
+                const uint64 index = (probe + count_trailing_zeros(m)) & mask;
+                if (Pred {}(_slots[index].first, key)) return index;
+            }
+            // Entries are never placed past the first empty slot after their
+            // home slot
+            if (group.match_empty() != 0) return npos;
+            probe = (probe + group_width) & mask;
+        }
+    }
+
+    /// @brief Construct an entry known not to be present. Storage has to be
+    /// large enough.
+    template<typename... Args>
+    uint64 insert_unique(const uint64 hash, Args&&... args) {
+        const auto mask  = _capacity - 1;
+        uint64     probe = h1(hash);
+        while (true) {
+            const auto empty = Group { _ctrl + probe }.match_empty();
+            if (empty != 0) {
+                const uint64 index =
+                    (probe + count_trailing_zeros(empty)) & mask;
+                new (_slots + index) value_type(std::forward<Args>(args)...);
+                set_ctrl(index, h2(hash));
+                _size++;
+                return index;
+            }
+            probe = (probe + group_width) & mask;
+        }
+    }
+
+    void erase_index(uint64 hole) {
+        const auto mask = _capacity - 1;
+        _slots[hole].~value_type();
+        set_ctrl(hole, empty_ctrl);
+        _size--;
+
+        // Shift following entries of the cluster back, if the hole lies
+        // between their home slot & their current slot
+        for (uint64 index = (hole + 1) & mask; _ctrl[index] != empty_ctrl;
+             index        = (index + 1) & mask) {
+            const auto home = h1(hash_of(_slots[index].first));
+            if (((index - home) & mask) < ((index - hole) & mask)) continue;
+
+            new (_slots + hole) value_type(std::move(_slots[index]));
+            _slots[index].~value_type();
+            set_ctrl(hole, _ctrl[index]);
+            set_ctrl(index, empty_ctrl);
+            hole = index;
+        }
+    }
+
+    void grow(const uint64 count) {
+        uint64 new_capacity = std::max(_capacity, min_capacity);
+        while (max_load(new_capacity) < count)
+            new_capacity *= 2;
+
+        auto old_slots    = _slots;
+        auto old_ctrl     = _ctrl;
+        auto old_capacity = _capacity;
+
+        // Slots & control bytes share one allocation
+        const uint64 slots_size = new_capacity * sizeof(value_type);
+        auto         memory     = (byte*) operator new(
+            slots_size + new_capacity + group_width - 1, _tag
+        );
+        _slots    = (value_type*) memory;
+        _ctrl     = (ctrl_t*) (memory + slots_size);
+        _capacity = new_capacity;
+        _size     = 0;
+        memset(_ctrl, empty_ctrl, new_capacity + group_width - 1);
+
+        for (uint64 i = 0; i < old_capacity; i++) {
+            if (old_ctrl[i] == empty_ctrl) continue;
+            insert_unique(
+                hash_of(old_slots[i].first), std::move(old_slots[i])
+            );
+            old_slots[i].~value_type();
+        }
+        if (old_slots) operator delete(old_slots);
+    }
+
+    void destroy() {
+        clear();
+        if (_slots) operator delete(_slots);
+        reset_storage();
+    }
+    void reset_storage() {
+        _slots    = nullptr;
+        _ctrl     = nullptr;
+        _capacity = 0;
+        _size     = 0;
+    }
+
+    static uint32 count_trailing_zeros(const uint32 mask) {
+#if defined(__GNUC__) || defined(__clang__)
+        return (uint32) __builtin_ctz(mask);
+#else
+        uint32 count = 0;
+        while ((mask & (1u << count)) == 0)
+            count++;
+        return count;
+#endif
+    }
+};
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "vector.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+
+/**
+ * @brief Ordered map stored as a single sorted array of (key, value) pairs.
+ * Lookups are binary searches over contiguous memory and iteration is a linear
+ * walk, so both stay in cache far better than with the node based %Map. There
+ * is no allocation per entry, only the array itself grows.
+ *
+ * Insertion & erasure shift the entries after the affected position, which
+ * makes them O(n). Meant for maps which are read much more often than they
+ * change, or which stay small. Inserting or erasing invalidates all iterators,
+ * pointers & references to entries. Keys must not be modified through
+ * iterators.
+ *
+ * @tparam Key Type of key objects
+ * @tparam Tp Type of mapped objects
+ * @tparam Compare Key ordering function object type
+ */
+template<typename Key, typename Tp, typename Compare = std::less<Key>>
+class FlatMap {
+  public:
+    typedef Key                key_type;
+    typedef Tp                 mapped_type;
+    typedef std::pair<Key, Tp> value_type;
+    typedef uint64             size_type;
+    typedef Compare            key_compare;
+    typedef value_type*        iterator;
+    typedef const value_type*  const_iterator;
+
+    /// @brief Construct a new Flat Map object. No memory is allocated until
+    /// the first insertion.
+    FlatMap() : FlatMap(MemoryTag::Map) {}
+    /**
+     * @brief Construct a new Flat Map object. No memory is allocated until
+     * the first insertion.
+     *
+     * @param tag Memory tag of the entry storage
+     */
+    explicit FlatMap(const MemoryTag tag)
+        : _entries(TAllocator<value_type>(tag)) {}
+    FlatMap(std::initializer_list<value_type> list) : FlatMap() {
+        _entries.reserve(list.size());
+        for (const auto& value : list)
+            insert(value);
+    }
+
+    // Iterators
+    iterator       begin() { return _entries.data(); }
+    iterator       end() { return _entries.data() + _entries.size(); }
+    const_iterator begin() const { return _entries.data(); }
+    const_iterator end() const { return _entries.data() + _entries.size(); }
+
+    // Capacity
+    bool      empty() const { return _entries.empty(); }
+    size_type size() const { return _entries.size(); }
+    size_type capacity() const { return _entries.capacity(); }
+
+    // Lookup
+    /// @brief First entry whose key isn't ordered before key
+    iterator lower_bound(const Key& key) {
+        return std::lower_bound(begin(), end(), key, KeyCompare {});
+    }
+    const_iterator lower_bound(const Key& key) const {
+        return std::lower_bound(begin(), end(), key, KeyCompare {});
+    }
+    /// @brief First entry whose key is ordered after key
+    iterator upper_bound(const Key& key) {
+        return std::upper_bound(begin(), end(), key, KeyCompare {});
+    }
+    const_iterator upper_bound(const Key& key) const {
+        return std::upper_bound(begin(), end(), key, KeyCompare {});
+    }
+    iterator find(const Key& key) {
+        const auto it = lower_bound(key);
+        return is_match(it, key) ? it : end();
+    }
+    const_iterator find(const Key& key) const {
+        const auto it = lower_bound(key);
+        return is_match(it, key) ? it : end();
+    }
+    bool      contains(const Key& key) const { return find(key) != end(); }
+    size_type count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+    /// @brief Access mapped value, default constructing it if missing
+    Tp& operator[](const Key& key) { return try_emplace(key).first->second; }
+
+    // Modifiers
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return try_emplace(value.first, value.second);
+    }
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return try_emplace(std::move(value.first), std::move(value.second));
+    }
+    /// @brief Insert value constructed from args if key is missing, otherwise
+    /// leave args untouched
+    template<typename K, typename... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+        const auto it = lower_bound(key);
+        if (is_match(it, key)) return { it, false };
+
+        const auto index = it - begin();
+        _entries.emplace(
+            _entries.begin() + index,
+            std::piecewise_construct,
+            std::forward_as_tuple(std::forward<K>(key)),
+            std::forward_as_tuple(std::forward<Args>(args)...)
+        );
+        return { begin() + index, true };
+    }
+    template<typename K, typename... Args>
+    std::pair<iterator, bool> emplace(K&& key, Args&&... args) {
+        return try_emplace(std::forward<K>(key), std::forward<Args>(args)...);
+    }
+
+    /// @brief Erase entry with the given key, if present
+    /// @returns Number of erased entries
+    size_type erase(const Key& key) {
+        const auto it = find(key);
+        if (it == end()) return 0;
+        erase(it);
+        return 1;
+    }
+    /// @brief Erase entry at position
+    /// @returns Iterator to the entry following the erased one
+    iterator erase(const const_iterator position) {
+        const auto index = position - begin();
+        _entries.erase(_entries.begin() + index);
+        return begin() + index;
+    }
+
+    /// @brief Destroy all entries, keeping the allocated storage
+    void clear() { _entries.clear(); }
+    /// @brief Make room for at least count entries
+    void reserve(const size_type count) { _entries.reserve(count); }
+
+  private:
+    // Compares entries with keys, for binary search
+    struct KeyCompare {
+        bool operator()(const value_type& entry, const Key& key) const {
+            return Compare {}(entry.first, key);
+        }
+        bool operator()(const Key& key, const value_type& entry) const {
+            return Compare {}(key, entry.first);
+        }
+    };
+
+    Vector<value_type> _entries;
+
+    bool is_match(const const_iterator it, const Key& key) const {
+        return it != end() && !Compare {}(key, it->first);
+    }
+};
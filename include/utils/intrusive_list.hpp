@@ -0,0 +1,168 @@
+#pragma once
+
+#include "defines.hpp"
+
+#include <iterator>
+#include <type_traits>
+
+/**
+ * @brief Links embedded into objects kept in an IntrusiveList. Copies of a
+ * node are never linked, so objects can be copied freely.
+ */
+struct IntrusiveListNode {
+    IntrusiveListNode() {}
+    IntrusiveListNode(const IntrusiveListNode&) {}
+    IntrusiveListNode& operator=(const IntrusiveListNode&) { return *this; }
+
+    /// @brief True if the object is in a list
+    bool is_linked() const { return _next != nullptr; }
+
+  private:
+    template<typename T>
+    friend class IntrusiveList;
+
+    IntrusiveListNode* _previous = nullptr;
+    IntrusiveListNode* _next     = nullptr;
+};
+
+/**
+ * @brief Doubly linked list of objects which carry their own links (by
+ * inheriting IntrusiveListNode). The list never allocates or copies, it only
+ * relinks objects owned elsewhere, so insertion & removal at any point are
+ * O(1) and can't fail. An object can be in one list at a time and must be
+ * removed before it's destroyed.
+ *
+ * @tparam T Type of element, derived from IntrusiveListNode
+ */
+template<typename T>
+class IntrusiveList {
+  public:
+    template<bool Const>
+    class Iterator {
+      public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef T                               value_type;
+        typedef std::ptrdiff_t                  difference_type;
+        typedef typename std::conditional<Const, const T*, T*>::type pointer;
+        typedef typename std::conditional<Const, const T&, T&>::type reference;
+
+        Iterator() {}
+        // Allow iterator -> const_iterator conversion
+        template<bool C = Const, typename = std::enable_if_t<C>>
+        Iterator(const Iterator<false>& other) : _node(other._node) {}
+
+        reference operator*() const { return *static_cast<pointer>(_node); }
+        pointer   operator->() const { return static_cast<pointer>(_node); }
+
+        Iterator& operator++() {
+            _node = _node->_next;
+            return *this;
+        }
+        Iterator operator++(int) {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+        Iterator& operator--() {
+            _node = _node->_previous;
+            return *this;
+        }
+        Iterator operator--(int) {
+            auto copy = *this;
+            --*this;
+            return copy;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return _node == other._node;
+        }
+        bool operator!=(const Iterator& other) const {
+            return _node != other._node;
+        }
+
+      private:
+        friend class IntrusiveList;
+        friend class Iterator<!Const>;
+
+        IntrusiveListNode* _node = nullptr;
+
+        explicit Iterator(IntrusiveListNode* const node) : _node(node) {}
+    };
+    typedef Iterator<false> iterator;
+    typedef Iterator<true>  const_iterator;
+
+    IntrusiveList() {
+        _head._previous = &_head;
+        _head._next     = &_head;
+    }
+    /// @brief Unlinks all objects, objects themselves are left untouched
+    ~IntrusiveList() { clear(); }
+
+    // Prevent accidental copying
+    IntrusiveList(IntrusiveList const&)            = delete;
+    IntrusiveList& operator=(IntrusiveList const&) = delete;
+
+    // Iterators
+    iterator       begin() { return iterator(_head._next); }
+    iterator       end() { return iterator(&_head); }
+    const_iterator begin() const { return const_iterator(_head._next); }
+    const_iterator end() const {
+        return const_iterator(const_cast<IntrusiveListNode*>(&_head));
+    }
+
+    // Capacity
+    bool   empty() const { return _size == 0; }
+    uint64 size() const { return _size; }
+
+    // Access
+    T&       front() { return *static_cast<T*>(_head._next); }
+    const T& front() const { return *static_cast<const T*>(_head._next); }
+    T&       back() { return *static_cast<T*>(_head._previous); }
+    const T& back() const { return *static_cast<const T*>(_head._previous); }
+
+    // Modifiers
+    void push_front(T& object) { link(_head._next, object); }
+    void push_back(T& object) { link(&_head, object); }
+    /// @brief Link object before position
+    /// @returns Iterator to the inserted object
+    iterator insert(const const_iterator position, T& object) {
+        link(position._node, object);
+        return iterator(&object);
+    }
+    void pop_front() { unlink(*_head._next); }
+    void pop_back() { unlink(*_head._previous); }
+    /// @brief Unlink object at position
+    /// @returns Iterator to the object following the removed one
+    iterator erase(const const_iterator position) {
+        const auto next = position._node->_next;
+        unlink(*position._node);
+        return iterator(next);
+    }
+    /// @brief Unlink object, which has to be in this list
+    void remove(T& object) { unlink(object); }
+    /// @brief Unlink all objects
+    void clear() {
+        while (!empty())
+            pop_front();
+    }
+
+  private:
+    // Sentinel, first & last objects link to it
+    IntrusiveListNode _head {};
+    uint64            _size = 0;
+
+    void link(IntrusiveListNode* const next, IntrusiveListNode& node) {
+        node._previous         = next->_previous;
+        node._next             = next;
+        next->_previous->_next = &node;
+        next->_previous        = &node;
+        _size++;
+    }
+    void unlink(IntrusiveListNode& node) {
+        node._previous->_next = node._next;
+        node._next->_previous = node._previous;
+        node._previous        = nullptr;
+        node._next            = nullptr;
+        _size--;
+    }
+};
@@ -3,98 +3,176 @@
 #include "string.hpp"
 #include "platform/platform.hpp"
 
-#define LOG_WARNING_ENABLED 1
-#define LOG_INFO_ENABLED 1
-#define LOG_DEBUG_ENABLED 1
-#define LOG_VERBOSE_ENABLED 0
+#include <algorithm> // min
+#include <cstdlib>   // exit
+#include <cstring>   // memcpy, strlen
+#include <type_traits>
 
+// Compile time level filters, can be overridden from the build. Messages of
+// disabled levels compile to nothing.
+#ifndef LOG_WARNING_ENABLED
+#    define LOG_WARNING_ENABLED 1
+#endif
+#ifndef LOG_INFO_ENABLED
+#    define LOG_INFO_ENABLED 1
+#endif
+#ifndef LOG_DEBUG_ENABLED
+#    define LOG_DEBUG_ENABLED 1
+#endif
+#ifndef LOG_VERBOSE_ENABLED
+#    define LOG_VERBOSE_ENABLED 0
+#endif
+
+/**
+ * @brief Asynchronous logger. Messages are formatted into a preallocated
+ * thread local buffer, without any heap allocation, and queued to a lock-free
+ * ring. A background thread drains the ring and writes messages to the
+ * console in batches, so logging never waits on console output (unless the
+ * ring is full). Fatal errors & errors are flushed before returning.
+ */
 class Logger {
   public:
+    /// @brief Longest message, longer ones are truncated
+    static constexpr uint64 max_message_length = 4096;
 
     Logger() {}
     ~Logger() {}
 
     /**
-     * @brief Logs given fatal error message.
+     * @brief Logs given fatal error message and exits.
      *
-     * Parameter list automaticaly converted to String via std::to_string
-     * if possible, otherwise throws appropriate error. Parameter list is also
-     * automaticaly concatenated, ending with a new line.
+     * Arguments are converted to text (numbers the same way as by
+     * std::to_string) and concatenated, ending with a new line.
      */
     template<typename... Args>
-    static void fatal(Args... message) {
-        auto full_message =
-            String::build(String("FATAL ERROR"), " :: ", message...);
-        Platform::Console::write(full_message, 1, true);
+    static void fatal(const Args&... message) {
+        write(1, "FATAL ERROR :: ", message...);
+        flush();
         exit(EXIT_FAILURE);
     }
     /**
-     * @brief Logs given errors message.
+     * @brief Logs given errors message. Returns once the message is written.
      *
-     * Parameter list automaticaly converted to String via std::to_string
-     * if possible, otherwise throws appropriate error. Argument list is also
-     * automaticaly concatenated, ending with a new line.
+     * Arguments are converted to text (numbers the same way as by
+     * std::to_string) and concatenated, ending with a new line.
      */
     template<typename... Args>
-    static void error(Args... message) {
-        auto full_message = String::build(String("ERR"), " :: ", message...);
-        Platform::Console::write(full_message, 2, true);
+    static void error(const Args&... message) {
+        write(2, "ERR :: ", message...);
+        flush();
     }
     /**
      * @brief Logs given warning message if LOG_WARNING_ENABLED is set to one.
      *
-     * Parameter list automaticaly converted to String via std::to_string
-     * if possible, otherwise throws appropriate error. Argument list is also
-     * automaticaly concatenated, ending with a new line.
+     * Arguments are converted to text (numbers the same way as by
+     * std::to_string) and concatenated, ending with a new line.
      */
     template<typename... Args>
-    static void warning(Args... message) {
+    static void warning(const Args&... message) {
 #if LOG_WARNING_ENABLED
-        auto full_message = String::build(String("WAR"), " :: ", message...);
-        Platform::Console::write(full_message, 3, true);
+        write(3, "WAR :: ", message...);
 #endif
     }
 
     /**
      * @brief Logs given info message if LOG_INFO_ENABLED is set to one.
      *
-     * Parameter list automaticaly converted to String via std::to_string
-     * if possible, otherwise throws appropriate error. Argument list is also
-     * automaticaly concatenated, ending with a new line.
+     * Arguments are converted to text (numbers the same way as by
+     * std::to_string) and concatenated, ending with a new line.
      */
     template<typename... Args>
-    static void log(Args... message) {
+    static void log(const Args&... message) {
 #if LOG_INFO_ENABLED
-        auto full_message = String::build(String("INF"), " :: ", message...);
-        Platform::Console::write(full_message, 4, true);
+        write(4, "INF :: ", message...);
 #endif
     }
     /**
      * @brief Logs given debug message if LOG_DEBUG_ENABLED is set to one.
      *
-     * Parameter list automaticaly converted to String via std::to_string
-     * if possible, otherwise throws appropriate error. Argument list is also
-     * automaticaly concatenated, ending with a new line.
+     * Arguments are converted to text (numbers the same way as by
+     * std::to_string) and concatenated, ending with a new line.
      */
     template<typename... Args>
-    static void debug(Args... message) {
+    static void debug(const Args&... message) {
 #if LOG_DEBUG_ENABLED
-        auto full_message = String::build(String("DEB"), " :: ", message...);
-        Platform::Console::write(full_message, 5, true);
+        write(5, "DEB :: ", message...);
 #endif
     }
     /**
      * @brief Logs given trace message if LOG_VERBOSE_ENABLED is set to one.
      *
-     * Parameter list automaticaly converted to String via std::to_string
-     * if possible, otherwise throws appropriate error. Argument list is also
-     * automaticaly concatenated, ending with a new line.
+     * Arguments are converted to text (numbers the same way as by
+     * std::to_string) and concatenated, ending with a new line.
      */
     template<typename... Args>
-    static void trace(Args... message) {
+    static void trace(const Args&... message) {
 #if LOG_VERBOSE_ENABLED
-        auto full_message = String::build(String("VER"), " :: ", message...);
-        Platform::Console::write(full_message, 0, true);
+        write(0, "VER :: ", message...);
 #endif
     }
-};
\ No newline at end of file
+
+    /**
+     * @brief Block until all messages logged so far are written to the
+     * console
+     */
+    static void flush();
+
+  private:
+    /// @brief Message being formatted, one per thread
+    struct MessageBuffer {
+        char   data[max_message_length];
+        uint64 length = 0;
+
+        void append(const char* const text, const uint64 text_length) {
+            const uint64 count =
+                std::min(text_length, max_message_length - length);
+            memcpy(data + length, text, count);
+            length += count;
+        }
+    };
+
+    static MessageBuffer& message_buffer();
+
+    /// @brief Queue formatted message for writing
+    static void submit(
+        const uint32 kind, const char* const text, const uint64 length
+    );
+
+    template<typename... Args>
+    static void write(const uint32 kind, const Args&... message) {
+        auto& buffer  = message_buffer();
+        buffer.length = 0;
+        (append(buffer, message), ...);
+        submit(kind, buffer.data, buffer.length);
+    }
+
+    // Number formatting, same output as std::to_string
+    static void append_signed(MessageBuffer& buffer, const int64 number);
+    static void append_unsigned(MessageBuffer& buffer, const uint64 number);
+    static void append_float(MessageBuffer& buffer, const long double number);
+
+    template<typename T>
+    static void append(MessageBuffer& buffer, const T& component) {
+        if constexpr (std::is_enum_v<T>) {
+            append(buffer, (std::underlying_type_t<T>) component);
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            append_signed(buffer, component);
+        } else if constexpr (std::is_integral_v<T>) {
+            append_unsigned(buffer, component);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            append_float(buffer, (long double) component);
+        } else if constexpr (std::is_convertible_v<const T&, const char*>) {
+            const char* const text = component;
+            buffer.append(text, strlen(text));
+        } else if constexpr (std::is_convertible_v<
+                                 const T&,
+                                 std::string_view>) {
+            const std::string_view text = component;
+            buffer.append(text.data(), text.size());
+        } else {
+            // Types with a custom String conversion (e.g. StringId)
+            const String text = String::build(component);
+            buffer.append(text.data(), text.size());
+        }
+    }
+};
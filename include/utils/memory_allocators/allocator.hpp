@@ -6,11 +6,27 @@
 
 /**
  * @brief Interface for a generic memory allocator. Provides elementary methods
- * required of any allocator.
+ * required of any allocator. Memory is reserved directly from the OS in one or
+ * more arenas. Allocators start with a single arena of the initial size and
+ * chain additional, geometrically growing, ones on demand. Arena pages are
+ * committed explicitly, as the allocator's high-water mark within the arena
+ * advances.
  *
  */
 class Allocator {
   public:
+    /**
+     * @brief Callback invoked when an arena gets reserved or released
+     *
+     * @param user_data Value given to set_arena_callback
+     * @param start Arena start
+     * @param size Arena size in bytes
+     * @param added true if arena was reserved, false if it's being released
+     */
+    typedef void (*ArenaCallback)(
+        void* user_data, const void* start, const uint64 size, const bool added
+    );
+
     Allocator(const uint64 total_size)
         : _total_size { total_size }, _used { 0 }, _peak { 0 } {}
     virtual ~Allocator();
@@ -50,12 +66,109 @@ class Allocator {
      */
     virtual bool  owns(void* ptr);
 
+    /// @brief Bytes currently in use (padding & headers included)
+    uint64 get_used() const { return _used; }
+    /// @brief Highest number of bytes in use since the last reset
+    uint64 get_peak() const { return _peak; }
+    /// @brief Bytes currently reserved from the OS across all arenas
+    virtual uint64 get_reserved() const;
+    /// @brief True if (de)allocations can be made from multiple threads at
+    /// once without external locking
+    virtual bool   is_thread_safe() const { return false; }
+
+    /**
+     * @brief Register a callback notified about every arena change. Callback
+     * is immediately invoked for all currently reserved arenas.
+     *
+     * @param callback Callback function (nullptr to unregister)
+     * @param user_data Value passed to each callback invocation
+     */
+    virtual void set_arena_callback(
+        const ArenaCallback callback, void* const user_data
+    );
+
   protected:
-    void*  _start_ptr = nullptr;
-    uint64 _total_size;
+    /// @brief Continuous memory region reserved from the OS. Memory below
+    /// the committed high-water mark is backed by physical pages.
+    struct Arena {
+        void*  start;
+        uint64 size;
+        uint64 committed;
+        Arena* next;
+    };
+
+    /// @brief Pages are committed in steps of this size (Windows allocation
+    /// granularity), to limit the number of system calls
+    static constexpr uint64 commit_step = 64 * 1024;
+
+    void*         _start_ptr           = nullptr;
+    Arena*        _arenas              = nullptr;
+    ArenaCallback _arena_callback      = nullptr;
+    void*         _arena_callback_data = nullptr;
+    uint64        _total_size;
     uint64 _used;
     uint64 _peak;
 
+    /**
+     * @brief Reserve a new arena and append it to the arena list
+     *
+     * @param min_size Minimal arena size in bytes. Arenas are never smaller
+     * then the initial reserve, nor then all previous arenas combined.
+     * @return Arena* Added arena, nullptr if OS is out of memory
+     */
+    Arena* add_arena(const uint64 min_size);
+    /**
+     * @brief Find arena containing a given memory location
+     *
+     * @param ptr Pointer to a location in memory
+     * @return Arena* Containing arena, nullptr if there is none
+     */
+    Arena* find_arena(const void* ptr) const;
+    /**
+     * @brief Release arenas back to the OS
+     *
+     * @param after All arenas after this one are released. If nullptr every
+     * arena is released.
+     */
+    void   release_arenas(Arena* const after = nullptr);
+    /**
+     * @brief Return physical pages of all arenas after a given one to the OS.
+     * Arenas stay reserved for later reuse.
+     *
+     * @param after Last arena kept committed
+     */
+    void   decommit_arenas(Arena* const after);
+
+    /**
+     * @brief Commit arena memory up to a given offset. Must be called before
+     * memory above the arena's committed high-water mark is first accessed.
+     *
+     * @param arena Accessed arena
+     * @param end Offset from the arena start up to which memory is accessed
+     */
+    void commit_arena(Arena* const arena, const uint64 end) {
+        if (end > arena->committed) raise_committed(arena, end);
+    }
+    /**
+     * @brief Commit all pages overlapping a memory range. Arena high-water
+     * marks are left unchanged.
+     *
+     * @param start Range start
+     * @param size Range size in bytes
+     */
+    static void commit_range(const uint64 start, const uint64 size);
+    /**
+     * @brief Return physical pages fully contained in a memory range of an
+     * arena to the OS. Arena's high-water mark is lowered accordingly.
+     *
+     * @param arena Arena containing the range
+     * @param start Range start
+     * @param size Range size in bytes
+     */
+    void decommit_range(
+        Arena* const arena, const uint64 start, const uint64 size
+    );
+
     static const uint64 calculate_padding(
         const uint64 base_address, const uint64 alignment
     ) {
@@ -70,4 +183,7 @@ class Allocator {
         return header_size +
                calculate_padding(base_address + header_size, alignment);
     }
+
+  private:
+    void raise_committed(Arena* const arena, const uint64 end);
 };
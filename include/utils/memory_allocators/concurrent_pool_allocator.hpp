@@ -0,0 +1,58 @@
+#pragma once
+
+#include "allocator.hpp"
+
+#include <atomic>
+#include <mutex>
+
+/**
+ * @brief Thread safe pool allocator. Same as PoolAllocator, populates reserved
+ * memory with fixed sized chunks, but allocations and deallocations can be
+ * made from any number of threads at once without locking. Free chunks are
+ * kept in a lock-free (Treiber) stack, whose head carries a modification tag
+ * in its upper 16 bits to protect against ABA. Only carving new chunks from
+ * the arenas (adding an arena if needed), when all chunks are taken, is done
+ * under a lock.
+ */
+class ConcurrentPoolAllocator : public Allocator {
+  public:
+    /**
+     * @brief Construct a new Concurrent Pool Allocator object
+     *
+     * @param total_size Size of the initial reserve. Additional reserves of at
+     * least this size are added on demand.
+     * @param chunk_size Size of individual chunks.
+     */
+    ConcurrentPoolAllocator(const uint64 total_size, const uint64 chunk_size);
+
+    virtual void* allocate(const uint64 size, const uint64 alignment = 0)
+        override;
+    virtual void free(void* ptr) override;
+    /**
+     * @brief Resets all allocations. Unlike (de)allocations, not thread safe.
+     */
+    virtual void reset() override;
+    virtual bool owns(void* ptr) override;
+
+    virtual uint64 get_reserved() const override;
+    virtual bool   is_thread_safe() const override { return true; }
+
+  private:
+    struct Node {
+        Node* next;
+    };
+
+    // Lower 48 bits hold the head node, upper 16 bits the modification tag
+    std::atomic<uint64>          _head { 0 };
+    mutable std::recursive_mutex _grow_lock {};
+
+    uint64 _chunk_size;
+    Arena* _carve_arena  = nullptr;
+    uint64 _carve_offset = 0;
+
+    ConcurrentPoolAllocator(ConcurrentPoolAllocator& pool_allocator);
+
+    void carve_chunks();
+    void push_chain(Node* const first, Node* const last);
+    void update_usage(const int64 change);
+};
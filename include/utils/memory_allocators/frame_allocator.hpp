@@ -0,0 +1,50 @@
+#pragma once
+
+#include "linear_allocator.hpp"
+
+/**
+ * @brief Frame allocator. Keeps one linear allocator per frame in flight.
+ * Allocations are made from the slot of the frame currently being recorded
+ * and live until the same slot is used again, that is until the GPU finished
+ * with that frame. Individual deallocations are ignored, memory of a slot is
+ * released all at once at the beginning of its next frame.
+ */
+class FrameAllocator : public Allocator {
+  public:
+    /**
+     * @brief Construct a new Frame Allocator object
+     *
+     * @param frame_size Size of the initial reserve of each frame slot
+     * @param frame_count Number of frame slots (frames in flight)
+     */
+    FrameAllocator(const uint64 frame_size, const uint32 frame_count);
+    ~FrameAllocator();
+
+    virtual void  init() override;
+    virtual void* allocate(const uint64 size, const uint64 alignment = 0)
+        override;
+    virtual void  free(void* ptr) override;
+    virtual void  reset() override;
+    virtual bool  owns(void* ptr) override;
+
+    virtual uint64 get_reserved() const override;
+    virtual void   set_arena_callback(
+        const ArenaCallback callback, void* const user_data
+    ) override;
+
+    /**
+     * @brief Switch to a given frame slot and release all memory previously
+     * allocated in it. Must only be called once the GPU no longer uses data
+     * from the last frame recorded with this slot.
+     *
+     * @param frame_index Index of the frame slot
+     */
+    void begin_frame(const uint32 frame_index);
+
+  private:
+    LinearAllocator** _frames;
+    uint32            _frame_count;
+    uint32            _current_frame;
+
+    FrameAllocator(FrameAllocator& frame_allocator);
+};
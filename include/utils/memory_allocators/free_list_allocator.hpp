@@ -8,18 +8,25 @@
  * then manages using a free list. Allows for allocations of any size, but isn't
  * all that memory efficient for a high volume of super small size allocations.
  * If a specific allocation is too small produces a warning. Owns method will
- * return true if given memory location is within the initial reserve.
+ * return true if given memory location is within any of the reserved arenas.
+ * When no free block is large enough a new arena is added. Arenas other then
+ * the initial one are returned to the OS once all their memory gets freed.
+ *
+ * With SegregatedFit placement policy free blocks are instead kept in
+ * size-class bins (two level segregated fit, TLSF) indexed by a bitmap, while
+ * boundary tags allow for constant time coalescing. In that case both
+ * allocation and deallocation are O(1) regardless of fragmentation.
  *
  */
 class FreeListAllocator : public Allocator {
   public:
-    enum PlacementPolicy { FindFirst, FindBest };
+    enum PlacementPolicy { FindFirst, FindBest, SegregatedFit };
 
     /**
      * @brief Construct a new Free List Allocator object
      *
-     * @param total_size Maximum possible total size this allocator can
-     * allocate
+     * @param total_size Size of the initial reserve. Additional reserves of at
+     * least this size are added on demand.
      * @param placement_policy Placement placement policy used when deciding
      * which of the free segments will be used for allocation
      */
@@ -46,6 +53,31 @@ class FreeListAllocator : public Allocator {
     PlacementPolicy              _placement_policy;
     SinglyLinkedList<FreeHeader> _free_list;
 
+    // Segregated fit
+    /**
+     * @brief Boundary tag placed at the start of every block. Lower bits of
+     * the tag store block state, rest is block size (always a multiple of 8).
+     * Free blocks additionally store bin links and have their size repeated in
+     * the last 8 bytes of the block.
+     */
+    struct Block {
+        uint64 tag;
+        Block* next_free;
+        Block* previous_free;
+    };
+
+    static constexpr uint64 _block_free          = 1;
+    static constexpr uint64 _block_previous_free = 2;
+    static constexpr uint64 _block_flags         = 7;
+    static constexpr uint64 _min_block_size      = 32;
+    static constexpr uint64 _sl_count_log2       = 4;
+    static constexpr uint64 _sl_count            = 1 << _sl_count_log2;
+    static constexpr uint64 _fl_count            = 64;
+
+    uint64 _fl_bitmap;
+    uint32 _sl_bitmap[_fl_count];
+    Block* _bins[_fl_count][_sl_count];
+
     FreeListAllocator(FreeListAllocator& free_list_allocator);
 
     void find(
@@ -70,5 +102,24 @@ class FreeListAllocator : public Allocator {
         Node*&       found_node
     );
 
-    void coalescence(Node* prev_block, Node* free_block);
+    Node* coalescence(Node* prev_block, Node* free_block);
+
+    void insert_arena(Arena* const arena);
+    void decommit_if_idle(const uint64 address, const uint64 size);
+
+    void* allocate_segregated(const uint64 size, const uint64 alignment);
+    void  free_segregated(void* ptr);
+    void  reset_segregated();
+
+    Block* find_segregated(const uint64 size);
+    void   insert_block(Block* block);
+    void   remove_block(Block* block);
+
+    static void mapping(const uint64 size, uint64& fl, uint64& sl);
+    static uint64 block_size(const Block* const block) {
+        return block->tag & ~_block_flags;
+    }
+    static Block* next_block(const Block* const block) {
+        return (Block*) ((uint64) block + block_size(block));
+    }
 };
\ No newline at end of file
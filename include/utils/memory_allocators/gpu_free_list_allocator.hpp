@@ -1,7 +1,7 @@
 #pragma once
 
-#include "forward_list.hpp"
-#include "map.hpp"
+#include "flat_map.hpp"
+#include "vector.hpp"
 
 /**
  * @brief Free list allocator specialized for management of GPU memory. Used
@@ -36,6 +36,7 @@ class GPUFreeListAllocator : public Allocator {
         override;
     virtual void free(void* ptr) override;
     virtual void reset() override;
+    virtual bool owns(void* ptr) override;
 
     /**
      * @brief Check if a memory segment is allocated here by this allocator.
@@ -58,11 +59,14 @@ class GPUFreeListAllocator : public Allocator {
         uint8  padding;
     };
 
-    typedef ForwardList<FreeHeader>::iterator Node;
+    // Index of a free segment in _free_list
+    typedef uint64 Node;
 
-    PlacementPolicy               _placement_policy;
-    ForwardList<FreeHeader>       _free_list {};
-    Map<uint64, AllocationHeader> _allocated {};
+    PlacementPolicy                   _placement_policy;
+    // Free segments sorted by offset. Kept contiguous, so searches don't chase
+    // pointers and nothing is allocated per segment.
+    Vector<FreeHeader>                _free_list {};
+    FlatMap<uint64, AllocationHeader> _allocated {};
 
     GPUFreeListAllocator(GPUFreeListAllocator& free_list_allocator);
 
@@ -70,23 +74,20 @@ class GPUFreeListAllocator : public Allocator {
         const uint64 size,
         const uint64 alignment,
         uint64&      padding,
-        Node&        previous_node,
         Node&        found_node
     );
     void find_best(
         const uint64 size,
         const uint64 alignment,
         uint64&      padding,
-        Node&        previous_node,
         Node&        found_node
     );
     void find_first(
         const uint64 size,
         const uint64 alignment,
         uint64&      padding,
-        Node&        previous_node,
         Node&        found_node
     );
 
-    void coalescence(Node prev_block, Node free_block);
+    void coalescence(const Node next_node, const FreeHeader free_node);
 };
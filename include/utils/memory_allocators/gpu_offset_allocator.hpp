@@ -0,0 +1,205 @@
+#pragma once
+
+#include "vector.hpp"
+
+/**
+ * @brief Offset allocator specialized for management of GPU memory. Works in
+ * a similar manner to the GPUFreeListAllocator (only host side bookkeeping,
+ * returned values are in-buffer offsets), but with bounded O(1) allocate and
+ * free. Free regions are sorted into 256 size bins (32 exponent bins, each
+ * split into 8 mantissa bins) tracked with two levels of bitmasks, so a
+ * fitting region is found with two bit scans. Regions live in a flat node
+ * array, linked both to their bin and to their address neighbors, which
+ * makes coalescing on free constant time as well. Each allocation is
+ * identified by a 32-bit handle (its node index) which is needed for free.
+ * Offsets and sizes are limited to 32 bits.
+ */
+class GPUOffsetAllocator {
+  public:
+    /// @brief Handle (and node index) value meaning "none"
+    static constexpr uint32 invalid_handle = UINT32_MAX;
+
+    /// @brief Result of an allocation
+    struct Allocation {
+        /// @brief In-buffer offset of the allocated (aligned) region
+        uint32 offset = 0;
+        /// @brief Handle used to free this allocation
+        uint32 handle = invalid_handle;
+
+        /// @brief False if allocation failed (out of space or nodes)
+        bool is_valid() const { return handle != invalid_handle; }
+    };
+
+    /// @brief Relocation of an allocation, planned by defragmentation
+    struct Move {
+        /// @brief Handle of the relocated allocation
+        uint32 source_handle;
+        /// @brief Handle of the region it is relocated to
+        uint32 destination_handle;
+        /// @brief Start of the copied region
+        uint32 source_offset;
+        /// @brief Start of the region data is copied to
+        uint32 destination_offset;
+        /// @brief Number of bytes to copy
+        uint32 size;
+
+        /// @brief New location of the relocated allocation
+        Allocation apply(const Allocation allocation) const {
+            Allocation moved {};
+            moved.offset =
+                allocation.offset - source_offset + destination_offset;
+            moved.handle = destination_handle;
+            return moved;
+        }
+    };
+
+    /// @brief Contiguous range of the managed region
+    struct Region {
+        uint32 offset;
+        uint32 size;
+    };
+
+    /// @brief Free space fragmentation metrics
+    struct FragmentationStats {
+        /// @brief Total free bytes
+        uint32  free_bytes          = 0;
+        /// @brief Number of separate free regions
+        uint32  free_region_count   = 0;
+        /// @brief Size of the largest free region in bytes
+        uint32  largest_free_region = 0;
+        /// @brief Share of free bytes outside of the largest free region, in
+        /// range [0, 1]. Allocations bigger than the largest region fail even
+        /// if the total free space suffices.
+        float32 fragmentation       = 0.0f;
+    };
+
+    /**
+     * @brief Construct a new GPUOffsetAllocator object
+     *
+     * @param total_size Size of the managed region in bytes
+     * @param max_allocations Maximum number of live allocations. Nodes for
+     * them, and for the free regions in between, are allocated up front.
+     */
+    GPUOffsetAllocator(const uint32 total_size, const uint32 max_allocations);
+    ~GPUOffsetAllocator();
+
+    // Prevent accidental copying
+    GPUOffsetAllocator(GPUOffsetAllocator const&)            = delete;
+    GPUOffsetAllocator& operator=(GPUOffsetAllocator const&) = delete;
+
+    /**
+     * @brief Allocate a region
+     *
+     * @param size Size requirement in bytes
+     * @param alignment Required offset alignment. Regions are rounded up to a
+     * multiple of it, so buffers used with a single alignment stay aligned
+     * without any padding.
+     * @return Allocation Allocated region, invalid if there is no space left
+     */
+    Allocation allocate(const uint32 size, const uint32 alignment = 1);
+    /**
+     * @brief Free an allocated region
+     *
+     * @param handle Handle of the allocation
+     */
+    void       free(const uint32 handle);
+    /**
+     * @brief Free all allocations
+     */
+    void       reset();
+    /**
+     * @brief Extend the managed region at its end. Existing allocations keep
+     * their offsets and handles.
+     *
+     * @param total_size New size of the managed region in bytes, must be larger
+     * than the current one
+     */
+    void       grow(const uint32 total_size);
+
+    /**
+     * @brief Check if a region is fully contained in a single allocation.
+     * Walks all regions, meant only for debug checks.
+     *
+     * @param offset Region start
+     * @param size Region size in bytes
+     * @returns true If region is allocated
+     * @returns false Otherwise
+     */
+    bool allocated(const uint32 offset, const uint32 size) const;
+
+    /// @brief Size of the managed region in bytes
+    uint32 get_total_size() const { return _total_size; }
+    /// @brief Bytes currently in use (alignment padding included)
+    uint32 get_used() const { return _total_size - _free_storage; }
+    /// @brief Highest number of bytes in use since the last reset
+    uint32 get_peak() const { return _peak; }
+    /// @brief Lower bound of the largest free region size (size of its bin)
+    uint32 get_largest_free_region() const;
+    /// @brief Compute current fragmentation metrics
+    FragmentationStats get_fragmentation() const;
+    /// @brief Get all allocated ranges in address order, with adjacent
+    /// allocations merged into a single range
+    Vector<Region>     get_used_regions() const;
+
+    /**
+     * @brief Plan relocation of allocations from the end of the region into
+     * free regions closer to its start. Allocations are visited from the back
+     * and each is given a new (lower) region by the regular allocation path,
+     * so planning costs O(1) per visited allocation. Both regions of a planned
+     * move stay allocated: the caller copies the data, switches its references
+     * to the destination (see Move::apply) and frees the source handle once
+     * the old region is no longer in use. Sources of pending moves aren't
+     * planned again.
+     *
+     * @param max_bytes Maximum number of bytes to relocate
+     * @param alignment Allocations are moved by multiples of this value, so it
+     * must be a multiple of every alignment used with this allocator
+     * @param moves Vector to which the planned moves are appended
+     * @return uint32 Number of bytes planned for relocation
+     */
+    uint32 plan_defragmentation(
+        const uint32 max_bytes, const uint32 alignment, Vector<Move>& moves
+    );
+
+  private:
+    static constexpr uint32 _top_bin_count  = 32;
+    static constexpr uint32 _bins_per_leaf  = 8;
+    static constexpr uint32 _leaf_bin_count = _top_bin_count * _bins_per_leaf;
+    // Planning stops after this many allocations in a row couldn't be moved
+    static constexpr uint32 _max_failed_moves = 16;
+
+    struct Node {
+        uint32 offset;
+        uint32 size;
+        uint32 bin_prev;
+        uint32 bin_next;
+        uint32 neighbor_prev;
+        uint32 neighbor_next;
+        bool   used;
+        // Source of a pending defragmentation move
+        bool   moving;
+    };
+
+    uint32  _total_size;
+    uint32  _max_nodes;
+    uint32  _free_storage;
+    uint32  _peak;
+    uint32  _free_region_count;
+    // First and last region in address order
+    uint32  _first_node;
+    uint32  _last_node;
+    // Bit i set if any bin of top bin i is used
+    uint32  _used_bins_top;
+    // Bit j of entry i set if bin (i * 8 + j) is used
+    uint8   _used_bins[_top_bin_count];
+    // First node of each bin
+    uint32  _bin_indices[_leaf_bin_count];
+    Node*   _nodes;
+    // Stack of unused node indices
+    uint32* _free_nodes;
+    uint32  _free_node_count;
+
+    uint32 allocate_node(const uint32 size);
+    uint32 insert_node_into_bin(const uint32 offset, const uint32 size);
+    void   remove_node_from_bin(const uint32 node_index);
+};
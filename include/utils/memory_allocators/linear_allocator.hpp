@@ -6,15 +6,17 @@
  * @brief Linear allocator. Reserves a chunk of memory which can then be freely
  * allocated with allocations of any size. Allocations are made one after
  * another in linear fashion. Disallows all deallocations, except for total
- * memory reset of reserved segment.
+ * memory reset of reserved segment. When the current arena fills up allocation
+ * continues in the next one. On reset arenas which weren't reached since the
+ * previous reset are returned to the OS.
  */
 class LinearAllocator : public Allocator {
   public:
     /**
      * @brief Construct a new Linear Allocator object
      *
-     * @param total_size Maximum possible total size this allocator can
-     * allocate
+     * @param total_size Size of the initial reserve. Additional reserves of at
+     * least this size are added on demand.
      */
     LinearAllocator(const uint64 total_size);
 
@@ -25,6 +27,7 @@ class LinearAllocator : public Allocator {
 
   protected:
     uint64 _offset;
+    Arena* _current_arena;
 
   private:
     LinearAllocator(LinearAllocator& linear_allocator);
@@ -6,15 +6,17 @@
 /**
  * @brief Pool allocator. Reserves a pice of memory which it then can only
  * populate with the same fixed sized chunks. Each (de)allocation will
- * (de)allocate one chuck.
+ * (de)allocate one chuck. Freed chunks are reused first, new ones are carved
+ * from the arenas in address order. When all chunks are taken a new arena is
+ * added.
  */
 class PoolAllocator : public Allocator {
   public:
     /**
      * @brief Construct a new Pool Allocator object
      *
-     * @param total_size Maximum possible total size this allocator can
-     * allocate
+     * @param total_size Size of the initial reserve. Additional reserves of at
+     * least this size are added on demand.
      * @param chunk_size Size of individual chunks.
      */
     PoolAllocator(const uint64 total_size, const uint64 chunk_size);
@@ -30,6 +32,10 @@ class PoolAllocator : public Allocator {
     StackLinkedList<FreeHeader> _free_list;
 
     uint64 _chunk_size;
+    Arena* _carve_arena  = nullptr;
+    uint64 _carve_offset = 0;
 
     PoolAllocator(PoolAllocator& pool_allocator);
+
+    void* carve_chunk();
 };
\ No newline at end of file
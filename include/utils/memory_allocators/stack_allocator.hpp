@@ -5,11 +5,19 @@
 /**
  * @brief Stack allocator. Reserves a chunk of memory which then operates like a
  * LIFO queue (stack). Allocations take memory from the top of the stack, while
- * deallocations deallocate all memory higher on the stack.
+ * deallocations deallocate all memory higher on the stack. When the current
+ * arena fills up the stack continues in the next one. Arenas more then one
+ * above the top of the stack are returned to the OS.
  *
  */
 class StackAllocator : public Allocator {
   public:
+    /**
+     * @brief Construct a new Stack Allocator object
+     *
+     * @param total_size Size of the initial reserve. Additional reserves of at
+     * least this size are added on demand.
+     */
     StackAllocator(const uint64 total_size);
 
     virtual void* allocate(const uint64 size, const uint64 alignment = 0)
@@ -19,6 +27,7 @@ class StackAllocator : public Allocator {
 
   protected:
     uint64 _offset;
+    Arena* _current_arena;
 
   private:
     StackAllocator(StackAllocator& stack_allocator);
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "memory_system.hpp"
+
+#include <atomic>
+
+/**
+ * @brief Per-thread allocation front-end used by the MemorySystem. Keeps small
+ * magazines of free blocks per (memory tag, size class) pair, so that most
+ * allocations and deallocations never touch a lock. Magazines are refilled
+ * from (and flushed back to) the backing allocator in batches while holding
+ * its lock. Blocks freed on a thread other than the owning one get pushed to
+ * the owner's lock-free inbox and are reclaimed by the owner on its next
+ * allocation. Caches of exited threads are adopted by new threads.
+ */
+class MemorySystem::ThreadCache {
+  public:
+    /// @brief Maximum number of thread caches alive at the same time
+    static constexpr uint32 max_thread_caches = 64;
+    /// @brief Number of size classes (class 0 means "not cached")
+    static constexpr uint8  size_class_count  = 10;
+    /// @brief Size class used by fixed size (pool) tags
+    static constexpr uint8  fixed_size_class  = size_class_count;
+    /// @brief Block size (header included) of each size class
+    static constexpr uint64 size_classes[size_class_count] = {
+        0, 32, 48, 64, 96, 128, 192, 256, 384, 512
+    };
+
+    /**
+     * @brief Get thread cache of the calling thread. If this thread doesn't
+     * yet have a cache, one is created (or adopted from an exited thread).
+     *
+     * @return ThreadCache* Cache of the calling thread, nullptr if caching is
+     * not available (thread is exiting or cache limit is reached)
+     */
+    static ThreadCache* get();
+
+    /**
+     * @brief Allocate a block from the cache
+     *
+     * @param tag Memory tag index
+     * @param size Block size in bytes (header included)
+     * @return void* Block with filled thread cache header fields, or nullptr if
+     * this allocation can't be cached
+     */
+    void* allocate(const MEMORY_TAG_TYPE tag, const uint64 size);
+
+    /**
+     * @brief Return a thread cached block. Block is pushed to the calling
+     * thread's magazine if owned by it, to the owner's inbox otherwise.
+     *
+     * @param block Block previously returned by allocate
+     * @param tag Memory tag index
+     */
+    static void free(void* block, const MEMORY_TAG_TYPE tag);
+
+  private:
+    /// @brief Intrusive list of free blocks of the same size
+    struct Magazine {
+        void*  head       = nullptr;
+        uint32 count      = 0;
+        uint32 batch_size = 0;
+    };
+
+    /// @brief Releases the calling thread's cache on thread exit
+    struct Releaser {
+        ~Releaser();
+    };
+
+    static ThreadCache*              _registry[max_thread_caches];
+    static std::atomic<uint32>       _registry_size;
+    static std::mutex                _registry_lock;
+    static thread_local ThreadCache* _local;
+    static thread_local bool         _released;
+
+    uint8              _id;
+    std::atomic<bool>  _active;
+    std::atomic<void*> _inbox;
+    Magazine           _magazines[_tag_count][size_class_count + 1];
+
+    ThreadCache(const uint8 id);
+    ~ThreadCache();
+
+    static ThreadCache* acquire();
+
+    void release();
+    void drain_inbox();
+    void push(Magazine& magazine, void* block);
+    void refill(
+        const MEMORY_TAG_TYPE tag,
+        const uint8           size_class,
+        const uint64          block_size
+    );
+    void flush(
+        const MEMORY_TAG_TYPE tag,
+        const uint8           size_class,
+        const uint32          count
+    );
+
+    static uint8  get_size_class(const MEMORY_TAG_TYPE tag, const uint64 size);
+    static uint32 get_batch_size(const uint64 block_size);
+    static void*& next_of(void* block);
+};
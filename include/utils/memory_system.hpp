@@ -4,14 +4,34 @@
 #include "memory_allocators/linear_allocator.hpp"
 #include "memory_allocators/stack_allocator.hpp"
 #include "memory_allocators/pool_allocator.hpp"
+#include "memory_allocators/concurrent_pool_allocator.hpp"
 #include "memory_allocators/free_list_allocator.hpp"
+#include "memory_allocators/frame_allocator.hpp"
 
 #include <iostream>
 #include <type_traits>
 #include <memory>
+#include <mutex>
+#include <atomic>
 
 #define MEMORY_SYS_LOG "MemorySystem :: "
 
+// Per tag allocation statistics, recorded by tagged new & delete. Every
+// allocation updates shared counters, so release builds leave them out unless
+// enabled explicitly.
+#ifndef MEMORY_TELEMETRY_ENABLED
+#    ifdef NDEBUG
+#        define MEMORY_TELEMETRY_ENABLED 0
+#    else
+#        define MEMORY_TELEMETRY_ENABLED 1
+#    endif
+#endif
+
+// Pool allocations carry no header, their tag is found from the address
+#ifndef MEMORY_HEADERLESS_POOLS
+#    define MEMORY_HEADERLESS_POOLS 1
+#endif
+
 #define MEMORY_TAG_TYPE uint16
 #define MEMORY_PADDING 8
 
@@ -20,6 +40,8 @@ enum class MemoryTag : MEMORY_TAG_TYPE {
     // created.
     Unknown,
     Temp,
+    // Lives until the GPU is done with the frame in which it was allocated
+    Frame,
     // Data types
     Array,
     List,
@@ -52,32 +74,178 @@ enum class MemoryTag : MEMORY_TAG_TYPE {
     MAX_TAGS
 };
 
+class String;
+
 class MemorySystem {
   public:
+    /// @brief Maximum number of frames in flight supported by the Frame tag
+    static constexpr uint32 max_frames_in_flight = 3;
+    /// @brief Number of buckets in the allocation size histogram
+    static constexpr uint32 histogram_bucket_count = 16;
 
-    static void* allocate(uint64 size, const MemoryTag tag) {
-        auto allocator = _allocator_map[(MEMORY_TAG_TYPE) tag];
-        return allocator->allocate(size, MEMORY_PADDING);
-    }
+    /// @brief Allocation statistics of a single memory tag
+    struct TagStatistics {
+        /// @brief Bytes currently allocated (headers excluded)
+        uint64 live_bytes;
+        /// @brief Highest recorded value of live bytes
+        uint64 peak_bytes;
+        /// @brief Number of currently live allocations
+        uint64 live_count;
+        /// @brief Number of allocations made since startup
+        uint64 allocation_count;
+        /// @brief Number of allocations made during the last finished frame
+        uint64 last_frame_allocations;
+        /// @brief Most allocations made during a single frame
+        uint64 max_frame_allocations;
+        /// @brief Allocation counts by size. Bucket 0 counts sizes up to 16
+        /// bytes, bucket i sizes in range (8 << i, 16 << i] and the last one
+        /// all larger sizes.
+        uint64 size_histogram[histogram_bucket_count];
+    };
 
-    static void deallocate(void* ptr, const MemoryTag tag) {
-        auto allocator = _allocator_map[(MEMORY_TAG_TYPE) tag];
-        if (!allocator->owns(ptr)) {
-            std::cout << MEMORY_SYS_LOG << "Wrong memory tag." << std::endl;
-            exit(EXIT_FAILURE);
-        }
-        allocator->free(ptr);
-    }
+    /// @brief Output format of the memory report
+    enum class ReportFormat : uint8 { Table, JSON };
 
-    static void reset_memory(const MemoryTag tag) {
-        auto allocator = _allocator_map[(MEMORY_TAG_TYPE) tag];
-        allocator->reset();
-    }
+    /**
+     * @brief Allocate a memory block with a given tag. First MEMORY_PADDING
+     * bytes of the returned block are reserved for the allocation header
+     * which is filled by this method (except for headerless tags, which get
+     * the exact size). Small allocations are served by the calling thread's
+     * cache, others lock the backing allocator.
+     *
+     * @param size Block size in bytes (header included)
+     * @param tag Memory tag used
+     * @return void* Pointer to the beginning of the block (header)
+     */
+    static void* allocate(uint64 size, const MemoryTag tag);
+    /**
+     * @brief Deallocate a memory block previously allocated with allocate.
+     * Thread cached blocks are returned to the owning thread's cache.
+     *
+     * @param ptr Pointer to the beginning of the block (header)
+     * @param tag Memory tag used
+     */
+    static void  deallocate(void* ptr, const MemoryTag tag);
+    /**
+     * @brief Resets all allocations of the allocator responsible for a given
+     * tag. Not supported for thread cached tags.
+     *
+     * @param tag Memory tag used
+     */
+    static void  reset_memory(const MemoryTag tag);
+    /**
+     * @brief Start recording of a new frame. Releases all Frame tagged memory
+     * allocated the last time this frame index was used. Must be called once
+     * the GPU is done with that frame (its fence signaled).
+     *
+     * @param frame_index Index of the frame in flight
+     */
+    static void  begin_frame(const uint32 frame_index);
+
+    /**
+     * @brief Get allocation statistics of a given tag. All values are zero if
+     * MEMORY_TELEMETRY_ENABLED is not set.
+     *
+     * @param tag Memory tag used
+     * @return TagStatistics Snapshot of the current tag statistics
+     */
+    static TagStatistics get_statistics(const MemoryTag tag);
+    /**
+     * @brief Create a report of all tag statistics together with the usage of
+     * each backing allocator
+     *
+     * @param format Human readable table or JSON (for tooling)
+     * @return String Formatted report
+     */
+    static String get_report(const ReportFormat format = ReportFormat::Table);
+    /**
+     * @brief Mark the end of a frame. Closes the per frame allocation counters
+     * of all tags. Should be called once per frame.
+     */
+    static void   next_frame();
 
   private:
-    static Allocator** _allocator_map;
+    class ThreadCache;
+
+    /// @brief Header written at the start of each tagged allocation
+    struct AllocationHeader {
+        /// @brief Memory tag shifted left by 4, with 1111 in lower 4 bits
+        MEMORY_TAG_TYPE tag;
+        /// @brief Thread cache size class (0 if not thread cached)
+        uint8           size_class;
+        /// @brief Id of the thread cache which owns this block
+        uint8           owner;
+        /// @brief Requested size (written only if telemetry is enabled)
+        uint32          size;
+    };
+    static_assert(
+        sizeof(AllocationHeader) <= MEMORY_PADDING,
+        "Allocation header doesn't fit into memory padding."
+    );
+
+    /// @brief Address range of an arena owned by a headerless tag
+    struct ArenaEntry {
+        uint64          start;
+        uint64          end;
+        MEMORY_TAG_TYPE tag;
+    };
+    /// @brief Immutable sorted arena list, replaced as a whole on change
+    struct ArenaTable {
+        uint32      size;
+        ArenaEntry* entries;
+        ArenaTable* retired;
+    };
+
+    /// @brief Defines if and how allocations with a given tag get cached
+    enum class CachePolicy : uint8 {
+        /// @brief Always allocate directly from the backing allocator
+        None,
+        /// @brief Cache allocations rounded up to one of the size classes
+        SizeClass,
+        /// @brief Cache allocations of a single fixed size (pool allocators)
+        FixedSize
+    };
+
+    static constexpr uint64 _tag_count = (uint64) MemoryTag::MAX_TAGS;
+
+    /// @brief Telemetry counters of a single memory tag
+    struct TagCounters {
+        std::atomic<uint64> live_bytes;
+        std::atomic<uint64> peak_bytes;
+        std::atomic<uint64> live_count;
+        std::atomic<uint64> allocation_count;
+        std::atomic<uint64> frame_allocations;
+        std::atomic<uint64> last_frame_allocations;
+        std::atomic<uint64> max_frame_allocations;
+        std::atomic<uint64> size_histogram[histogram_bucket_count];
+    };
+
+    static Allocator**              _allocator_map;
+    static std::recursive_mutex*    _allocator_locks[_tag_count];
+    static CachePolicy              _cache_policy[_tag_count];
+    static TagCounters              _counters[_tag_count];
+    static std::atomic<uint64>      _frame_count;
+    static uint64                   _headerless_size[_tag_count];
+    static std::atomic<ArenaTable*> _arena_table;
+    static std::mutex               _arena_table_lock;
+
     static Allocator** initialize_allocator_map();
 
+    static void record_allocation(const uint64 size, const MEMORY_TAG_TYPE tag);
+    static void record_deallocation(
+        const uint64 size, const MEMORY_TAG_TYPE tag
+    );
+
+    static void on_arena_change(
+        void* user_data, const void* start, const uint64 size, const bool added
+    );
+    static bool find_headerless_tag(
+        const void* const ptr, MEMORY_TAG_TYPE& out_tag
+    );
+
+    friend void* operator new(std::size_t size, const MemoryTag tag);
+    friend void  operator delete(void* p) noexcept;
+
     MemorySystem();
     ~MemorySystem();
 };
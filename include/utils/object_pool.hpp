@@ -0,0 +1,388 @@
+#pragma once
+
+#include "logger.hpp"
+#include "memory_system.hpp"
+
+#include <atomic>
+#include <mutex>
+
+#define OBJECT_POOL_LOG "ObjectPool :: "
+
+/**
+ * @brief 32-bit generational handle to an object stored in an ObjectPool.
+ * Lower bits hold the slot index, upper bits the slot generation at the time
+ * of acquisition. Generation 0 is never used, so a zero handle is always null.
+ */
+struct ObjectHandle {
+    static constexpr uint32 index_bits      = 20;
+    static constexpr uint32 generation_bits = 32 - index_bits;
+    static constexpr uint32 index_mask      = (1u << index_bits) - 1;
+    static constexpr uint32 generation_mask = (1u << generation_bits) - 1;
+
+    /// @brief Raw handle value
+    uint32 value = 0;
+
+    ObjectHandle() {}
+    explicit ObjectHandle(const uint32 value) : value(value) {}
+    ObjectHandle(const uint32 index, const uint32 generation)
+        : value((generation << index_bits) | index) {}
+
+    /// @brief Slot index of the referenced object
+    uint32 index() const { return value & index_mask; }
+    /// @brief Slot generation at the time of acquisition
+    uint32 generation() const { return value >> index_bits; }
+    /// @brief True if this handle doesn't reference any object
+    bool   is_null() const { return value == 0; }
+
+    bool operator==(const ObjectHandle& other) const {
+        return value == other.value;
+    }
+    bool operator!=(const ObjectHandle& other) const {
+        return value != other.value;
+    }
+};
+
+/**
+ * @brief Fixed capacity typed pool of objects. Objects live densely in slot
+ * chunks of chunk_capacity objects, allocated with the pool's memory tag when
+ * first needed, and never move once constructed, so raw pointers stay valid
+ * until release. Objects are referenced by generational handles; acquire,
+ * release and handle validation are O(1) and need no lookups. Live objects
+ * are additionally tracked in a packed index list, so iteration visits only
+ * live slots and can prefetch the next object ahead.
+ *
+ * Acquire, release, is_valid & get can be called from any number of threads
+ * at once. Released slots are kept in a lock-free (Treiber) stack, whose head
+ * carries a modification tag in its upper 32 bits to protect against ABA,
+ * fresh slots are taken from a shared counter and releases are claimed by
+ * swapping the slot generation. Only the update of the live list is done
+ * under a (short) lock. Clear & for_each aren't thread safe.
+ *
+ * @tparam T Stored object type
+ */
+template<typename T>
+class ObjectPool {
+  public:
+    /// @brief Max number of objects a pool can hold (limited by handle size)
+    static constexpr uint32 max_capacity   = ObjectHandle::index_mask + 1;
+    /// @brief Number of objects per slot chunk (power of 2)
+    static constexpr uint32 chunk_capacity = 64;
+
+    /**
+     * @brief Construct a new Object Pool object. Slot bookkeeping is
+     * allocated up front, object storage a chunk at a time on acquire.
+     *
+     * @param capacity Maximum number of objects
+     * @param tag Memory tag used for slot chunk allocations
+     */
+    ObjectPool(const uint32 capacity, const MemoryTag tag);
+    ~ObjectPool();
+
+    // Prevent accidental copying
+    ObjectPool(ObjectPool const&)            = delete;
+    ObjectPool& operator=(ObjectPool const&) = delete;
+
+    /// @brief Maximum number of objects in the pool
+    uint32 capacity() const { return _capacity; }
+    /// @brief Number of live objects
+    uint32 size() const { return _size.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Construct a new object in a free slot
+     *
+     * @param args Arguments forwarded to the object constructor
+     * @return ObjectHandle Handle to the new object, null if the pool is full
+     */
+    template<typename... Args>
+    ObjectHandle acquire(Args&&... args);
+    /**
+     * @brief Destroy an object and free its slot. All handles to this object
+     * become invalid. Stale handles are ignored. The object must not be in
+     * use by other threads.
+     *
+     * @param handle Handle to the released object
+     * @return true If the object was released
+     * @return false If the handle was stale or null
+     */
+    bool         release(const ObjectHandle handle);
+    /**
+     * @brief Destroy all live objects. Not thread safe.
+     */
+    void         clear();
+
+    /**
+     * @brief Check whether a handle references a live object
+     *
+     * @param handle Checked handle
+     * @return true If handle is valid
+     * @return false If handle is stale or null
+     */
+    bool is_valid(const ObjectHandle handle) const {
+        // Generation 0 marks slots which were never used, slot generation is
+        // set once its object is constructed & changes on release
+        const uint32 index = handle.index();
+        return index < _capacity && handle.generation() != 0 &&
+               _generations[index].load(std::memory_order_acquire) ==
+                   handle.generation();
+    }
+
+    /**
+     * @brief Get referenced object
+     *
+     * @param handle Object handle
+     * @return T* Pointer to the object, nullptr if handle is stale or null
+     */
+    T* get(const ObjectHandle handle) const {
+        if (!is_valid(handle)) return nullptr;
+        return slot(handle.index());
+    }
+
+    /**
+     * @brief Call a function for each live object, in no particular order.
+     * Objects must not be acquired or released while iterating. Not thread
+     * safe.
+     *
+     * @param function Callable taking (ObjectHandle, T&)
+     */
+    template<typename Function>
+    void for_each(Function function);
+
+  private:
+    /// @brief Number of live objects prefetched ahead of iteration
+    static constexpr uint32 _prefetch_distance = 4;
+    /// @brief Lower 32 bits of the free slot stack head
+    static constexpr uint64 _index_mask        = 0xFFFFFFFF;
+
+    static_assert(
+        (chunk_capacity & (chunk_capacity - 1)) == 0,
+        "Chunk capacity must be a power of 2."
+    );
+
+    uint32    _capacity;
+    MemoryTag _tag;
+
+    std::atomic<uint32> _size { 0 };
+    // Slots ever taken, all slots past this one are unused
+    std::atomic<uint32> _slot_count { 0 };
+    // Lower 32 bits hold the top slot index + 1 (0 if empty), upper 32 bits
+    // the modification tag
+    std::atomic<uint64> _free_head { 0 };
+    // Guards the live list
+    std::mutex          _live_lock {};
+
+    // Object storage, chunk_capacity slots per chunk
+    std::atomic<T*>*     _chunks;
+    // Current generation of each slot
+    std::atomic<uint32>* _generations;
+    // Free slot stack links, index of the next free slot + 1
+    std::atomic<uint32>* _next_free;
+    // Slot indices of live objects (first _size entries)
+    uint32*              _live;
+    // Position of each live slot in the _live list
+    uint32*              _live_position;
+
+    T* slot(const uint32 index) const {
+        return _chunks[index / chunk_capacity].load(std::memory_order_acquire) +
+               index % chunk_capacity;
+    }
+
+    uint32 take_slot();
+    void   return_slot(const uint32 index);
+    T*     get_chunk(const uint32 index);
+};
+
+// Constructor & Destructor
+template<typename T>
+ObjectPool<T>::ObjectPool(const uint32 capacity, const MemoryTag tag)
+    : _capacity(capacity), _tag(tag) {
+    if (capacity == 0 || capacity > max_capacity)
+        Logger::fatal(
+            OBJECT_POOL_LOG,
+            "Pool capacity must be in range [1, ",
+            max_capacity,
+            "], but ",
+            capacity,
+            " was requested."
+        );
+    static_assert(
+        alignof(T) <= MEMORY_PADDING,
+        "Object alignment isn't supported by tagged allocations."
+    );
+
+    // Single block: chunk pointers followed by slot bookkeeping
+    const uint32 chunk_count =
+        (capacity + chunk_capacity - 1) / chunk_capacity;
+    const uint64 block_size =
+        sizeof(std::atomic<T*>) * chunk_count +
+        (2 * sizeof(std::atomic<uint32>) + 2 * sizeof(uint32)) * capacity;
+    byte* const block = (byte*) operator new(block_size, MemoryTag::Array);
+
+    _chunks        = (std::atomic<T*>*) block;
+    _generations   = (std::atomic<uint32>*) (_chunks + chunk_count);
+    _next_free     = _generations + capacity;
+    _live          = (uint32*) (_next_free + capacity);
+    _live_position = _live + capacity;
+
+    for (uint32 i = 0; i < chunk_count; i++)
+        ::new (_chunks + i) std::atomic<T*>(nullptr);
+    for (uint32 i = 0; i < capacity; i++) {
+        ::new (_generations + i) std::atomic<uint32>(0);
+        ::new (_next_free + i) std::atomic<uint32>(0);
+    }
+}
+template<typename T>
+ObjectPool<T>::~ObjectPool() {
+    clear();
+    const uint32 chunk_count =
+        (_capacity + chunk_capacity - 1) / chunk_capacity;
+    for (uint32 i = 0; i < chunk_count; i++) {
+        T* const chunk = _chunks[i].load(std::memory_order_relaxed);
+        if (chunk != nullptr) operator delete(chunk);
+    }
+    operator delete(_chunks);
+}
+
+// ////////////////////////// //
+// OBJECT POOL PUBLIC METHODS //
+// ////////////////////////// //
+
+template<typename T>
+template<typename... Args>
+ObjectHandle ObjectPool<T>::acquire(Args&&... args) {
+    const uint32 index = take_slot();
+    if (index == _capacity) return {};
+
+    ::new (get_chunk(index) + index % chunk_capacity)
+        T(std::forward<Args>(args)...);
+
+    // Released slots already carry their next generation
+    uint32 generation = _generations[index].load(std::memory_order_relaxed);
+    if (generation == 0) {
+        generation = 1;
+        _generations[index].store(generation, std::memory_order_release);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock { _live_lock };
+        const uint32                position = _size.load();
+        _live[position]                      = index;
+        _live_position[index]                = position;
+        _size.store(position + 1, std::memory_order_relaxed);
+    }
+    return ObjectHandle(index, generation);
+}
+
+template<typename T>
+bool ObjectPool<T>::release(const ObjectHandle handle) {
+    if (!is_valid(handle)) return false;
+
+    // Invalidate remaining handles, skipping 0 so that no handle is ever
+    // null. Only one of the threads releasing the same handle succeeds.
+    const uint32 index      = handle.index();
+    uint32       expected   = handle.generation();
+    uint32       generation = (expected + 1) & ObjectHandle::generation_mask;
+    if (generation == 0) generation = 1;
+    if (!_generations[index].compare_exchange_strong(
+            expected, generation, std::memory_order_acq_rel
+        ))
+        return false;
+
+    slot(index)->~T();
+
+    // Swap released slot with the last live one
+    {
+        std::lock_guard<std::mutex> lock { _live_lock };
+        const uint32                last       = _size.load() - 1;
+        const uint32                position   = _live_position[index];
+        const uint32                last_index = _live[last];
+        _live[position]                        = last_index;
+        _live_position[last_index]             = position;
+        _size.store(last, std::memory_order_relaxed);
+    }
+
+    return_slot(index);
+    return true;
+}
+
+template<typename T>
+void ObjectPool<T>::clear() {
+    while (_size.load() > 0) {
+        const uint32 index = _live[_size.load() - 1];
+        release(ObjectHandle(index, _generations[index].load()));
+    }
+}
+
+template<typename T>
+template<typename Function>
+void ObjectPool<T>::for_each(Function function) {
+    const uint32 size = _size.load();
+    for (uint32 i = 0; i < size; i++) {
+        if (i + _prefetch_distance < size)
+            __builtin_prefetch(slot(_live[i + _prefetch_distance]));
+        const uint32 index = _live[i];
+        function(ObjectHandle(index, _generations[index].load()), *slot(index));
+    }
+}
+
+// /////////////////////////// //
+// OBJECT POOL PRIVATE METHODS //
+// /////////////////////////// //
+
+// Returns _capacity if the pool is full
+template<typename T>
+uint32 ObjectPool<T>::take_slot() {
+    // Reuse a released slot
+    uint64 head = _free_head.load(std::memory_order_acquire);
+    while ((head & _index_mask) != 0) {
+        const uint32 index = (uint32) (head & _index_mask) - 1;
+        const uint64 next =
+            ((head & ~_index_mask) + (_index_mask + 1)) |
+            _next_free[index].load(std::memory_order_relaxed);
+        if (_free_head.compare_exchange_weak(
+                head, next, std::memory_order_acquire
+            ))
+            return index;
+    }
+
+    // Take a fresh slot
+    uint32 slot_count = _slot_count.load(std::memory_order_relaxed);
+    while (slot_count < _capacity) {
+        if (_slot_count.compare_exchange_weak(
+                slot_count, slot_count + 1, std::memory_order_acq_rel
+            ))
+            return slot_count;
+    }
+    return _capacity;
+}
+
+template<typename T>
+void ObjectPool<T>::return_slot(const uint32 index) {
+    uint64 head = _free_head.load(std::memory_order_relaxed);
+    uint64 next;
+    do {
+        _next_free[index].store(
+            (uint32) (head & _index_mask), std::memory_order_relaxed
+        );
+        next = ((head & ~_index_mask) + (_index_mask + 1)) | (index + 1);
+    } while (!_free_head.compare_exchange_weak(
+        head, next, std::memory_order_release, std::memory_order_relaxed
+    ));
+}
+
+// Storage of the chunk holding a slot, allocated on first use
+template<typename T>
+T* ObjectPool<T>::get_chunk(const uint32 index) {
+    auto& chunk   = _chunks[index / chunk_capacity];
+    T*    storage = chunk.load(std::memory_order_acquire);
+    if (storage != nullptr) return storage;
+
+    // Another thread might allocate the same chunk, only one of them is kept
+    T* const allocated =
+        (T*) operator new(sizeof(T) * chunk_capacity, _tag);
+    if (chunk.compare_exchange_strong(
+            storage, allocated, std::memory_order_acq_rel
+        ))
+        return allocated;
+    operator delete(allocated);
+    return storage;
+}
@@ -0,0 +1,213 @@
+#pragma once
+
+#include "object_pool.hpp"
+#include "vector.hpp"
+
+#define SLOT_MAP_LOG "SlotMap :: "
+
+/**
+ * @brief Growable container of objects referenced by generational handles.
+ * Unlike ObjectPool, objects are kept densely packed in a single array, with
+ * the last one moved into the hole left by an erased one. Iteration is then a
+ * plain walk over contiguous memory, but pointers to objects are invalidated
+ * by insertion & erasure, only handles stay valid. Insertion, erasure & handle
+ * lookup are O(1).
+ *
+ * @tparam T Stored object type
+ */
+template<typename T>
+class SlotMap {
+  public:
+    typedef T        value_type;
+    typedef T*       iterator;
+    typedef const T* const_iterator;
+    typedef uint64   size_type;
+
+    /// @brief Max number of objects a slot map can hold (limited by handle
+    /// size)
+    static constexpr uint32 max_capacity = ObjectHandle::index_mask + 1;
+
+    /// @brief Construct a new Slot Map object. No memory is allocated until
+    /// the first insertion.
+    SlotMap() : SlotMap(MemoryTag::Array) {}
+    /**
+     * @brief Construct a new Slot Map object. No memory is allocated until
+     * the first insertion.
+     *
+     * @param tag Memory tag of the object & slot storage
+     */
+    explicit SlotMap(const MemoryTag tag);
+
+    // Iterators, objects are visited in no particular order
+    iterator       begin() { return _objects.data(); }
+    iterator       end() { return _objects.data() + _objects.size(); }
+    const_iterator begin() const { return _objects.data(); }
+    const_iterator end() const { return _objects.data() + _objects.size(); }
+
+    // Capacity
+    bool      empty() const { return _objects.empty(); }
+    size_type size() const { return _objects.size(); }
+    /// @brief Make room for at least count objects
+    void      reserve(const size_type count);
+
+    /**
+     * @brief Construct a new object
+     *
+     * @param args Arguments forwarded to the object constructor
+     * @return ObjectHandle Handle to the new object
+     */
+    template<typename... Args>
+    ObjectHandle insert(Args&&... args);
+    /**
+     * @brief Destroy an object. All handles to this object become invalid.
+     * Stale handles are ignored.
+     *
+     * @param handle Handle to the erased object
+     * @return true If the object was erased
+     * @return false If the handle was stale or null
+     */
+    bool         erase(const ObjectHandle handle);
+    /**
+     * @brief Destroy all objects, keeping the allocated storage
+     */
+    void         clear();
+
+    /**
+     * @brief Check whether a handle references a live object
+     *
+     * @param handle Checked handle
+     * @return true If handle is valid
+     * @return false If handle is stale or null
+     */
+    bool is_valid(const ObjectHandle handle) const {
+        // Generation of a slot changes on erase, so it never matches
+        // handles to erased objects
+        const uint32 index = handle.index();
+        return index < _slots.size() &&
+               _slots[index].generation == handle.generation();
+    }
+
+    /**
+     * @brief Get referenced object
+     *
+     * @param handle Object handle
+     * @return T* Pointer to the object, nullptr if handle is stale or null
+     */
+    T*       get(const ObjectHandle handle) {
+        if (!is_valid(handle)) return nullptr;
+        return _objects.data() + _slots[handle.index()].position;
+    }
+    const T* get(const ObjectHandle handle) const {
+        if (!is_valid(handle)) return nullptr;
+        return _objects.data() + _slots[handle.index()].position;
+    }
+
+    /**
+     * @brief Call a function for each object, in no particular order.
+     * Objects must not be inserted or erased from within the function.
+     *
+     * @param function Callable taking (ObjectHandle, T&)
+     */
+    template<typename Function>
+    void for_each(Function function);
+
+  private:
+    static constexpr uint32 no_slot = (uint32) -1;
+
+    struct Slot {
+        // Position of the object in _objects while live, otherwise index of
+        // the next free slot
+        uint32 position;
+        uint32 generation;
+    };
+
+    // Densely packed objects
+    Vector<T>      _objects;
+    // Slot index of each object in _objects
+    Vector<uint32> _object_slots;
+    // Slots, indexed by handle index
+    Vector<Slot>   _slots;
+    // First slot of the free slot chain
+    uint32         _free_slot = no_slot;
+};
+
+// Constructor
+template<typename T>
+SlotMap<T>::SlotMap(const MemoryTag tag)
+    : _objects(TAllocator<T>(tag)), _object_slots(TAllocator<uint32>(tag)),
+      _slots(TAllocator<Slot>(tag)) {}
+
+// /////////////////////// //
+// SLOT MAP PUBLIC METHODS //
+// /////////////////////// //
+
+template<typename T>
+void SlotMap<T>::reserve(const size_type count) {
+    _objects.reserve(count);
+    _object_slots.reserve(count);
+    _slots.reserve(count);
+}
+
+template<typename T>
+template<typename... Args>
+ObjectHandle SlotMap<T>::insert(Args&&... args) {
+    uint32 index = _free_slot;
+    if (index == no_slot) {
+        if (_slots.size() == max_capacity)
+            Logger::fatal(
+                SLOT_MAP_LOG, "Capacity of ", max_capacity, " objects exceeded."
+            );
+        index = (uint32) _slots.size();
+        _slots.push_back({ no_slot, 1 });
+    } else {
+        _free_slot = _slots[index].position;
+    }
+
+    _objects.emplace_back(std::forward<Args>(args)...);
+    _object_slots.push_back(index);
+    _slots[index].position = (uint32) _objects.size() - 1;
+    return ObjectHandle(index, _slots[index].generation);
+}
+
+template<typename T>
+bool SlotMap<T>::erase(const ObjectHandle handle) {
+    if (!is_valid(handle)) return false;
+
+    // Move the last object into the erased one's place
+    const uint32 index    = handle.index();
+    const uint32 position = _slots[index].position;
+    const uint32 last     = (uint32) _objects.size() - 1;
+    if (position != last) {
+        _objects[position]                       = std::move(_objects[last]);
+        _object_slots[position]                  = _object_slots[last];
+        _slots[_object_slots[position]].position = position;
+    }
+    _objects.pop_back();
+    _object_slots.pop_back();
+
+    // Invalidate remaining handles, skipping 0 so that no handle is ever null
+    uint32 generation =
+        (_slots[index].generation + 1) & ObjectHandle::generation_mask;
+    if (generation == 0) generation = 1;
+    _slots[index].generation = generation;
+    _slots[index].position   = _free_slot;
+    _free_slot               = index;
+    return true;
+}
+
+template<typename T>
+void SlotMap<T>::clear() {
+    while (!_objects.empty()) {
+        const uint32 index = _object_slots.back();
+        erase(ObjectHandle(index, _slots[index].generation));
+    }
+}
+
+template<typename T>
+template<typename Function>
+void SlotMap<T>::for_each(Function function) {
+    for (uint32 i = 0; i < _objects.size(); i++) {
+        const uint32 index = _object_slots[i];
+        function(ObjectHandle(index, _slots[index].generation), _objects[i]);
+    }
+}
@@ -0,0 +1,189 @@
+#pragma once
+
+#include "memory_system.hpp"
+
+#include <algorithm>
+#include <initializer_list>
+#include <new>
+#include <utility>
+
+/**
+ * @brief Vector which stores up to N elements inline and only allocates once
+ * it grows past them. Lists which are usually short (stage lists, image
+ * infos) then never touch the allocator.
+ *
+ * @tparam Tp Type of element
+ * @tparam N Number of elements stored inline
+ */
+template<typename Tp, uint64 N>
+class SmallVector {
+    static_assert(
+        N > 0, "Small vector must store at least one element inline."
+    );
+
+  public:
+    typedef Tp        value_type;
+    typedef Tp*       iterator;
+    typedef const Tp* const_iterator;
+    typedef Tp&       reference;
+    typedef const Tp& const_reference;
+    typedef uint64    size_type;
+
+    /// @brief Construct a new Small Vector object. Spilled elements are
+    /// allocated with MemoryTag::Array.
+    SmallVector() : _tag(MemoryTag::Array) {}
+    /**
+     * @brief Construct a new Small Vector object
+     *
+     * @param tag Memory tag used once elements spill to the heap
+     */
+    explicit SmallVector(const MemoryTag tag) : _tag(tag) {}
+    SmallVector(std::initializer_list<Tp> list) : SmallVector() {
+        reserve(list.size());
+        for (const auto& value : list)
+            push_back(value);
+    }
+    ~SmallVector() {
+        clear();
+        release_heap();
+    }
+
+    SmallVector(const SmallVector& other) : _tag(other._tag) {
+        reserve(other._size);
+        for (const auto& value : other)
+            push_back(value);
+    }
+    SmallVector(SmallVector&& other) noexcept : _tag(other._tag) {
+        move_from(std::move(other));
+    }
+    SmallVector& operator=(const SmallVector& other) {
+        if (this == &other) return *this;
+        clear();
+        reserve(other._size);
+        for (const auto& value : other)
+            push_back(value);
+        return *this;
+    }
+    SmallVector& operator=(SmallVector&& other) noexcept {
+        if (this == &other) return *this;
+        clear();
+        release_heap();
+        _tag = other._tag;
+        move_from(std::move(other));
+        return *this;
+    }
+
+    // Iterators
+    iterator       begin() { return _data; }
+    iterator       end() { return _data + _size; }
+    const_iterator begin() const { return _data; }
+    const_iterator end() const { return _data + _size; }
+
+    // Access
+    Tp*       data() { return _data; }
+    const Tp* data() const { return _data; }
+    Tp&       operator[](const size_type index) { return _data[index]; }
+    const Tp& operator[](const size_type index) const { return _data[index]; }
+    Tp&       front() { return _data[0]; }
+    const Tp& front() const { return _data[0]; }
+    Tp&       back() { return _data[_size - 1]; }
+    const Tp& back() const { return _data[_size - 1]; }
+
+    // Capacity
+    size_type size() const { return _size; }
+    bool      empty() const { return _size == 0; }
+    size_type capacity() const { return _capacity; }
+    /// @brief True while elements are stored inline
+    bool      is_inline() const { return _data == inline_data(); }
+    void      reserve(const size_type count) {
+        if (count > _capacity) grow(count);
+    }
+
+    // Modifiers
+    void push_back(const Tp& value) { emplace_back(value); }
+    void push_back(Tp&& value) { emplace_back(std::move(value)); }
+    template<typename... Args>
+    Tp& emplace_back(Args&&... args) {
+        if (_size < _capacity) {
+            auto element =
+                ::new (_data + _size) Tp(std::forward<Args>(args)...);
+            _size++;
+            return *element;
+        }
+
+        // New element is constructed before the old ones are moved, as args
+        // might reference one of them
+        const auto capacity = _capacity * 2;
+        const auto data     = allocate(capacity);
+        auto element = ::new (data + _size) Tp(std::forward<Args>(args)...);
+        relocate(data, capacity);
+        _size++;
+        return *element;
+    }
+    void pop_back() {
+        _size--;
+        _data[_size].~Tp();
+    }
+    /// @brief Resize to count elements, new elements are value initialized
+    void resize(const size_type count) {
+        reserve(count);
+        while (_size > count)
+            pop_back();
+        while (_size < count)
+            emplace_back();
+    }
+    /// @brief Destroy all elements. Heap storage (if any) is kept for reuse.
+    void clear() {
+        while (_size > 0)
+            pop_back();
+    }
+
+  private:
+    alignas(Tp) byte _inline[N * sizeof(Tp)];
+    Tp*              _data     = inline_data();
+    size_type        _size     = 0;
+    size_type        _capacity = N;
+    MemoryTag        _tag;
+
+    Tp*       inline_data() { return (Tp*) _inline; }
+    const Tp* inline_data() const { return (const Tp*) _inline; }
+
+    void grow(const size_type min_capacity) {
+        const auto capacity = std::max(min_capacity, _capacity * 2);
+        relocate(allocate(capacity), capacity);
+    }
+    Tp* allocate(const size_type capacity) {
+        return (Tp*) operator new(capacity * sizeof(Tp), _tag);
+    }
+    // Move elements to new storage & release the old one
+    void relocate(Tp* const data, const size_type capacity) {
+        for (size_type i = 0; i < _size; i++) {
+            ::new (data + i) Tp(std::move(_data[i]));
+            _data[i].~Tp();
+        }
+        release_heap();
+        _data     = data;
+        _capacity = capacity;
+    }
+    void release_heap() {
+        if (!is_inline()) operator delete(_data);
+        _data     = inline_data();
+        _capacity = N;
+    }
+    // Expects this to be empty & inline
+    void move_from(SmallVector&& other) {
+        if (other.is_inline()) {
+            for (auto& value : other)
+                push_back(std::move(value));
+            other.clear();
+            return;
+        }
+        // Heap storage is taken over
+        _data           = other._data;
+        _size           = other._size;
+        _capacity       = other._capacity;
+        other._data     = other.inline_data();
+        other._size     = 0;
+        other._capacity = N;
+    }
+};
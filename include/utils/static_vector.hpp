@@ -0,0 +1,114 @@
+#pragma once
+
+#include "logger.hpp"
+
+#include <initializer_list>
+#include <new>
+#include <utility>
+
+#define STATIC_VECTOR_LOG "StaticVector :: "
+
+/**
+ * @brief Vector with a fixed capacity of N elements, stored inline. Never
+ * allocates, so it's meant for short lists built & dropped every frame (e.g.
+ * descriptor writes). Exceeding the capacity is a fatal error.
+ *
+ * @tparam Tp Type of element
+ * @tparam N Capacity
+ */
+template<typename Tp, uint64 N>
+class StaticVector {
+  public:
+    typedef Tp        value_type;
+    typedef Tp*       iterator;
+    typedef const Tp* const_iterator;
+    typedef Tp&       reference;
+    typedef const Tp& const_reference;
+    typedef uint64    size_type;
+
+    StaticVector() {}
+    StaticVector(std::initializer_list<Tp> list) {
+        for (const auto& value : list)
+            push_back(value);
+    }
+    ~StaticVector() { clear(); }
+
+    StaticVector(const StaticVector& other) {
+        for (const auto& value : other)
+            push_back(value);
+    }
+    StaticVector(StaticVector&& other) {
+        for (auto& value : other)
+            push_back(std::move(value));
+        other.clear();
+    }
+    StaticVector& operator=(const StaticVector& other) {
+        if (this == &other) return *this;
+        clear();
+        for (const auto& value : other)
+            push_back(value);
+        return *this;
+    }
+    StaticVector& operator=(StaticVector&& other) {
+        if (this == &other) return *this;
+        clear();
+        for (auto& value : other)
+            push_back(std::move(value));
+        other.clear();
+        return *this;
+    }
+
+    // Iterators
+    iterator       begin() { return data(); }
+    iterator       end() { return data() + _size; }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + _size; }
+
+    // Access
+    Tp*       data() { return (Tp*) _storage; }
+    const Tp* data() const { return (const Tp*) _storage; }
+    Tp&       operator[](const size_type index) { return data()[index]; }
+    const Tp& operator[](const size_type index) const { return data()[index]; }
+    Tp&       front() { return data()[0]; }
+    const Tp& front() const { return data()[0]; }
+    Tp&       back() { return data()[_size - 1]; }
+    const Tp& back() const { return data()[_size - 1]; }
+
+    // Capacity
+    size_type        size() const { return _size; }
+    bool             empty() const { return _size == 0; }
+    static size_type capacity() { return N; }
+
+    // Modifiers
+    void push_back(const Tp& value) { emplace_back(value); }
+    void push_back(Tp&& value) { emplace_back(std::move(value)); }
+    template<typename... Args>
+    Tp& emplace_back(Args&&... args) {
+        if (_size == N)
+            Logger::fatal(
+                STATIC_VECTOR_LOG, "Capacity of ", N, " elements exceeded."
+            );
+        auto element = ::new (data() + _size) Tp(std::forward<Args>(args)...);
+        _size++;
+        return *element;
+    }
+    void pop_back() {
+        _size--;
+        data()[_size].~Tp();
+    }
+    /// @brief Resize to count elements, new elements are value initialized
+    void resize(const size_type count) {
+        while (_size > count)
+            pop_back();
+        while (_size < count)
+            emplace_back();
+    }
+    void clear() {
+        while (_size > 0)
+            pop_back();
+    }
+
+  private:
+    alignas(Tp) byte _storage[N * sizeof(Tp)];
+    size_type        _size = 0;
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 #include "defines.hpp"
 #include "result.hpp"
@@ -18,6 +19,28 @@ template<typename T>
 string to_string(const Property<T>& in);
 } // namespace std
 
+/**
+ * @brief Non-owning view into a character sequence. Never allocates, so it's
+ * preferred over String for read-only parameters which are only inspected or
+ * hashed.
+ */
+class StringView : public std::string_view {
+  public:
+    using std::string_view::string_view;
+    constexpr StringView() noexcept = default;
+    constexpr StringView(const std::string_view view) noexcept
+        : std::string_view(view) {}
+    StringView(const std::string& str) noexcept : std::string_view(str) {}
+
+    // Comparison
+    /**
+     *  @brief  Compare two strings; case insensitive. Doesn't allocate.
+     *  @param other  String to compare against.
+     *  @return  Integer < 0, 0, or > 0.
+     */
+    int32 compare_ci(const StringView other) const noexcept;
+};
+
 class String : public std::string {
   public:
     using std::string::string;
@@ -67,7 +90,7 @@ class String : public std::string {
      * result of the comparison is nonzero returns it, otherwise the shorter one
      * is ordered first.
      */
-    int32 compare_ci(const String& other) const;
+    int32 compare_ci(const StringView other) const;
 
     // Split
     /**
@@ -204,4 +227,8 @@ void String::add_to_string<std::string>(
 template<>
 void String::add_to_string<String>(
     String& out_string, String component
+) noexcept;
+template<>
+void String::add_to_string<StringView>(
+    String& out_string, StringView component
 ) noexcept;
\ No newline at end of file
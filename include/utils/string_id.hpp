@@ -0,0 +1,95 @@
+#pragma once
+
+#include "string.hpp"
+
+/**
+ * @brief Immutable string identifier. Only a case insensitive 64-bit hash of
+ * the string is kept, so copies, comparisons & use as a map key are integer
+ * operations without any heap traffic. The hash is computed once, on
+ * construction (at compile time for constant expressions).
+ *
+ * Strings registered with intern can be retrieved back with str, which is
+ * meant for names & logging. Interning also reports hash collisions.
+ */
+class StringId {
+  public:
+    /// @brief Construct an empty String Id object
+    constexpr StringId() noexcept = default;
+    /// @brief Construct a new String Id object from the given string
+    constexpr StringId(const StringView name) noexcept : _value(hash(name)) {}
+    /// @brief Construct a new String Id object from the given string
+    constexpr StringId(const char* const name) noexcept
+        : StringId(StringView(name)) {}
+    /// @brief Construct a new String Id object from the given string
+    StringId(const String& name) noexcept : StringId(StringView(name)) {}
+
+    /// @brief Hash value
+    constexpr uint64 value() const noexcept { return _value; }
+    /// @brief True if constructed from a string
+    constexpr bool   is_valid() const noexcept { return _value != 0; }
+
+    /**
+     * @brief Get the string this id was created from. Thread safe.
+     *
+     * @returns Interned string, or empty string if the id was never interned
+     */
+    const String& str() const;
+
+    /**
+     * @brief Create an id and remember its string, so it can be retrieved by
+     * str. Should be done once per name (e.g. on resource registration), as
+     * interning takes a lock. Thread safe.
+     *
+     * @param name String identified
+     * @returns String id of name
+     */
+    static StringId intern(const StringView name);
+
+    /**
+     * @brief Case insensitive 64-bit FNV-1a hash of a string
+     *
+     * @param name Hashed string
+     * @returns Hash value, never 0
+     */
+    static constexpr uint64 hash(const StringView name) noexcept {
+        uint64 hash = 0xCBF29CE484222325;
+        for (const char c : name) {
+            // ASCII case folding
+            hash ^= (uint8) (c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+            hash *= 0x100000001B3;
+        }
+        return hash == 0 ? 1 : hash;
+    }
+
+    constexpr bool operator==(const StringId other) const noexcept {
+        return _value == other._value;
+    }
+    constexpr bool operator!=(const StringId other) const noexcept {
+        return _value != other._value;
+    }
+
+  private:
+    uint64 _value = 0;
+};
+
+/**
+ * @brief String id literal, e.g. "projection"_uid. Hash is computed at compile
+ * time when used in a constant expression.
+ */
+constexpr StringId operator""_uid(
+    const char* const name, const std::size_t length
+) noexcept {
+    return StringId(StringView(name, length));
+}
+
+namespace std {
+template<>
+struct hash<StringId> {
+    size_t operator()(const StringId id) const noexcept { return id.value(); }
+};
+} // namespace std
+
+template<>
+void String::add_to_string<StringId>(
+    String& out_string, StringId component
+) noexcept;
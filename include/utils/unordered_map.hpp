@@ -38,9 +38,14 @@ class UnorderedMap
     typedef std::unordered_map<_Key, _Tp, _Hash, _Pred, allocator_type>
                                                         _base_class;
     typedef std::unordered_map<_Key, _Tp, _Hash, _Pred> default_version;
+#ifdef _GLIBCXX_DEBUG
     typedef std::__cxx1998::
         __umap_hashtable<_Key, _Tp, _Hash, _Pred, allocator_type>
                                            _Hashtable;
+#else
+    typedef std::__umap_hashtable<_Key, _Tp, _Hash, _Pred, allocator_type>
+                                           _Hashtable;
+#endif
     typedef typename _Hashtable::hasher    hasher;
     typedef typename _Hashtable::key_equal key_equal;
 
@@ -30,7 +30,11 @@ class Vector : public std::vector<Tp, TAllocator<Tp>> {
     typedef std::vector<Tp, TAllocator<Tp>>                    _base_class;
     typedef std::vector<Tp>                                    default_version;
     typedef TAllocator<Tp>                                     t_allocator_type;
+#ifdef _GLIBCXX_DEBUG
     typedef std::__cxx1998::_Vector_base<Tp, t_allocator_type> _super_base;
+#else
+    typedef std::_Vector_base<Tp, t_allocator_type> _super_base;
+#endif
     typedef typename _super_base::_Tp_alloc_type               _Tp_t_alloc_type;
     typedef __gnu_cxx::__alloc_traits<_Tp_t_alloc_type>        _TAlloc_traits;
 
@@ -39,12 +43,9 @@ class Vector : public std::vector<Tp, TAllocator<Tp>> {
     using std::vector<Tp, TAllocator<Tp>>::reserve;
 
     /**
-     *  @brief  Creates a %vector with no elements.
+     *  @brief  Creates a %vector with no elements. Doesn't allocate.
      */
-    Vector() : _base_class(t_allocator_type(MemoryTag::Array)) {
-        // Reserve at least 16 bytes
-        reserve(15 / sizeof(Tp) + 1);
-    }
+    Vector() : _base_class(t_allocator_type(MemoryTag::Array)) {}
 
     /**
      *  @brief  Creates a %vector with default constructed elements.
@@ -21,6 +21,10 @@ int main(int, char**) {
 
     app->run();
 
+#ifndef NDEBUG
+    Logger::debug("\n", MemorySystem::get_report());
+#endif
+
     delete app;
     MemorySystem::reset_memory(MemoryTag::Application);
 
@@ -1,7 +1,12 @@
 #include "platform/platform.hpp"
 #if PLATFORM == LINUX
 
+#    include <cerrno>
+#    include <fcntl.h>
 #    include <iostream>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
 
 #    if _POSIX_C_SOURCE >= 199309L
 #        include <time.h>
@@ -31,6 +36,68 @@ void Platform::sleep(uint64 ms) {
 #    endif
 }
 
+// ////// //
+// Memory //
+// ////// //
+
+void* Platform::Memory::reserve(const uint64 size) {
+    // No swap space is reserved, pages get committed on first access
+    void* ptr = mmap(
+        nullptr,
+        size,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+        -1,
+        0
+    );
+    if (ptr == MAP_FAILED) return nullptr;
+    return ptr;
+}
+
+bool Platform::Memory::commit(void* ptr, const uint64 size) {
+    // Committed on first access
+    return true;
+}
+
+void Platform::Memory::decommit(void* ptr, const uint64 size) {
+    madvise(ptr, size, MADV_DONTNEED);
+}
+
+void Platform::Memory::release(void* ptr, const uint64 size) {
+    munmap(ptr, size);
+}
+
+uint64 Platform::Memory::get_page_size() {
+    static const uint64 page_size = sysconf(_SC_PAGESIZE);
+    return page_size;
+}
+
+const void* Platform::Memory::map_file(const char* file_path, uint64& size) {
+    int fd = open(file_path, O_RDONLY);
+    if (fd < 0) return nullptr;
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+        close(fd);
+        return nullptr;
+    }
+    size = file_stat.st_size;
+
+    // Mapping stays valid after the descriptor is closed
+    void* ptr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED) return nullptr;
+
+    // Files are read front to back, start reading ahead right away
+    madvise(ptr, size, MADV_SEQUENTIAL);
+    madvise(ptr, size, MADV_WILLNEED);
+    return ptr;
+}
+
+void Platform::Memory::unmap_file(const void* ptr, const uint64 size) {
+    munmap((void*) ptr, size);
+}
+
 // /////// //
 // Console //
 // /////// //
@@ -39,10 +106,33 @@ Platform::Console::Console() {}
 Platform::Console::~Console() {}
 
 void Platform::Console::write(std::string message, uint32 kind, bool new_line) {
-    const char* color_string[] = { "0",    "0;41", "1;31", "1;33",
-                                   "1;32", "1;34", "1;30" };
-    std::cout << "\033[" << color_string[kind] << "m" << message << "\033[0m";
+    std::cout << get_style(kind) << message << get_default_style();
     if (new_line) std::cout << std::endl;
 }
 
+void Platform::Console::write_raw(const char* const text, const uint64 length) {
+    // Keep ordering with output already buffered by write
+    std::cout.flush();
+    uint64 written = 0;
+    while (written < length) {
+        const auto result =
+            ::write(STDOUT_FILENO, text + written, length - written);
+        if (result < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        written += result;
+    }
+}
+
+const char* Platform::Console::get_style(const uint32 kind) {
+    static const char* const styles[] = {
+        "\033[0m",    "\033[0;41m", "\033[1;31m", "\033[1;33m",
+        "\033[1;32m", "\033[1;34m", "\033[1;30m"
+    };
+    return styles[kind];
+}
+
+const char* Platform::Console::get_default_style() { return "\033[0m"; }
+
 #endif
\ No newline at end of file
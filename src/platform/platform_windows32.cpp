@@ -1,8 +1,70 @@
 #include "platform/platform.hpp"
 #if PLATFORM == WINDOWS32
 
+#    include <windows.h>
+
 Platform::Platform() {}
 
 Platform::~Platform() {}
 
+// ////// //
+// Memory //
+// ////// //
+
+void* Platform::Memory::reserve(const uint64 size) {
+    // Address space only, allocators commit pages explicitly before use
+    return VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+}
+
+bool Platform::Memory::commit(void* ptr, const uint64 size) {
+    return VirtualAlloc(ptr, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+}
+
+void Platform::Memory::decommit(void* ptr, const uint64 size) {
+    VirtualFree(ptr, size, MEM_DECOMMIT);
+}
+
+void Platform::Memory::release(void* ptr, const uint64 size) {
+    VirtualFree(ptr, 0, MEM_RELEASE);
+}
+
+uint64 Platform::Memory::get_page_size() {
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+    return system_info.dwPageSize;
+}
+
+const void* Platform::Memory::map_file(const char* file_path, uint64& size) {
+    HANDLE file = CreateFileA(
+        file_path,
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+        nullptr
+    );
+    if (file == INVALID_HANDLE_VALUE) return nullptr;
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+        CloseHandle(file);
+        return nullptr;
+    }
+    size = file_size.QuadPart;
+
+    // View stays valid after both handles are closed
+    HANDLE mapping =
+        CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) return nullptr;
+    void* ptr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    return ptr;
+}
+
+void Platform::Memory::unmap_file(const void* ptr, const uint64 size) {
+    UnmapViewOfFile(ptr);
+}
+
 #endif
\ No newline at end of file
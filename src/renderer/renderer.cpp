@@ -83,6 +83,7 @@ Result<void, RuntimeError> Renderer::draw_frame(const float32 delta_time) {
     // === END FRAME ===
     result = _backend->end_frame(delta_time);
     _backend->increment_frame_number();
+    MemorySystem::next_frame();
 
     if (result.has_error()) {
         // TODO: error handling
@@ -92,6 +93,9 @@ Result<void, RuntimeError> Renderer::draw_frame(const float32 delta_time) {
     return {};
 }
 
+bool Renderer::supports_image_format(const ImageFormat format) const {
+    return _backend->supports_image_format(format);
+}
 void Renderer::create_texture(Texture* texture, const byte* const data) {
     Logger::trace(RENDERER_LOG, "Creating texture.");
     _backend->create_texture(texture, data);
@@ -102,6 +106,21 @@ void Renderer::destroy_texture(Texture* texture) {
     Logger::trace(RENDERER_LOG, "Texture destroyed.");
 }
 
+UploadTicket Renderer::get_upload_ticket() const {
+    return _backend->get_upload_ticket();
+}
+bool Renderer::is_upload_complete(const UploadTicket ticket) const {
+    return _backend->is_upload_complete(ticket);
+}
+void Renderer::wait_for_upload(const UploadTicket ticket) {
+    _backend->wait_for_upload(ticket);
+}
+
+void Renderer::begin_upload_batch() { _backend->begin_upload_batch(); }
+UploadBatchStats Renderer::end_upload_batch() {
+    return _backend->end_upload_batch();
+}
+
 void Renderer::destroy_geometry(Geometry* geometry) {
     _backend->destroy_geometry(geometry);
     Logger::trace(RENDERER_LOG, "Geometry destroyed.");
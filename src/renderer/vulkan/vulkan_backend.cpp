@@ -2,6 +2,8 @@
 
 #include "renderer/vulkan/vulkan_framebuffer.hpp"
 
+#include <algorithm> // sort, lower_bound
+
 VKAPI_ATTR VkBool32 VKAPI_CALL debug_callback_function(
     VkDebugUtilsMessageSeverityFlagBitsEXT      message_severity,
     VkDebugUtilsMessageTypeFlagsEXT             message_type,
@@ -70,6 +72,19 @@ VulkanBackend::VulkanBackend(
         _device->queue_family_indices.graphics_family.value()
     );
 
+    // Create staging ring
+    _staging_buffer = new (MemoryTag::GPUBuffer) VulkanStagingBuffer(
+        _device, _allocator, _command_pool, VulkanSettings::staging_buffer_size
+    );
+
+    // Create deferred destruction queue
+    _deletion_queue = new (MemoryTag::Renderer)
+        VulkanDeletionQueue(_device, _allocator, _staging_buffer);
+
+    // Create sampler cache
+    _sampler_cache =
+        new (MemoryTag::Renderer) VulkanSamplerCache(_device, _allocator);
+
     // TODO: TEMP VERTEX & INDEX BUFFER CODE
     create_buffers();
 
@@ -84,6 +99,12 @@ VulkanBackend::VulkanBackend(
 VulkanBackend::~VulkanBackend() {
     _device->handle().waitIdle();
 
+    // Deferred destruction queue, device is idle
+    delete _deletion_queue;
+
+    // Samplers
+    delete _sampler_cache;
+
     // Swapchain
     delete _swapchain;
 
@@ -91,6 +112,9 @@ VulkanBackend::~VulkanBackend() {
     delete _index_buffer;
     delete _vertex_buffer;
 
+    // Staging ring
+    delete _staging_buffer;
+
     // Render pass
     delete _ui_render_pass;
     delete _main_render_pass;
@@ -153,6 +177,13 @@ Result<void, RuntimeError> VulkanBackend::begin_frame(const float32 delta_time
         Logger::fatal(RENDERER_VULKAN_LOG, e.what());
     }
 
+    // GPU is done with this frame, so its temporary memory can be reused
+    MemorySystem::begin_frame(_current_frame);
+    _vertex_buffer->begin_frame();
+    _index_buffer->begin_frame();
+    _staging_buffer->reclaim();
+    _deletion_queue->release(_frame_numbers[_current_frame]);
+
     // Compute next swapchain image index
     _swapchain->compute_next_image_index(
         _semaphores_image_available[_current_frame]
@@ -175,6 +206,9 @@ Result<void, RuntimeError> VulkanBackend::begin_frame(const float32 delta_time
 
     command_buffer->begin(begin_info);
 
+    // Compact geometry buffers before any draws use them
+    defragment_geometry_buffers(*command_buffer);
+
     // Set dynamic states
     // Viewport
     vk::Viewport viewport {};
@@ -202,6 +236,9 @@ Result<void, RuntimeError> VulkanBackend::end_frame(const float32 delta_time) {
     auto command_buffer = _command_buffer->handle;
     command_buffer->end();
 
+    // Submit uploads made since the last frame, this frame depends on them
+    _staging_buffer->submit();
+
     // Submit command buffer
     vk::PipelineStageFlags wait_stages[] = {
         vk::PipelineStageFlagBits::eColorAttachmentOutput
@@ -229,6 +266,9 @@ Result<void, RuntimeError> VulkanBackend::end_frame(const float32 delta_time) {
         Logger::fatal(RENDERER_VULKAN_LOG, e.what());
     }
 
+    // Resources released from now on might still be used by this frame
+    _frame_numbers[_current_frame] = _deletion_queue->end_frame();
+
     // Present swapchain
     _swapchain->present(signal_semaphores);
 
@@ -282,27 +322,30 @@ void VulkanBackend::draw_geometry(const GeometryRenderData data) {
     // Check if geometry data is valid
     if (!data.geometry || !data.geometry->internal_id.has_value()) return;
 
-    auto buffer_data    = _geometries[data.geometry->internal_id.value()];
+    const auto buffer_data = _geometries.get(
+        ObjectHandle((uint32) data.geometry->internal_id.value())
+    );
+    if (buffer_data == nullptr) return;
     auto command_buffer = _command_buffer->handle;
 
     // Bind vertex buffer
     std::array<vk::Buffer, 1>     vertex_buffers = { _vertex_buffer->handle };
-    std::array<vk::DeviceSize, 1> offsets = { buffer_data.vertex_offset };
+    std::array<vk::DeviceSize, 1> offsets = { buffer_data->vertex_offset };
     command_buffer->bindVertexBuffers(0, vertex_buffers, offsets);
 
     // Issue draw command
-    if (buffer_data.index_count > 0) {
+    if (buffer_data->index_count > 0) {
         // Bind index buffer
         command_buffer->bindIndexBuffer(
             _index_buffer->handle,
-            buffer_data.index_offset,
+            buffer_data->index_offset,
             vk::IndexType::eUint32 // TODO: Might need to be configurable
         );
         // Draw command indexed
-        command_buffer->drawIndexed(buffer_data.index_count, 1, 0, 0, 0);
+        command_buffer->drawIndexed(buffer_data->index_count, 1, 0, 0, 0);
     } else {
         // Draw command non-indexed
-        command_buffer->draw(buffer_data.vertex_count, 1, 0, 0);
+        command_buffer->draw(buffer_data->vertex_count, 1, 0, 0);
     }
 }
 
@@ -310,27 +353,16 @@ void VulkanBackend::draw_geometry(const GeometryRenderData data) {
 void VulkanBackend::create_texture(Texture* texture, const byte* const data) {
     Logger::trace(RENDERER_VULKAN_LOG, "Creating texture.");
 
-    // Calculate mip levels
-    auto mip_levels =
-        std::floor(std::log2(std::max(texture->width(), texture->height()))) +
-        1;
+    // Mip levels are generated on the CPU, data holds all of them
+    const uint32 mip_levels = texture->mip_level_count;
 
     // Image format
-    // NOTE: assumes 8 bits per channel
-    auto texture_format = vk::Format::eR8G8B8A8Srgb;
-
-    // Create staging buffer
-    auto staging_buffer =
-        new (MemoryTag::Temp) VulkanBuffer(_device, _allocator);
-    staging_buffer->create(
-        texture->total_size,
-        vk::BufferUsageFlagBits::eTransferSrc,
-        vk::MemoryPropertyFlagBits::eHostVisible |
-            vk::MemoryPropertyFlagBits::eHostCoherent
-    );
-
-    // Fill created memory with data
-    staging_buffer->load_data(data, 0, texture->total_size);
+    vk::Format texture_format;
+    switch (texture->format()) {
+    case ImageFormat::BC1: texture_format = vk::Format::eBc1RgbSrgbBlock; break;
+    case ImageFormat::BC3: texture_format = vk::Format::eBc3SrgbBlock; break;
+    default: texture_format = vk::Format::eR8G8B8A8Srgb; break;
+    }
 
     // Create device side image
     // NOTE: Lots of assumptions here
@@ -343,61 +375,41 @@ void VulkanBackend::create_texture(Texture* texture, const byte* const data) {
         vk::SampleCountFlagBits::e1,
         texture_format,
         vk::ImageTiling::eOptimal,
-        vk::ImageUsageFlagBits::eTransferSrc |
-            vk::ImageUsageFlagBits::eTransferDst |
-            vk::ImageUsageFlagBits::eSampled,
+        vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled,
         vk::MemoryPropertyFlagBits::eDeviceLocal,
         vk::ImageAspectFlagBits::eColor
     );
 
-    auto command_buffer = _command_pool->begin_single_time_commands();
-
     // Transition image to a layout optimal for data transfer
     auto result = texture_image->transition_image_layout(
-        command_buffer,
+        _staging_buffer->transfer_command_buffer(),
         vk::ImageLayout::eUndefined,
         vk::ImageLayout::eTransferDstOptimal
     );
     if (result.has_error())
         Logger::fatal(RENDERER_VULKAN_LOG, result.error().what());
 
-    // Copy buffer data to image
-    staging_buffer->copy_data_to_image(command_buffer, texture_image);
-
-    // Generate mipmaps, this also transitions image to a layout optimal for
-    // sampling
-    texture_image->generate_mipmaps(command_buffer);
-    _command_pool->end_single_time_commands(command_buffer);
-
-    // Cleanup
-    delete staging_buffer;
-
-    // TODO: CREATE SAMPLER
-    vk::SamplerCreateInfo sampler_info {};
-    sampler_info.setAddressModeU(vk::SamplerAddressMode::eRepeat);
-    sampler_info.setAddressModeV(vk::SamplerAddressMode::eRepeat);
-    sampler_info.setAddressModeW(vk::SamplerAddressMode::eRepeat);
-    sampler_info.setAnisotropyEnable(true);
-    sampler_info.setMaxAnisotropy(_device->info().max_sampler_anisotropy);
-    sampler_info.setBorderColor(vk::BorderColor::eIntOpaqueBlack);
-    sampler_info.setUnnormalizedCoordinates(false);
-    sampler_info.setCompareEnable(false);
-    sampler_info.setCompareOp(vk::CompareOp::eAlways);
-    // Mipmap settings
-    sampler_info.setMagFilter(vk::Filter::eLinear);
-    sampler_info.setMinFilter(vk::Filter::eLinear);
-    sampler_info.setMipmapMode(vk::SamplerMipmapMode::eLinear);
-    sampler_info.setMipLodBias(0.0f);
-    sampler_info.setMinLod(0.0f);
-    sampler_info.setMaxLod(static_cast<float32>(mip_levels));
-
-    vk::Sampler texture_sampler;
-    try {
-        texture_sampler =
-            _device->handle().createSampler(sampler_info, _allocator);
-    } catch (vk::SystemError e) {
-        Logger::fatal(RENDERER_VULKAN_LOG, e.what());
-    }
+    // Copy data (all mip levels) to image
+    _staging_buffer->upload_to_image(
+        data,
+        Image::get_block_size(texture->format),
+        Image::get_block_extent(texture->format),
+        texture_image
+    );
+
+    // Transition image to a layout optimal for sampling, once the graphics
+    // queue owns it
+    auto sampling_result = texture_image->transition_image_layout(
+        _staging_buffer->graphics_command_buffer(),
+        vk::ImageLayout::eTransferDstOptimal,
+        vk::ImageLayout::eShaderReadOnlyOptimal
+    );
+    if (sampling_result.has_error())
+        Logger::fatal(RENDERER_VULKAN_LOG, sampling_result.error().what());
+
+    // Get sampler, shared by all textures with the same sampler state
+    // TODO: Sampler state should be configurable per texture
+    auto texture_sampler = _sampler_cache->get(VulkanSamplerState {});
 
     // Save internal data
     VulkanTextureData* vulkan_texture_data =
@@ -413,13 +425,76 @@ void VulkanBackend::destroy_texture(Texture* texture) {
     if (texture->internal_data == nullptr) return;
     auto data = reinterpret_cast<VulkanTextureData*>(texture->internal_data());
 
-    _device->handle().waitIdle();
-    if (data->image) delete data->image;
-    if (data->sampler) _device->handle().destroySampler(data->sampler);
+    // Frames in flight & pending uploads might still reference this image.
+    // Sampler is shared, it stays in the cache.
+    _deletion_queue->enqueue(data->image);
+    data->image   = nullptr;
+    data->sampler = nullptr;
 
     Logger::trace(RENDERER_VULKAN_LOG, "Texture destroyed.");
 }
 
+bool VulkanBackend::supports_image_format(const ImageFormat format) const {
+    switch (format) {
+    case ImageFormat::BC1:
+    case ImageFormat::BC3:
+        return _device->info().supports_texture_compression_bc;
+    default: return true;
+    }
+}
+
+// Uploads
+UploadTicket VulkanBackend::get_upload_ticket() const {
+    return _staging_buffer->get_ticket();
+}
+bool VulkanBackend::is_upload_complete(const UploadTicket ticket) const {
+    return _staging_buffer->is_complete(ticket);
+}
+void VulkanBackend::wait_for_upload(const UploadTicket ticket) {
+    _staging_buffer->wait(ticket);
+}
+
+void VulkanBackend::begin_upload_batch() {
+    if (_upload_batch_depth++ > 0) return;
+
+    _upload_batch_start_time = Platform::get_absolute_time();
+    _upload_batch_start_counters.bytes = _staging_buffer->get_uploaded_bytes();
+    _upload_batch_start_counters.submission_count =
+        _staging_buffer->get_submission_count();
+}
+UploadBatchStats VulkanBackend::end_upload_batch() {
+    if (_upload_batch_depth == 0)
+        Logger::fatal(
+            RENDERER_VULKAN_LOG, "Upload batch ended without being started."
+        );
+    if (--_upload_batch_depth > 0) return {};
+
+    // Everything since the start goes out as a single submission
+    _staging_buffer->submit();
+
+    const auto& start = _upload_batch_start_counters;
+    const auto  now   = Platform::get_absolute_time();
+
+    UploadBatchStats stats {};
+    stats.bytes = _staging_buffer->get_uploaded_bytes() - start.bytes;
+    stats.submission_count =
+        _staging_buffer->get_submission_count() - start.submission_count;
+    stats.wall_time = now - _upload_batch_start_time;
+    stats.ticket    = _staging_buffer->get_ticket();
+
+    Logger::trace(
+        RENDERER_VULKAN_LOG,
+        "Upload batch of ",
+        stats.bytes,
+        " bytes submitted in ",
+        stats.submission_count,
+        " submission(s), took ",
+        stats.wall_time * 1000.0,
+        " ms."
+    );
+    return stats;
+}
+
 // Geometry
 void VulkanBackend::create_geometry(
     Geometry*             geometry,
@@ -468,11 +543,11 @@ void VulkanBackend::destroy_geometry(Geometry* geometry) {
         return;
     }
 
-    auto& internal_data = _geometries[geometry->internal_id.value()];
-
-    // TODO: FREE VERTEX & INDEX DATA
-
-    _geometries.erase(geometry->internal_id.value());
+    const auto handle = ObjectHandle((uint32) geometry->internal_id.value());
+    const auto data   = _geometries.get(handle);
+    if (data != nullptr) release_geometry_data(*data);
+    _geometries.erase(handle);
+    geometry->internal_id.reset();
 }
 
 // Shader
@@ -648,11 +723,6 @@ void VulkanBackend::create_sync_objects() {
     Logger::trace(RENDERER_VULKAN_LOG, "All synchronization objects created.");
 }
 
-uint32 VulkanBackend::generate_geometry_id() {
-    static uint32 id = 0;
-    return id++;
-}
-
 void VulkanBackend::create_geometry_internal(
     Geometry*         geometry,
     const uint32      vertex_size,
@@ -680,31 +750,30 @@ void VulkanBackend::create_geometry_internal(
 
     VulkanGeometryData* internal_data = nullptr;
     if (is_reupload) {
-        internal_data          = &_geometries[geometry->internal_id.value()];
-        old_data.vertex_count  = internal_data->vertex_count;
-        old_data.vertex_size   = internal_data->vertex_size;
-        old_data.vertex_offset = internal_data->vertex_offset;
-        old_data.index_count   = internal_data->index_count;
-        old_data.index_size    = internal_data->index_size;
-        old_data.index_offset  = internal_data->index_offset;
+        internal_data = _geometries.get(
+            ObjectHandle((uint32) geometry->internal_id.value())
+        );
     } else {
-        uint id               = generate_geometry_id();
-        geometry->internal_id = id;
-        internal_data         = &_geometries[id];
+        const auto handle     = _geometries.insert();
+        geometry->internal_id = handle.value;
+        internal_data         = _geometries.get(handle);
     }
 
     if (internal_data == nullptr)
         Logger::fatal(
             RENDERER_VULKAN_LOG, "Geometry internal data somehow nullptr."
         );
+    if (is_reupload) old_data = *internal_data;
 
     // Upload vertex data
     vk::DeviceSize buffer_size   = vertex_size * vertex_count;
-    vk::DeviceSize buffer_offset = _vertex_buffer->allocate(buffer_size);
+    auto           allocation    = _vertex_buffer->allocate(buffer_size);
+    vk::DeviceSize buffer_offset = allocation.offset;
 
-    internal_data->vertex_count  = vertex_count;
-    internal_data->vertex_size   = vertex_size;
-    internal_data->vertex_offset = buffer_offset;
+    internal_data->vertex_count      = vertex_count;
+    internal_data->vertex_size       = vertex_size;
+    internal_data->vertex_offset     = allocation.offset;
+    internal_data->vertex_allocation = allocation.handle;
 
     upload_data_to_buffer(
         vertex_data, buffer_size, buffer_offset, _vertex_buffer
@@ -713,22 +782,20 @@ void VulkanBackend::create_geometry_internal(
     // Upload index data
     if (index_count > 0) {
         buffer_size   = index_size * index_count;
-        buffer_offset = _index_buffer->allocate(buffer_size);
+        allocation    = _index_buffer->allocate(buffer_size);
+        buffer_offset = allocation.offset;
 
-        internal_data->index_count  = index_count;
-        internal_data->index_size   = index_size;
-        internal_data->index_offset = buffer_offset;
+        internal_data->index_count      = index_count;
+        internal_data->index_size       = index_size;
+        internal_data->index_offset     = allocation.offset;
+        internal_data->index_allocation = allocation.handle;
 
         upload_data_to_buffer(
             index_data, buffer_size, buffer_offset, _index_buffer
         );
     }
 
-    if (is_reupload) {
-        _vertex_buffer->deallocate(old_data.vertex_offset);
-        if (old_data.index_count > 0)
-            _index_buffer->deallocate(old_data.index_offset);
-    }
+    if (is_reupload) release_geometry_data(old_data);
 }
 
 // /////////////////////////////// //
@@ -764,28 +831,37 @@ VKAPI_ATTR VkBool32 VKAPI_CALL debug_callback_function(
 
 /// TODO: TEMP CODE BELOW
 void VulkanBackend::create_buffers() {
-    // Create vertex buffer
-    // TODO: NOT LIKE THIS, values choosen arbitrarily
-    vk::DeviceSize vertex_buffer_size = sizeof(Vertex) * 1024 * 1024;
+    // Create vertex buffer (transfer source as well, for growth & compaction)
     _vertex_buffer =
         new (MemoryTag::GPUBuffer) VulkanManagedBuffer(_device, _allocator);
     _vertex_buffer->create(
-        vertex_buffer_size,
-        vk::BufferUsageFlagBits::eTransferDst |
+        VulkanSettings::vertex_buffer_initial_size,
+        vk::BufferUsageFlagBits::eTransferSrc |
+            vk::BufferUsageFlagBits::eTransferDst |
             vk::BufferUsageFlagBits::eVertexBuffer,
         vk::MemoryPropertyFlagBits::eDeviceLocal
     );
+    _vertex_buffer->enable_growth(
+        _staging_buffer,
+        VulkanSettings::geometry_buffer_growth_factor,
+        VulkanSettings::geometry_buffer_max_size
+    );
 
     // Create index buffer
-    vk::DeviceSize index_buffer_size = sizeof(uint32) * 1024 * 1024;
     _index_buffer =
         new (MemoryTag::GPUBuffer) VulkanManagedBuffer(_device, _allocator);
     _index_buffer->create(
-        index_buffer_size,
-        vk::BufferUsageFlagBits::eTransferDst |
+        VulkanSettings::index_buffer_initial_size,
+        vk::BufferUsageFlagBits::eTransferSrc |
+            vk::BufferUsageFlagBits::eTransferDst |
             vk::BufferUsageFlagBits::eIndexBuffer,
         vk::MemoryPropertyFlagBits::eDeviceLocal
     );
+    _index_buffer->enable_growth(
+        _staging_buffer,
+        VulkanSettings::geometry_buffer_growth_factor,
+        VulkanSettings::geometry_buffer_max_size
+    );
 }
 
 void VulkanBackend::upload_data_to_buffer(
@@ -794,26 +870,113 @@ void VulkanBackend::upload_data_to_buffer(
     vk::DeviceSize       offset,
     VulkanManagedBuffer* buffer
 ) {
-    // Create staging buffer
-    auto staging_buffer =
-        new (MemoryTag::Temp) VulkanBuffer(_device, _allocator);
-    staging_buffer->create(
-        size,
-        vk::BufferUsageFlagBits::eTransferSrc,
-        vk::MemoryPropertyFlagBits::eHostVisible |
-            vk::MemoryPropertyFlagBits::eHostCoherent
-    );
+    // Copy is recorded & submitted with the rest of the frame's uploads
+    _staging_buffer->upload_to_buffer(data, size, buffer, offset);
+}
 
-    // Fill created memory with data
-    staging_buffer->load_data(data, 0, size);
+/// @brief Find move of an allocation in moves sorted by source handle
+static const VulkanManagedBuffer::Move* find_move(
+    const Vector<VulkanManagedBuffer::Move>& moves, const uint32 handle
+) {
+    const auto move = std::lower_bound(
+        moves.begin(),
+        moves.end(),
+        handle,
+        [](const VulkanManagedBuffer::Move& move, const uint32 handle) {
+            return move.source_handle < handle;
+        }
+    );
+    if (move == moves.end() || move->source_handle != handle) return nullptr;
+    return &*move;
+}
 
-    auto command_buffer = _command_pool->begin_single_time_commands();
-    staging_buffer->copy_data_to_buffer(
-        command_buffer, buffer->handle, 0, offset, size
+void VulkanBackend::defragment_geometry_buffers(
+    const vk::CommandBuffer& command_buffer
+) {
+    auto& vertex_moves = _vertex_buffer_moves[_current_frame];
+    auto& index_moves  = _index_buffer_moves[_current_frame];
+
+    auto& vertex_releases = _vertex_buffer_releases[_current_frame];
+    auto& index_releases  = _index_buffer_releases[_current_frame];
+
+    // All frames recorded with the old offsets are done by now
+    for (const auto& move : vertex_moves)
+        _vertex_buffer->deallocate({ move.source_offset, move.source_handle });
+    for (const auto& move : index_moves)
+        _index_buffer->deallocate({ move.source_offset, move.source_handle });
+    for (const auto& allocation : vertex_releases)
+        _vertex_buffer->deallocate(allocation);
+    for (const auto& allocation : index_releases)
+        _index_buffer->deallocate(allocation);
+    vertex_moves.clear();
+    index_moves.clear();
+    vertex_releases.clear();
+    index_releases.clear();
+
+    // Move data
+    const auto vertex_stats = _vertex_buffer->get_fragmentation();
+    if (vertex_stats.fragmentation >
+        VulkanSettings::defragmentation_threshold)
+        vertex_moves = _vertex_buffer->defragment(
+            command_buffer, VulkanSettings::defragmentation_budget
+        );
+    const auto index_stats = _index_buffer->get_fragmentation();
+    if (index_stats.fragmentation > VulkanSettings::defragmentation_threshold)
+        index_moves = _index_buffer->defragment(
+            command_buffer, VulkanSettings::defragmentation_budget
+        );
+    if (vertex_moves.empty() && index_moves.empty()) return;
+
+    Logger::trace(
+        RENDERER_VULKAN_LOG,
+        "Defragmenting geometry buffers (fragmentation ",
+        vertex_stats.fragmentation,
+        " / ",
+        index_stats.fragmentation,
+        "), ",
+        vertex_moves.size() + index_moves.size(),
+        " allocations moved."
     );
-    _command_pool->end_single_time_commands(command_buffer);
 
-    // Cleanup
-    delete staging_buffer;
+    // Switch geometries to the new regions. Copies are ordered before all
+    // following draws by a barrier, so they can be used from this frame on.
+    auto by_source = [](const VulkanManagedBuffer::Move& a,
+                        const VulkanManagedBuffer::Move& b) {
+        return a.source_handle < b.source_handle;
+    };
+    std::sort(vertex_moves.begin(), vertex_moves.end(), by_source);
+    std::sort(index_moves.begin(), index_moves.end(), by_source);
+
+    for (auto& data : _geometries) {
+        const auto vertex_move =
+            find_move(vertex_moves, data.vertex_allocation);
+        if (vertex_move != nullptr) {
+            const auto moved = vertex_move->apply(
+                { data.vertex_offset, data.vertex_allocation }
+            );
+            data.vertex_offset     = moved.offset;
+            data.vertex_allocation = moved.handle;
+        }
+        if (data.index_count == 0) continue;
+        const auto index_move = find_move(index_moves, data.index_allocation);
+        if (index_move != nullptr) {
+            const auto moved = index_move->apply(
+                { data.index_offset, data.index_allocation }
+            );
+            data.index_offset     = moved.offset;
+            data.index_allocation = moved.handle;
+        }
+    }
+}
+
+void VulkanBackend::release_geometry_data(const VulkanGeometryData& data) {
+    // Frames in flight might still draw from these regions
+    _vertex_buffer_releases[_current_frame].push_back(
+        { data.vertex_offset, data.vertex_allocation }
+    );
+    if (data.index_count > 0)
+        _index_buffer_releases[_current_frame].push_back(
+            { data.index_offset, data.index_allocation }
+        );
 }
 // TODO: TEMP CODE END
\ No newline at end of file
@@ -4,7 +4,7 @@
 
 VulkanBuffer::~VulkanBuffer() {
     if (_handle) _device->handle().destroyBuffer(_handle, _allocator);
-    if (_memory) _device->handle().freeMemory(_memory, _allocator);
+    _device->memory_allocator()->free(_memory);
 
 #ifdef TRACE_FILE_VULKAN_BUFFER
     Logger::trace(RENDERER_VULKAN_LOG, "Buffer destroyed.");
@@ -36,7 +36,7 @@ void VulkanBuffer::create(
     _memory = allocate_buffer_memory(_handle, properties);
 
     // Bind allocated memory to the buffer if required
-    if (bind_on_create) _device->handle().bindBufferMemory(_handle, _memory, 0);
+    if (bind_on_create) bind(0);
 
 #ifdef TRACE_FILE_VULKAN_BUFFER
     Logger::trace(RENDERER_VULKAN_LOG, "Buffer created.");
@@ -44,7 +44,10 @@ void VulkanBuffer::create(
 }
 
 void VulkanBuffer::bind(const vk::DeviceSize offset) const {
-    if (_handle) _device->handle().bindBufferMemory(_handle, _memory, offset);
+    if (_handle)
+        _device->handle().bindBufferMemory(
+            _handle, _memory.memory, _memory.offset + offset
+        );
 }
 
 void VulkanBuffer::resize(
@@ -62,18 +65,18 @@ void VulkanBuffer::resize(
     vk::Buffer new_handle = create_buffer(new_size, _usage);
 
     // Allocate memory to new buffer
-    vk::DeviceMemory new_memory =
-        allocate_buffer_memory(new_handle, _properties);
+    auto new_memory = allocate_buffer_memory(new_handle, _properties);
 
     // Bind allocated memory to buffer
-    _device->handle().bindBufferMemory(new_handle, new_memory, 0);
+    _device->handle().bindBufferMemory(
+        new_handle, new_memory.memory, new_memory.offset
+    );
 
-    // Copy all the data over
-    copy_data_to_buffer(command_buffer, new_handle, 0, 0, size);
+    // Copy the data over
+    copy_data_to_resized(command_buffer, new_handle);
 
-    // Destroy the old
-    if (_handle) _device->handle().destroyBuffer(_handle, _allocator);
-    if (_memory) _device->handle().freeMemory(_memory, _allocator);
+    // Release the old
+    release_replaced(_handle, _memory);
 
     // Set the new
     _size   = new_size;
@@ -90,24 +93,27 @@ void VulkanBuffer::load_data(
     const vk::DeviceSize offset,
     const vk::DeviceSize size
 ) const {
-    // Map buffer memory into a CPU accessible memory
-    auto data_ptr = _device->handle().mapMemory(memory, offset, size);
-    // Copy data to the assigned memory
-    memcpy(data_ptr, data, (size_t) size);
-    // Unmap the memory
-    _device->handle().unmapMemory(memory);
+    if (_memory.mapped == nullptr)
+        Logger::fatal(
+            RENDERER_VULKAN_LOG, "Can't load data to a non host visible buffer."
+        );
+    // Copy data to the (persistently mapped) buffer memory
+    memcpy(_memory.mapped + offset, data, (size_t) size);
 }
 
 void* VulkanBuffer::lock_memory(
     const vk::DeviceSize offset, const vk::DeviceSize size
 ) {
-    // Map buffer memory into a CPU accessible memory
-    auto data_ptr = _device->handle().mapMemory(memory, offset, size);
-    return data_ptr;
+    if (_memory.mapped == nullptr)
+        Logger::fatal(
+            RENDERER_VULKAN_LOG,
+            "Can't lock memory of a non host visible buffer."
+        );
+    // Host visible memory stays mapped
+    return _memory.mapped + offset;
 }
 void VulkanBuffer::unlock_memory() {
-    // Unmap the memory
-    _device->handle().unmapMemory(memory);
+    // Nothing to do, memory stays mapped until freed
 }
 
 void VulkanBuffer::copy_data_to_buffer(
@@ -152,6 +158,23 @@ void VulkanBuffer::copy_data_to_image(
     );
 }
 
+// /////////////////////////////// //
+// VULKAN BUFFER PROTECTED METHODS //
+// /////////////////////////////// //
+
+void VulkanBuffer::copy_data_to_resized(
+    const vk::CommandBuffer& command_buffer, const vk::Buffer& new_handle
+) const {
+    copy_data_to_buffer(command_buffer, new_handle, 0, 0, size);
+}
+
+void VulkanBuffer::release_replaced(
+    const vk::Buffer old_handle, VulkanMemoryAllocator::Allocation old_memory
+) {
+    if (old_handle) _device->handle().destroyBuffer(old_handle, _allocator);
+    _device->memory_allocator()->free(old_memory);
+}
+
 // /////////////////////////////// //
 // VULKAN BUFFER PRIVATE FUNCTIONS //
 // /////////////////////////////// //
@@ -176,30 +199,17 @@ vk::Buffer VulkanBuffer::create_buffer(
     return buffer;
 }
 
-vk::DeviceMemory VulkanBuffer::allocate_buffer_memory(
+VulkanMemoryAllocator::Allocation VulkanBuffer::allocate_buffer_memory(
     const vk::Buffer buffer, const vk::MemoryPropertyFlags properties
 ) const {
     auto memory_requirements =
         _device->handle().getBufferMemoryRequirements(buffer);
 
-    // Find memory type
-    auto memory_type = _device->find_memory_type(
-        memory_requirements.memoryTypeBits, properties
+    // Sub-allocate from device memory (buffers are always linear)
+    auto allocation = _device->memory_allocator()->allocate(
+        memory_requirements, properties, true
     );
-    if (memory_type.has_error())
-        Logger::fatal(RENDERER_VULKAN_LOG, memory_type.error().what());
-
-    vk::MemoryAllocateInfo allocation_info {};
-    // Number of bytes to be allocated
-    allocation_info.setAllocationSize(memory_requirements.size);
-    // Type of memory we wish to allocate from
-    allocation_info.setMemoryTypeIndex(memory_type.value());
-
-    vk::DeviceMemory memory;
-    try {
-        memory = _device->handle().allocateMemory(allocation_info, _allocator);
-    } catch (vk::SystemError e) {
-        Logger::fatal(RENDERER_VULKAN_LOG, e.what());
-    }
-    return memory;
+    if (allocation.has_error())
+        Logger::fatal(RENDERER_VULKAN_LOG, allocation.error().what());
+    return allocation.value();
 }
\ No newline at end of file
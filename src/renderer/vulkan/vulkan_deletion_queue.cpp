@@ -0,0 +1,65 @@
+#include "renderer/vulkan/vulkan_deletion_queue.hpp"
+
+// Constructor & Destructor
+VulkanDeletionQueue::VulkanDeletionQueue(
+    const VulkanDevice* const            device,
+    const vk::AllocationCallbacks* const allocator,
+    const VulkanStagingBuffer* const     staging_buffer
+)
+    : _device(device), _allocator(allocator), _staging_buffer(staging_buffer) {
+}
+VulkanDeletionQueue::~VulkanDeletionQueue() {
+    for (const auto& entry : _entries)
+        destroy(entry);
+    _entries.clear();
+}
+
+// //////////////////////////////////// //
+// VULKAN DELETION QUEUE PUBLIC METHODS //
+// //////////////////////////////////// //
+
+void VulkanDeletionQueue::enqueue(VulkanImage* const image) {
+    if (image == nullptr) return;
+    push({ image, nullptr, vk::Sampler {} });
+}
+void VulkanDeletionQueue::enqueue(VulkanBuffer* const buffer) {
+    if (buffer == nullptr) return;
+    push({ nullptr, buffer, vk::Sampler {} });
+}
+void VulkanDeletionQueue::enqueue(const vk::Sampler sampler) {
+    if (!sampler) return;
+    push({ nullptr, nullptr, sampler });
+}
+
+uint64 VulkanDeletionQueue::end_frame() { return _frame++; }
+
+void VulkanDeletionQueue::release(const uint64 completed_frame) {
+    // Entries are queued in frame & ticket order, so the first one still in
+    // use ends the search
+    uint32 released = 0;
+    for (; released < _entries.size(); released++) {
+        const auto& entry = _entries[released];
+        if (entry.frame > completed_frame) break;
+        if (!_staging_buffer->is_complete(entry.ticket)) break;
+        destroy(entry);
+    }
+    if (released > 0)
+        _entries.erase(_entries.begin(), _entries.begin() + released);
+}
+
+// ///////////////////////////////////// //
+// VULKAN DELETION QUEUE PRIVATE METHODS //
+// ///////////////////////////////////// //
+
+void VulkanDeletionQueue::push(Entry entry) {
+    entry.frame  = _frame;
+    entry.ticket = _staging_buffer->get_ticket();
+    _entries.push_back(entry);
+}
+
+void VulkanDeletionQueue::destroy(const Entry& entry) const {
+    if (entry.image) delete entry.image;
+    if (entry.buffer) delete entry.buffer;
+    if (entry.sampler)
+        _device->handle().destroySampler(entry.sampler, _allocator);
+}
@@ -68,9 +68,14 @@ VulkanDevice::VulkanDevice(
     if (VulkanSettings::compute__family_required)
         compute_queue =
             _handle.getQueue(queue_family_indices.compute_family.value(), 0);
+
+    // Create device memory allocator
+    _memory_allocator =
+        new (MemoryTag::Renderer) VulkanMemoryAllocator(this, _allocator);
 }
 
 VulkanDevice::~VulkanDevice() {
+    delete _memory_allocator;
     _handle.destroy(_allocator);
     Logger::trace(RENDERER_VULKAN_LOG, "Device destroyed.");
 }
@@ -154,9 +159,17 @@ vk::Device VulkanDevice::create_logical_device(
     // Used features (automatically use required)
     auto device_features =
         vk::PhysicalDeviceFeatures(VulkanSettings::required_device_features);
+    // Optional features, used if available
+    device_features.setTextureCompressionBC(
+        physical_device.getFeatures().textureCompressionBC
+    );
+    // Timeline semaphores (upload tracking)
+    vk::PhysicalDeviceVulkan12Features device_features_12 {};
+    device_features_12.setTimelineSemaphore(true);
 
     // Creating the logical device with required features and extensions enabled
     vk::DeviceCreateInfo create_info {};
+    create_info.setPNext(&device_features_12);
     create_info.setQueueCreateInfos(queue_create_infos);
     create_info.setPEnabledFeatures(&device_features);
     create_info.setPEnabledExtensionNames(
@@ -181,6 +194,7 @@ PhysicalDeviceInfo VulkanDevice::get_physical_device_info(
         physical_device.getProperties();
     vk::PhysicalDeviceMemoryProperties device_memory =
         physical_device.getMemoryProperties();
+    vk::PhysicalDeviceFeatures device_features = physical_device.getFeatures();
 
     // Fill device info
     PhysicalDeviceInfo device_info {};
@@ -210,13 +224,25 @@ PhysicalDeviceInfo VulkanDevice::get_physical_device_info(
     // Min UBO alignment requirement
     device_info.min_ubo_alignment =
         device_properties.limits.minUniformBufferOffsetAlignment;
+    // Memory allocation limits
+    device_info.buffer_image_granularity =
+        device_properties.limits.bufferImageGranularity;
+    device_info.max_memory_allocation_count =
+        device_properties.limits.maxMemoryAllocationCount;
+
+    // Info from features
+    device_info.supports_texture_compression_bc =
+        device_features.textureCompressionBC;
 
     // Info from memory properties
     device_info.memory_size_in_gb.resize(device_memory.memoryHeapCount);
     device_info.memory_types.resize(device_memory.memoryTypeCount);
+    device_info.memory_heaps.resize(device_memory.memoryHeapCount);
     device_info.memory_is_local.resize(device_memory.memoryHeapCount);
 
     for (uint32 i = 0; i < device_memory.memoryHeapCount; i++) {
+        // Memory heaps
+        device_info.memory_heaps[i] = device_memory.memoryHeaps[i];
         // Memory size
         device_info.memory_size_in_gb[i] =
             1.0f * device_memory.memoryHeaps[i].size / 1024.f / 1024.f / 1024.f;
@@ -294,6 +320,12 @@ int32 VulkanDevice::rate_device_suitability(
 ) const {
     vk::PhysicalDeviceProperties device_properties = device.getProperties();
     vk::PhysicalDeviceFeatures   device_features   = device.getFeatures();
+    // Vulkan 1.2 features
+    auto device_features_chain = device.getFeatures2<
+        vk::PhysicalDeviceFeatures2,
+        vk::PhysicalDeviceVulkan12Features>();
+    auto device_features_12 =
+        device_features_chain.get<vk::PhysicalDeviceVulkan12Features>();
 
     // Is device suitable at all
     auto queue_family_indices = find_queue_families(device, vulkan_surface);
@@ -302,7 +334,8 @@ int32 VulkanDevice::rate_device_suitability(
         !check_device_extension_support(device
         ) || // Device must support all required extensions
         !device_supports_required_features(device_features
-        ) // Device must posses all required features
+        ) || // Device must posses all required features
+        !device_features_12.timelineSemaphore // Used for upload tracking
     )
         return {};
     auto swapchain_support =
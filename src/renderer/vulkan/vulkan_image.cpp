@@ -4,7 +4,7 @@
 
 VulkanImage::~VulkanImage() {
     if (_handle) _device->handle().destroyImage(_handle, _allocator);
-    if (_memory) _device->handle().freeMemory(_memory, _allocator);
+    _device->memory_allocator()->free(_memory);
     if (_has_view) _device->handle().destroyImageView(view, _allocator);
 #ifdef TRACE_FILE_VULKAN_IMAGE
     Logger::trace(RENDERER_VULKAN_LOG, "Image destroyed.");
@@ -61,25 +61,16 @@ void VulkanImage::create(
     auto memory_requirements =
         _device->handle().getImageMemoryRequirements(handle);
 
-    vk::MemoryAllocateInfo allocation_info {};
-    // Number of bytes to be allocated
-    allocation_info.setAllocationSize(memory_requirements.size);
-    // Type of memory we wish to allocate from
-    auto memory_type = _device->find_memory_type(
-        memory_requirements.memoryTypeBits, properties
+    // Sub-allocate from device memory
+    auto allocation = _device->memory_allocator()->allocate(
+        memory_requirements, properties, tiling == vk::ImageTiling::eLinear
     );
-    if (memory_type.has_error())
-        Logger::fatal(RENDERER_VULKAN_LOG, memory_type.error().what());
-    allocation_info.setMemoryTypeIndex(memory_type.value());
-
-    try {
-        _memory = _device->handle().allocateMemory(allocation_info, _allocator);
-    } catch (const vk::SystemError& e) {
-        Logger::fatal(RENDERER_VULKAN_LOG, e.what());
-    }
+    if (allocation.has_error())
+        Logger::fatal(RENDERER_VULKAN_LOG, allocation.error().what());
+    _memory = allocation.value();
 
     // Bind memory to the created image
-    _device->handle().bindImageMemory(handle, memory, 0);
+    _device->handle().bindImageMemory(handle, _memory.memory, _memory.offset);
 }
 
 void VulkanImage::create(
@@ -1,6 +1,13 @@
 #include "renderer/vulkan/vulkan_managed_buffer.hpp"
+#include "renderer/vulkan/vulkan_settings.hpp"
 
-VulkanManagedBuffer::~VulkanManagedBuffer() { delete _memory_allocator; }
+#include <algorithm> // max, min
+
+VulkanManagedBuffer::~VulkanManagedBuffer() {
+    for (auto& replaced : _replaced_buffers)
+        VulkanBuffer::release_replaced(replaced.handle, replaced.memory);
+    delete _memory_allocator;
+}
 
 // //////////////////////////////////// //
 // VULKAN MANAGED BUFFER PUBLIC METHODS //
@@ -12,17 +19,26 @@ void VulkanManagedBuffer::create(
     const vk::MemoryPropertyFlags properties,
     const bool                    bind_on_create
 ) {
+    if (size > UINT32_MAX)
+        Logger::fatal(
+            RENDERER_VULKAN_LOG,
+            "Managed buffer size is limited to 4GB (32-bit offsets)."
+        );
     VulkanBuffer::create(size, usage, properties, bind_on_create);
-    _memory_allocator = new GPUFreeListAllocator(
-        size, 0, GPUFreeListAllocator::PlacementPolicy::FindFirst
-    );
-    _memory_allocator->init();
+    _memory_allocator =
+        new GPUOffsetAllocator((uint32) size, max_allocations);
 }
 
 void VulkanManagedBuffer::resize(
     const vk::CommandBuffer& command_buffer, const vk::DeviceSize new_size
 ) {
-    Logger::fatal("ERROR :: UNIMPLEMENTED YET"); // TODO: Implement
+    if (new_size > UINT32_MAX)
+        Logger::fatal(
+            RENDERER_VULKAN_LOG,
+            "Managed buffer size is limited to 4GB (32-bit offsets)."
+        );
+    VulkanBuffer::resize(command_buffer, new_size);
+    _memory_allocator->grow((uint32) new_size);
 }
 
 void VulkanManagedBuffer::load_data(
@@ -30,19 +46,220 @@ void VulkanManagedBuffer::load_data(
     const vk::DeviceSize offset,
     const vk::DeviceSize size
 ) const {
-    if (_memory_allocator->allocated((void*) offset, size) == false)
+#ifndef NDEBUG
+    // Walks all regions, so checked only in debug builds
+    if (_memory_allocator->allocated((uint32) offset, (uint32) size) == false)
         Logger::fatal(
             RENDERER_VULKAN_LOG,
             "Segmentation fault :D. Cant use unallocated GPU memory."
         );
+#endif
     VulkanBuffer::load_data(data, offset, size);
 }
 
-vk::DeviceSize VulkanManagedBuffer::allocate(
+void VulkanManagedBuffer::enable_growth(
+    VulkanStagingBuffer* const staging_buffer,
+    const float32              growth_factor,
+    const vk::DeviceSize       max_size
+) {
+    if (growth_factor <= 1.0f)
+        Logger::fatal(
+            RENDERER_VULKAN_LOG, "Buffer growth factor must be greater than 1."
+        );
+    _staging_buffer = staging_buffer;
+    _growth_factor  = growth_factor;
+    _max_size       = std::min(max_size, (vk::DeviceSize) UINT32_MAX);
+}
+
+void VulkanManagedBuffer::begin_frame() {
+    // Copies of the last frame were submitted
+    _recorded_moves.clear();
+
+    for (uint32 i = 0; i < _replaced_buffers.size();) {
+        auto& replaced = _replaced_buffers[i];
+        if (--replaced.frames_left > 0) {
+            i++;
+            continue;
+        }
+        VulkanBuffer::release_replaced(replaced.handle, replaced.memory);
+        replaced = _replaced_buffers.back();
+        _replaced_buffers.pop_back();
+    }
+}
+
+VulkanManagedBuffer::Allocation VulkanManagedBuffer::allocate(
     const uint64 size, const uint64 alignment
 ) {
-    return (vk::DeviceSize) _memory_allocator->allocate(size, alignment);
+    auto allocation =
+        _memory_allocator->allocate((uint32) size, (uint32) alignment);
+    if (!allocation.is_valid() && _staging_buffer != nullptr) {
+        grow(size + alignment);
+        allocation =
+            _memory_allocator->allocate((uint32) size, (uint32) alignment);
+    }
+    if (!allocation.is_valid())
+        Logger::fatal(RENDERER_VULKAN_LOG, "Managed buffer out of memory.");
+    return allocation;
+}
+void VulkanManagedBuffer::deallocate(const Allocation allocation) {
+    _memory_allocator->free(allocation.handle);
+}
+
+Vector<VulkanManagedBuffer::Move> VulkanManagedBuffer::defragment(
+    const vk::CommandBuffer& command_buffer,
+    const uint32             max_bytes,
+    const uint32             alignment
+) {
+    Vector<Move> moves {};
+    _memory_allocator->plan_defragmentation(max_bytes, alignment, moves);
+    if (moves.empty()) return moves;
+    _recorded_moves.insert(_recorded_moves.end(), moves.begin(), moves.end());
+
+    // Copy within this buffer (source & destination regions never overlap)
+    Vector<vk::BufferCopy> copy_regions {};
+    copy_regions.reserve(moves.size());
+    for (const auto& move : moves)
+        copy_regions.push_back(
+            { move.source_offset, move.destination_offset, move.size }
+        );
+    command_buffer.copyBuffer(
+        handle, handle, (uint32) copy_regions.size(), copy_regions.data()
+    );
+
+    // Later reads of moved data (drawing or further moves) wait for copies
+    vk::MemoryBarrier barrier {};
+    barrier.setSrcAccessMask(vk::AccessFlagBits::eTransferWrite);
+    barrier.setDstAccessMask(
+        vk::AccessFlagBits::eTransferRead |
+        vk::AccessFlagBits::eVertexAttributeRead |
+        vk::AccessFlagBits::eIndexRead
+    );
+    command_buffer.pipelineBarrier(
+        vk::PipelineStageFlagBits::eTransfer,
+        vk::PipelineStageFlagBits::eTransfer |
+            vk::PipelineStageFlagBits::eVertexInput,
+        vk::DependencyFlags(),
+        1,
+        &barrier,
+        0,
+        nullptr,
+        0,
+        nullptr
+    );
+
+    return moves;
+}
+
+// /////////////////////////////////////// //
+// VULKAN MANAGED BUFFER PROTECTED METHODS //
+// /////////////////////////////////////// //
+
+void VulkanManagedBuffer::copy_data_to_resized(
+    const vk::CommandBuffer& command_buffer, const vk::Buffer& new_handle
+) const {
+    // Earlier writes to the old buffer (uploads, defragmentation) come first
+    vk::MemoryBarrier barrier {};
+    barrier.setSrcAccessMask(vk::AccessFlagBits::eMemoryWrite);
+    barrier.setDstAccessMask(vk::AccessFlagBits::eTransferRead);
+    command_buffer.pipelineBarrier(
+        vk::PipelineStageFlagBits::eAllCommands,
+        vk::PipelineStageFlagBits::eTransfer,
+        vk::DependencyFlags(),
+        1,
+        &barrier,
+        0,
+        nullptr,
+        0,
+        nullptr
+    );
+
+    // Copy only allocated ranges
+    const auto             regions = _memory_allocator->get_used_regions();
+    Vector<vk::BufferCopy> copy_regions {};
+    copy_regions.reserve(regions.size());
+    for (const auto& region : regions)
+        copy_regions.push_back({ region.offset, region.offset, region.size });
+    if (!copy_regions.empty())
+        command_buffer.copyBuffer(
+            handle,
+            new_handle,
+            (uint32) copy_regions.size(),
+            copy_regions.data()
+        );
+    if (_recorded_moves.empty()) return;
+
+    // Moves recorded this frame will execute only later, on the old buffer.
+    // Repeat them on the new one.
+    barrier.setSrcAccessMask(vk::AccessFlagBits::eTransferWrite);
+    barrier.setDstAccessMask(
+        vk::AccessFlagBits::eTransferRead | vk::AccessFlagBits::eTransferWrite
+    );
+    command_buffer.pipelineBarrier(
+        vk::PipelineStageFlagBits::eTransfer,
+        vk::PipelineStageFlagBits::eTransfer,
+        vk::DependencyFlags(),
+        1,
+        &barrier,
+        0,
+        nullptr,
+        0,
+        nullptr
+    );
+
+    copy_regions.clear();
+    for (const auto& move : _recorded_moves)
+        copy_regions.push_back(
+            { move.source_offset, move.destination_offset, move.size }
+        );
+    command_buffer.copyBuffer(
+        new_handle,
+        new_handle,
+        (uint32) copy_regions.size(),
+        copy_regions.data()
+    );
+}
+
+void VulkanManagedBuffer::release_replaced(
+    const vk::Buffer old_handle, VulkanMemoryAllocator::Allocation old_memory
+) {
+    // Frames in flight might still use the old buffer. Copy out of it might
+    // only get submitted with the next frame.
+    _replaced_buffers.push_back(
+        { old_handle, old_memory, VulkanSettings::max_frames_in_flight + 1 }
+    );
+}
+
+// ///////////////////////////////////// //
+// VULKAN MANAGED BUFFER PRIVATE METHODS //
+// ///////////////////////////////////// //
+
+void VulkanManagedBuffer::grow(const uint64 required_size) {
+    const vk::DeviceSize old_size = size;
+    const vk::DeviceSize new_size = std::min(
+        std::max(
+            (vk::DeviceSize) (old_size * _growth_factor),
+            old_size + required_size
+        ),
+        _max_size
+    );
+    if (new_size < old_size + required_size)
+        Logger::fatal(
+            RENDERER_VULKAN_LOG, "Managed buffer reached its maximum size."
+        );
+
+    // Uploads issued so far target live ranges of the old buffer. Submitting
+    // them (doesn't block) orders the copy, recorded into the next upload
+    // batch, after them. Later uploads only target ranges allocated after the
+    // growth, which aren't copied.
+    _staging_buffer->submit();
+    resize(_staging_buffer->graphics_command_buffer(), new_size);
+
+    Logger::trace(
+        RENDERER_VULKAN_LOG,
+        "Managed buffer grown from ",
+        old_size,
+        " to ",
+        new_size,
+        " bytes."
+    );
 }
-void VulkanManagedBuffer::deallocate(vk::DeviceSize offset) {
-    _memory_allocator->free((void*) offset);
-}
\ No newline at end of file
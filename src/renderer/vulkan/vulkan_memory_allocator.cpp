@@ -0,0 +1,305 @@
+#include "renderer/vulkan/vulkan_memory_allocator.hpp"
+
+#include "renderer/vulkan/vulkan_device.hpp"
+#include "renderer/vulkan/vulkan_settings.hpp"
+
+#include <algorithm> // min, find
+
+struct VulkanMemoryAllocator::Block {
+    vk::DeviceMemory    memory;
+    vk::DeviceSize      size;
+    // Whole block mapping, nullptr if not host visible
+    byte*               mapped;
+    uint32              memory_type;
+    uint32              pool;
+    GPUOffsetAllocator* allocator;
+};
+
+// Constructor & Destructor
+VulkanMemoryAllocator::VulkanMemoryAllocator(
+    const VulkanDevice* const            device,
+    const vk::AllocationCallbacks* const allocator
+)
+    : _device(device), _allocator(allocator) {
+    const auto info          = _device->info();
+    _memory_types            = info.memory_types;
+    _max_memory_object_count = info.max_memory_allocation_count;
+
+    _pools.resize(info.memory_types.size() * 2);
+    _heap_stats.resize(info.memory_heaps.size());
+    _block_sizes.resize(info.memory_heaps.size());
+    for (uint32 i = 0; i < info.memory_heaps.size(); i++) {
+        const auto heap_size = info.memory_heaps[i].size;
+
+        _heap_stats[i].size   = heap_size;
+        _heap_stats[i].budget = (vk::DeviceSize
+        ) (heap_size * VulkanSettings::memory_heap_budget);
+        // Small heaps (e.g. device local host visible) use smaller blocks
+        _block_sizes[i] =
+            std::min(VulkanSettings::memory_block_size, heap_size / 8);
+    }
+
+    // With no granularity all resources can share pages
+    _separate_linear = info.buffer_image_granularity > 1;
+}
+VulkanMemoryAllocator::~VulkanMemoryAllocator() {
+    uint32 leaked = 0;
+    for (const auto& pool : _pools) {
+        for (const auto block : pool) {
+            leaked += block->allocator->get_used() > 0;
+            destroy_block(block);
+        }
+    }
+    if (leaked > 0)
+        Logger::warning(
+            RENDERER_VULKAN_LOG,
+            leaked,
+            " memory block(s) still had live allocations on shutdown."
+        );
+}
+
+// ////////////////////////////////////// //
+// VULKAN MEMORY ALLOCATOR PUBLIC METHODS //
+// ////////////////////////////////////// //
+
+Result<VulkanMemoryAllocator::Allocation, RuntimeError>
+VulkanMemoryAllocator::allocate(
+    const vk::MemoryRequirements& requirements,
+    const vk::MemoryPropertyFlags properties,
+    const bool                    linear
+) {
+    // Try all suitable memory types, preferred one first
+    uint32 type_filter = requirements.memoryTypeBits;
+    bool   type_found  = false;
+    while (true) {
+        auto memory_type = _device->find_memory_type(type_filter, properties);
+        if (memory_type.has_error()) break;
+        type_found = true;
+
+        auto allocation =
+            allocate_from_type(requirements, memory_type.value(), linear);
+        if (allocation.is_valid()) return allocation;
+
+        type_filter &= ~(1u << memory_type.value());
+    }
+
+    if (type_found) return Failure("Out of device memory.");
+    return Failure("Failed to find suitable memory type.");
+}
+
+void VulkanMemoryAllocator::free(Allocation& allocation) {
+    if (!allocation.is_valid()) return;
+
+    auto& heap = heap_of(allocation.memory_type);
+    heap.used -= allocation.size;
+    heap.allocation_count--;
+
+    if (allocation.block == nullptr) {
+        // Dedicated
+        heap.dedicated_count--;
+        free_memory(allocation.memory, allocation.size, allocation.memory_type);
+    } else {
+        auto block = allocation.block;
+        block->allocator->free(allocation.handle);
+
+        // Release empty blocks, except the last one of each pool
+        auto& pool = _pools[block->pool];
+        if (block->allocator->get_used() == 0 && pool.size() > 1) {
+            pool.erase(std::find(pool.begin(), pool.end(), block));
+            destroy_block(block);
+        }
+    }
+
+    allocation = {};
+}
+
+void VulkanMemoryAllocator::log_stats() const {
+    for (uint32 i = 0; i < _heap_stats.size(); i++) {
+        const auto& heap = _heap_stats[i];
+        Logger::log(
+            RENDERER_VULKAN_LOG,
+            "Memory heap ",
+            i,
+            " :: ",
+            heap.used / 1024,
+            " KiB used, ",
+            heap.reserved / 1024,
+            " KiB reserved, ",
+            heap.budget / 1024,
+            " KiB budget; ",
+            heap.allocation_count,
+            " allocations in ",
+            heap.block_count,
+            " blocks & ",
+            heap.dedicated_count,
+            " dedicated."
+        );
+    }
+}
+
+// /////////////////////////////////////// //
+// VULKAN MEMORY ALLOCATOR PRIVATE METHODS //
+// /////////////////////////////////////// //
+
+VulkanMemoryAllocator::Allocation VulkanMemoryAllocator::allocate_from_type(
+    const vk::MemoryRequirements& requirements,
+    const uint32                  memory_type,
+    const bool                    linear
+) {
+    // Big resources get their own memory
+    const auto heap_index = _memory_types[memory_type].heapIndex;
+    const auto block_size = _block_sizes[heap_index];
+    if (requirements.size >= VulkanSettings::dedicated_allocation_threshold ||
+        requirements.size > block_size / 2)
+        return allocate_dedicated(requirements.size, memory_type);
+
+    const uint32 size      = (uint32) requirements.size;
+    const uint32 alignment = (uint32) requirements.alignment;
+    const uint32 pool_index =
+        memory_type * 2 + ((_separate_linear && !linear) ? 1 : 0);
+    auto& pool = _pools[pool_index];
+
+    // Find a block with space, newest first
+    Block*                         block            = nullptr;
+    GPUOffsetAllocator::Allocation block_allocation = {};
+    for (auto it = pool.rbegin(); it != pool.rend(); it++) {
+        block_allocation = (*it)->allocator->allocate(size, alignment);
+        if (block_allocation.is_valid()) {
+            block = *it;
+            break;
+        }
+    }
+
+    // Add a new block, smaller ones if memory is getting scarce
+    for (auto new_block_size = block_size;
+         block == nullptr && new_block_size >= requirements.size;
+         new_block_size /= 2) {
+        auto new_block = create_block(new_block_size, memory_type, pool_index);
+        if (new_block == nullptr) continue;
+        pool.push_back(new_block);
+        block            = new_block;
+        block_allocation = block->allocator->allocate(size, alignment);
+    }
+    if (block == nullptr) return {};
+
+    Allocation allocation {};
+    allocation.memory      = block->memory;
+    allocation.offset      = block_allocation.offset;
+    allocation.size        = requirements.size;
+    allocation.mapped      = block->mapped ? block->mapped + allocation.offset
+                                           : nullptr;
+    allocation.block       = block;
+    allocation.handle      = block_allocation.handle;
+    allocation.memory_type = memory_type;
+
+    auto& heap = heap_of(memory_type);
+    heap.used += allocation.size;
+    heap.allocation_count++;
+    return allocation;
+}
+
+VulkanMemoryAllocator::Allocation VulkanMemoryAllocator::allocate_dedicated(
+    const vk::DeviceSize size, const uint32 memory_type
+) {
+    Allocation allocation {};
+    allocation.memory = allocate_memory(size, memory_type);
+    if (!allocation.memory) return {};
+    allocation.size        = size;
+    allocation.memory_type = memory_type;
+
+    const auto flags = _memory_types[memory_type].propertyFlags;
+    if (flags & vk::MemoryPropertyFlagBits::eHostVisible)
+        allocation.mapped = (byte*) _device->handle().mapMemory(
+            allocation.memory, 0, VK_WHOLE_SIZE
+        );
+
+    auto& heap = heap_of(memory_type);
+    heap.used += size;
+    heap.allocation_count++;
+    heap.dedicated_count++;
+    return allocation;
+}
+
+VulkanMemoryAllocator::Block* VulkanMemoryAllocator::create_block(
+    const vk::DeviceSize size, const uint32 memory_type, const uint32 pool
+) {
+    auto memory = allocate_memory(size, memory_type);
+    if (!memory) return nullptr;
+
+    auto block         = new (MemoryTag::Renderer) Block();
+    block->memory      = memory;
+    block->size        = size;
+    block->mapped      = nullptr;
+    block->memory_type = memory_type;
+    block->pool        = pool;
+    block->allocator   = new GPUOffsetAllocator(
+        (uint32) size, VulkanSettings::memory_block_max_allocations
+    );
+
+    const auto flags = _memory_types[memory_type].propertyFlags;
+    if (flags & vk::MemoryPropertyFlagBits::eHostVisible)
+        block->mapped =
+            (byte*) _device->handle().mapMemory(memory, 0, VK_WHOLE_SIZE);
+
+    heap_of(memory_type).block_count++;
+    return block;
+}
+
+void VulkanMemoryAllocator::destroy_block(Block* const block) {
+    heap_of(block->memory_type).block_count--;
+    free_memory(block->memory, block->size, block->memory_type);
+    delete block->allocator;
+    delete block;
+}
+
+vk::DeviceMemory VulkanMemoryAllocator::allocate_memory(
+    const vk::DeviceSize size, const uint32 memory_type
+) {
+    // Drivers limit the number of live allocations
+    if (_memory_object_count >= _max_memory_object_count) return {};
+
+    auto& heap = heap_of(memory_type);
+    if (heap.reserved + size > heap.budget)
+        Logger::warning(
+            RENDERER_VULKAN_LOG,
+            "Device memory allocation of ",
+            size,
+            " bytes exceeds the heap budget."
+        );
+
+    vk::MemoryAllocateInfo allocation_info {};
+    allocation_info.setAllocationSize(size);
+    allocation_info.setMemoryTypeIndex(memory_type);
+
+    vk::DeviceMemory memory;
+    try {
+        memory = _device->handle().allocateMemory(allocation_info, _allocator);
+    } catch (const vk::OutOfDeviceMemoryError& e) {
+        return {};
+    } catch (const vk::OutOfHostMemoryError& e) {
+        return {};
+    } catch (const vk::SystemError& e) {
+        Logger::fatal(RENDERER_VULKAN_LOG, e.what());
+    }
+
+    heap.reserved += size;
+    _memory_object_count++;
+    return memory;
+}
+
+void VulkanMemoryAllocator::free_memory(
+    const vk::DeviceMemory memory,
+    const vk::DeviceSize   size,
+    const uint32           memory_type
+) {
+    // Freeing also unmaps
+    _device->handle().freeMemory(memory, _allocator);
+    heap_of(memory_type).reserved -= size;
+    _memory_object_count--;
+}
+
+VulkanMemoryAllocator::HeapStats& VulkanMemoryAllocator::heap_of(
+    const uint32 memory_type
+) {
+    return _heap_stats[_memory_types[memory_type].heapIndex];
+}
@@ -0,0 +1,56 @@
+#include "renderer/vulkan/vulkan_sampler_cache.hpp"
+
+// Constructor & Destructor
+VulkanSamplerCache::VulkanSamplerCache(
+    const VulkanDevice* const            device,
+    const vk::AllocationCallbacks* const allocator
+)
+    : _device(device), _allocator(allocator) {}
+VulkanSamplerCache::~VulkanSamplerCache() {
+    for (const auto& sampler : _samplers)
+        _device->handle().destroySampler(sampler.second, _allocator);
+    _samplers.clear();
+    Logger::trace(RENDERER_VULKAN_LOG, "Sampler cache destroyed.");
+}
+
+// /////////////////////////////////// //
+// VULKAN SAMPLER CACHE PUBLIC METHODS //
+// /////////////////////////////////// //
+
+vk::Sampler VulkanSamplerCache::get(const VulkanSamplerState& state) {
+    auto it = _samplers.find(state);
+    if (it != _samplers.end()) return it->second;
+
+    vk::SamplerCreateInfo sampler_info {};
+    sampler_info.setAddressModeU(state.address_mode_u);
+    sampler_info.setAddressModeV(state.address_mode_v);
+    sampler_info.setAddressModeW(state.address_mode_w);
+    sampler_info.setAnisotropyEnable(state.anisotropy);
+    sampler_info.setMaxAnisotropy(
+        state.anisotropy ? _device->info().max_sampler_anisotropy : 1.0f
+    );
+    sampler_info.setBorderColor(vk::BorderColor::eIntOpaqueBlack);
+    sampler_info.setUnnormalizedCoordinates(false);
+    sampler_info.setCompareEnable(false);
+    sampler_info.setCompareOp(vk::CompareOp::eAlways);
+    // Mipmap settings
+    sampler_info.setMagFilter(state.mag_filter);
+    sampler_info.setMinFilter(state.min_filter);
+    sampler_info.setMipmapMode(state.mipmap_mode);
+    sampler_info.setMipLodBias(0.0f);
+    sampler_info.setMinLod(0.0f);
+    sampler_info.setMaxLod(VK_LOD_CLAMP_NONE);
+
+    vk::Sampler sampler;
+    try {
+        sampler = _device->handle().createSampler(sampler_info, _allocator);
+    } catch (const vk::SystemError& e) {
+        Logger::fatal(RENDERER_VULKAN_LOG, e.what());
+    }
+
+    _samplers[state] = sampler;
+    Logger::trace(
+        RENDERER_VULKAN_LOG, "Sampler created (", _samplers.size(), " total)."
+    );
+    return sampler;
+}
@@ -17,7 +17,7 @@ VulkanShader::VulkanShader(
 
     // === Process shader config ===
     // Translate stage info to vulkan flags
-    Vector<vk::ShaderStageFlagBits> shader_stages {};
+    StageList shader_stages {};
     if (config.shader_stages & (uint8) ShaderStage::Vertex)
         shader_stages.push_back(vk::ShaderStageFlagBits::eVertex);
     if (config.shader_stages & (uint8) ShaderStage::Geometry)
@@ -137,7 +137,8 @@ VulkanShader::VulkanShader(
     // Allocate space for the global UBO, which should occupy the _stride_
     // space, _not_ the actual size used.
     _global_ubo_offset =
-        _uniform_buffer->allocate(_global_ubo_size, _required_ubo_alignment);
+        _uniform_buffer->allocate(_global_ubo_size, _required_ubo_alignment)
+            .offset;
 
     // Map the entire buffer's memory.
     _uniform_buffer_offset =
@@ -224,8 +225,7 @@ void VulkanShader::apply_global() {
     vk::DescriptorSet& global_descriptor =
         _global_descriptor_sets[_command_buffer->current_frame];
 
-    static Vector<vk::WriteDescriptorSet> descriptor_writes {};
-    descriptor_writes.clear();
+    StaticVector<vk::WriteDescriptorSet, 2> descriptor_writes {};
 
     // Apply UBO first
     vk::DescriptorBufferInfo buffer_info {};
@@ -243,9 +243,11 @@ void VulkanShader::apply_global() {
     ubo_write.setPBufferInfo(&buffer_info);
     descriptor_writes.push_back(ubo_write);
 
+    // Must outlive the descriptor set update
+    ImageInfoList image_infos {};
     if (_descriptor_set_configs[_desc_set_index_global]->bindings.size() > 1) {
         // Iterate samplers.
-        const auto& image_infos = get_image_infos(_global_textures);
+        image_infos = get_image_infos(_global_textures);
 
         vk::WriteDescriptorSet sampler_descriptor {};
         sampler_descriptor.setDstSet(global_descriptor);
@@ -254,12 +256,15 @@ void VulkanShader::apply_global() {
             vk::DescriptorType::eCombinedImageSampler
         );
         ubo_write.setDstArrayElement(0);
-        sampler_descriptor.setImageInfo(image_infos);
+        sampler_descriptor.setDescriptorCount(image_infos.size());
+        sampler_descriptor.setPImageInfo(image_infos.data());
         descriptor_writes.push_back(sampler_descriptor);
     }
 
     // Throws no exceptions
-    _device->handle().updateDescriptorSets(descriptor_writes, nullptr);
+    _device->handle().updateDescriptorSets(
+        descriptor_writes.size(), descriptor_writes.data(), 0, nullptr
+    );
 
     // Bind the global descriptor set to be updated.
     _command_buffer->handle->bindDescriptorSets(
@@ -290,8 +295,7 @@ void VulkanShader::apply_instance() {
     auto& descriptor_set_id = object_state->descriptor_set_ids[current_frame];
 
     // TODO: if needs update
-    static Vector<vk::WriteDescriptorSet> descriptor_writes {};
-    descriptor_writes.clear();
+    StaticVector<vk::WriteDescriptorSet, 2> descriptor_writes {};
 
     // Descriptor 0 - Uniform buffer
     // Only do this if the descriptor has not yet been updated.
@@ -316,11 +320,11 @@ void VulkanShader::apply_instance() {
 
     // Samplers will always be in the binding. If the binding count is less than
     // 2, there are no samplers.
+    ImageInfoList image_infos {};
     if (_descriptor_set_configs[_desc_set_index_instance]->bindings.size() >
         1) {
         // Iterate samplers.
-        const auto& image_infos =
-            get_image_infos(object_state->instance_textures);
+        image_infos = get_image_infos(object_state->instance_textures);
 
         vk::WriteDescriptorSet sampler_descriptor {};
         sampler_descriptor.setDstSet(object_descriptor_set);
@@ -328,13 +332,16 @@ void VulkanShader::apply_instance() {
         sampler_descriptor.setDescriptorType(
             vk::DescriptorType::eCombinedImageSampler
         );
-        sampler_descriptor.setImageInfo(image_infos);
+        sampler_descriptor.setDescriptorCount(image_infos.size());
+        sampler_descriptor.setPImageInfo(image_infos.data());
         descriptor_writes.push_back(sampler_descriptor);
     }
 
     // No throws
     if (descriptor_writes.size() > 0)
-        _device->handle().updateDescriptorSets(descriptor_writes, nullptr);
+        _device->handle().updateDescriptorSets(
+            descriptor_writes.size(), descriptor_writes.data(), 0, nullptr
+        );
 
     // Bind the descriptor set to be updated, or in case the shader changed.
     // Bind the global descriptor set to be updated.
@@ -364,8 +371,9 @@ uint32 VulkanShader::acquire_instance_resources() {
         );
 
     // Allocate some space in the UBO - by the stride, not the size.
-    instance_state->offset =
+    instance_state->allocation =
         _uniform_buffer->allocate(_ubo_stride, _required_ubo_alignment);
+    instance_state->offset = instance_state->allocation.offset;
 
     // Allocate one descriptor set per frame in flight.
     std::array<vk::DescriptorSetLayout, VulkanSettings::max_frames_in_flight>
@@ -408,7 +416,7 @@ void VulkanShader::release_instance_resources(uint32 instance_id) {
         _descriptor_pool, instance_state->descriptor_set
     );
 
-    _uniform_buffer->deallocate(instance_state->offset);
+    _uniform_buffer->deallocate(instance_state->allocation);
 
     delete instance_state;
     _instance_states[instance_id] = nullptr;
@@ -497,10 +505,10 @@ vk::ShaderModule VulkanShader::create_shader_module(
     return shader_module;
 }
 
-Vector<vk::PipelineShaderStageCreateInfo> VulkanShader::compute_stage_infos(
-    const Vector<vk::ShaderStageFlagBits>& shader_stages
+VulkanShader::StageInfoList VulkanShader::compute_stage_infos(
+    const StageList& shader_stages
 ) const {
-    Vector<vk::PipelineShaderStageCreateInfo> shader_stage_infos {};
+    StageInfoList shader_stage_infos {};
     // Create a module for each stage.
     for (uint32 i = 0; i < shader_stages.size(); i++) {
         // Create module
@@ -557,7 +565,7 @@ Vector<vk::VertexInputAttributeDescription> VulkanShader::compute_attributes(
 }
 
 Vector<VulkanDescriptorSetConfig*> VulkanShader::compute_uniforms(
-    const Vector<vk::ShaderStageFlagBits>& shader_stages
+    const StageList& shader_stages
 ) const {
     Vector<VulkanDescriptorSetConfig*> desc_set_configs {};
 
@@ -641,9 +649,9 @@ Vector<VulkanDescriptorSetConfig*> VulkanShader::compute_uniforms(
 }
 
 void VulkanShader::create_pipeline(
-    const Vector<vk::PipelineShaderStageCreateInfo>& shader_stages,
-    const vk::PipelineVertexInputStateCreateInfo&    vertex_input_info,
-    const bool                                       is_wire_frame
+    const StageInfoList&                          shader_stages,
+    const vk::PipelineVertexInputStateCreateInfo& vertex_input_info,
+    const bool                                    is_wire_frame
 ) {
     Logger::trace(RENDERER_VULKAN_LOG, "Creating graphics pipeline.");
 
@@ -830,7 +838,8 @@ void VulkanShader::create_pipeline(
     // === Create pipeline object ===
     vk::GraphicsPipelineCreateInfo create_info {};
     // Programable pipeline stages
-    create_info.setStages(shader_stages);
+    create_info.setStageCount(shader_stages.size());
+    create_info.setPStages(shader_stages.data());
     // Fixed-function stages
     create_info.setPVertexInputState(&vertex_input_info);
     create_info.setPInputAssemblyState(&input_assembly_info);
@@ -868,11 +877,12 @@ void VulkanShader::create_pipeline(
     Logger::trace(RENDERER_VULKAN_LOG, "Graphics pipeline created.");
 }
 
-Vector<vk::DescriptorImageInfo>& VulkanShader::get_image_infos(
+VulkanShader::ImageInfoList VulkanShader::get_image_infos(
     const Vector<Texture*>& textures
 ) const {
-    static Vector<vk::DescriptorImageInfo> image_infos {};
-    image_infos.clear();
+    // Spills only past inline_image_info_count samplers
+    ImageInfoList image_infos(MemoryTag::Frame);
+    image_infos.reserve(textures.size());
 
     for (uint32 i = 0; i < textures.size(); ++i) {
         // TODO: only update in the list if actually needing an update.
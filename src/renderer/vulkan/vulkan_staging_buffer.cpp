@@ -0,0 +1,526 @@
+#include "renderer/vulkan/vulkan_staging_buffer.hpp"
+
+#include "small_vector.hpp"
+
+#include <algorithm> // min, max
+#include <cstring>   // memcpy
+
+// Constructor & Destructor
+VulkanStagingBuffer::VulkanStagingBuffer(
+    const VulkanDevice* const            device,
+    const vk::AllocationCallbacks* const allocator,
+    const VulkanCommandPool* const       command_pool,
+    const vk::DeviceSize                 size
+)
+    : _device(device), _allocator(allocator), _command_pool(command_pool),
+      _size(size) {
+    // Chunks of large uploads can't take the whole ring, so that streaming
+    // can proceed while earlier chunks are still in flight
+    _max_chunk_size = size / 4;
+
+    // Transfer queue command pool
+    _transfer_family = _device->queue_family_indices.transfer_family.value();
+    _graphics_family = _device->queue_family_indices.graphics_family.value();
+    _transfer_ownership    = _transfer_family != _graphics_family;
+    _transfer_command_pool = new (MemoryTag::Renderer) VulkanCommandPool(
+        &_device->handle(),
+        _allocator,
+        &_device->transfer_queue,
+        _transfer_family
+    );
+
+    // Timeline semaphore
+    vk::SemaphoreTypeCreateInfo semaphore_type_info {};
+    semaphore_type_info.setSemaphoreType(vk::SemaphoreType::eTimeline);
+    semaphore_type_info.setInitialValue(0);
+    vk::SemaphoreCreateInfo semaphore_info {};
+    semaphore_info.setPNext(&semaphore_type_info);
+    try {
+        _timeline =
+            _device->handle().createSemaphore(semaphore_info, _allocator);
+    } catch (const vk::SystemError& e) {
+        Logger::fatal(RENDERER_VULKAN_LOG, e.what());
+    }
+
+    // Ring
+    _buffer = new (MemoryTag::GPUBuffer) VulkanBuffer(_device, _allocator);
+    _buffer->create(
+        size,
+        vk::BufferUsageFlagBits::eTransferSrc,
+        vk::MemoryPropertyFlagBits::eHostVisible |
+            vk::MemoryPropertyFlagBits::eHostCoherent
+    );
+    _mapped_memory = (byte*) _buffer->lock_memory(0, size);
+}
+VulkanStagingBuffer::~VulkanStagingBuffer() {
+    // Device is expected to be idle by now
+    if (_recording) _idle_batches.push_back(_batch);
+    _idle_batches.insert(
+        _idle_batches.end(),
+        _submitted_batches.begin(),
+        _submitted_batches.end()
+    );
+    for (auto& batch : _idle_batches) {
+        _transfer_command_pool->free_command_buffer(
+            batch.transfer_command_buffer
+        );
+        _command_pool->free_command_buffer(batch.graphics_command_buffer);
+    }
+    delete _transfer_command_pool;
+    _device->handle().destroySemaphore(_timeline, _allocator);
+
+    _buffer->unlock_memory();
+    delete _buffer;
+}
+
+// //////////////////////////////////// //
+// VULKAN STAGING BUFFER PUBLIC METHODS //
+// //////////////////////////////////// //
+
+void VulkanStagingBuffer::upload_to_buffer(
+    const void* const         data,
+    const vk::DeviceSize      size,
+    const VulkanBuffer* const buffer,
+    const vk::DeviceSize      offset
+) {
+    _uploaded_bytes += size;
+    for (vk::DeviceSize done = 0; done < size;) {
+        const vk::DeviceSize chunk_size =
+            std::min(size - done, _max_chunk_size);
+        const vk::DeviceSize staging_offset = reserve(chunk_size, 4);
+
+        memcpy(
+            _mapped_memory + staging_offset,
+            (const byte*) data + done,
+            chunk_size
+        );
+        _buffer_copies.push_back(
+            { buffer, { staging_offset, offset + done, chunk_size } }
+        );
+        done += chunk_size;
+    }
+}
+
+void VulkanStagingBuffer::upload_to_image(
+    const void* const  data,
+    const uint32       block_size,
+    const uint32       block_extent,
+    VulkanImage* const image
+) {
+    const uint32 level_count = image->mip_levels;
+
+    // Region covering rows [y, y + height) of a mip level
+    const auto copy_region = [](const vk::DeviceSize buffer_offset,
+                                const uint32         level,
+                                const uint32         y,
+                                const uint32         width,
+                                const uint32         height) {
+        vk::BufferImageCopy region {};
+        region.setBufferOffset(buffer_offset);
+        region.setBufferRowLength(0);   // Tightly packed
+        region.setBufferImageHeight(0); // Tightly packed
+        region.imageSubresource.setAspectMask(vk::ImageAspectFlagBits::eColor);
+        region.imageSubresource.setMipLevel(level);
+        region.imageSubresource.setBaseArrayLayer(0);
+        region.imageSubresource.setLayerCount(1);
+        region.setImageOffset({ 0, (int32) y, 0 });
+        region.setImageExtent({ width, height, 1 });
+        return region;
+    };
+
+    // Level sizes, in blocks. A 16k texture has 15 levels.
+    SmallVector<uint32, 16> block_columns {};
+    SmallVector<uint32, 16> block_rows {};
+    block_columns.resize(level_count);
+    block_rows.resize(level_count);
+    vk::DeviceSize total_size = 0;
+    for (uint32 level = 0; level < level_count; level++) {
+        const uint32 width  = std::max(image->width >> level, 1u);
+        const uint32 height = std::max(image->height >> level, 1u);
+        block_columns[level] = (width + block_extent - 1) / block_extent;
+        block_rows[level]    = (height + block_extent - 1) / block_extent;
+        total_size += (vk::DeviceSize) block_columns[level] *
+                      block_rows[level] * block_size;
+    }
+    _uploaded_bytes += total_size;
+
+    // Offsets must be a multiple of both block size and 4
+    const vk::DeviceSize alignment = 4 * block_size;
+
+    if (total_size <= _max_chunk_size) {
+        // Whole chain at once, single copy command
+        const vk::DeviceSize staging_offset = reserve(total_size, alignment);
+        memcpy(_mapped_memory + staging_offset, data, total_size);
+
+        SmallVector<vk::BufferImageCopy, 16> regions {};
+        regions.reserve(level_count);
+        vk::DeviceSize level_offset = staging_offset;
+        for (uint32 level = 0; level < level_count; level++) {
+            regions.push_back(copy_region(
+                level_offset,
+                level,
+                0,
+                std::max(image->width >> level, 1u),
+                std::max(image->height >> level, 1u)
+            ));
+            level_offset += (vk::DeviceSize) block_columns[level] *
+                            block_rows[level] * block_size;
+        }
+
+        transfer_command_buffer().copyBufferToImage(
+            _buffer->handle,
+            image->handle,
+            vk::ImageLayout::eTransferDstOptimal,
+            (uint32) regions.size(),
+            regions.data()
+        );
+    } else {
+        // Stream whole block rows, level by level
+        auto level_data = (const byte*) data;
+        for (uint32 level = 0; level < level_count; level++) {
+            const uint32 width  = std::max(image->width >> level, 1u);
+            const uint32 height = std::max(image->height >> level, 1u);
+            const vk::DeviceSize row_size =
+                (vk::DeviceSize) block_columns[level] * block_size;
+            const uint32 rows_per_chunk = (uint32
+            ) std::max(_max_chunk_size / row_size, (vk::DeviceSize) 1);
+
+            for (uint32 row = 0; row < block_rows[level];
+                 row += rows_per_chunk) {
+                const uint32 row_count =
+                    std::min(rows_per_chunk, block_rows[level] - row);
+                const vk::DeviceSize chunk_size = row_count * row_size;
+                const vk::DeviceSize staging_offset =
+                    reserve(chunk_size, alignment);
+
+                memcpy(
+                    _mapped_memory + staging_offset,
+                    level_data + row * row_size,
+                    chunk_size
+                );
+
+                // Last row of blocks might stick out of the level
+                const uint32 y = row * block_extent;
+                const auto   region = copy_region(
+                    staging_offset,
+                    level,
+                    y,
+                    width,
+                    std::min(row_count * block_extent, height - y)
+                );
+                transfer_command_buffer().copyBufferToImage(
+                    _buffer->handle,
+                    image->handle,
+                    vk::ImageLayout::eTransferDstOptimal,
+                    1,
+                    &region
+                );
+            }
+            level_data += block_rows[level] * row_size;
+        }
+    }
+
+    // Pass the image to the graphics queue. Done once all chunks are
+    // recorded, so only the last batch of the upload does it.
+    if (!_transfer_ownership) return;
+
+    vk::ImageMemoryBarrier barrier {};
+    barrier.setImage(image->handle);
+    barrier.setOldLayout(vk::ImageLayout::eTransferDstOptimal);
+    barrier.setNewLayout(vk::ImageLayout::eTransferDstOptimal);
+    barrier.setSrcQueueFamilyIndex(_transfer_family);
+    barrier.setDstQueueFamilyIndex(_graphics_family);
+    barrier.subresourceRange.setAspectMask(vk::ImageAspectFlagBits::eColor);
+    barrier.subresourceRange.setBaseMipLevel(0);
+    barrier.subresourceRange.setLevelCount(VK_REMAINING_MIP_LEVELS);
+    barrier.subresourceRange.setBaseArrayLayer(0);
+    barrier.subresourceRange.setLayerCount(1);
+
+    // Release
+    barrier.setSrcAccessMask(vk::AccessFlagBits::eTransferWrite);
+    transfer_command_buffer().pipelineBarrier(
+        vk::PipelineStageFlagBits::eTransfer,
+        vk::PipelineStageFlagBits::eBottomOfPipe,
+        vk::DependencyFlags(),
+        0,
+        nullptr,
+        0,
+        nullptr,
+        1,
+        &barrier
+    );
+
+    // Acquire
+    barrier.setSrcAccessMask(vk::AccessFlagBits::eNone);
+    barrier.setDstAccessMask(
+        vk::AccessFlagBits::eTransferRead | vk::AccessFlagBits::eTransferWrite
+    );
+    graphics_command_buffer().pipelineBarrier(
+        vk::PipelineStageFlagBits::eAllCommands,
+        vk::PipelineStageFlagBits::eTransfer,
+        vk::DependencyFlags(),
+        0,
+        nullptr,
+        0,
+        nullptr,
+        1,
+        &barrier
+    );
+}
+
+vk::CommandBuffer VulkanStagingBuffer::transfer_command_buffer() {
+    if (!_recording) begin_batch();
+    return _batch.transfer_command_buffer;
+}
+vk::CommandBuffer VulkanStagingBuffer::graphics_command_buffer() {
+    if (!_recording) begin_batch();
+    return _batch.graphics_command_buffer;
+}
+
+void VulkanStagingBuffer::submit() {
+    if (!_recording) return;
+
+    // Record buffer copies now, with current buffer handles
+    record_buffer_copies();
+
+    // Make uploaded data visible to all later graphics queue work
+    vk::MemoryBarrier barrier {};
+    barrier.setSrcAccessMask(vk::AccessFlagBits::eMemoryWrite);
+    barrier.setDstAccessMask(
+        vk::AccessFlagBits::eTransferRead |
+        vk::AccessFlagBits::eTransferWrite |
+        vk::AccessFlagBits::eVertexAttributeRead |
+        vk::AccessFlagBits::eIndexRead | vk::AccessFlagBits::eUniformRead |
+        vk::AccessFlagBits::eShaderRead
+    );
+    _batch.graphics_command_buffer.pipelineBarrier(
+        vk::PipelineStageFlagBits::eAllCommands,
+        vk::PipelineStageFlagBits::eAllCommands,
+        vk::DependencyFlags(),
+        1,
+        &barrier,
+        0,
+        nullptr,
+        0,
+        nullptr
+    );
+
+    _batch.transfer_command_buffer.end();
+    _batch.graphics_command_buffer.end();
+
+    // Transfer part signals (ticket - 1)
+    const uint64                    transfer_value = _batch.ticket - 1;
+    vk::TimelineSemaphoreSubmitInfo transfer_timeline_info {};
+    transfer_timeline_info.setSignalSemaphoreValueCount(1);
+    transfer_timeline_info.setPSignalSemaphoreValues(&transfer_value);
+
+    vk::SubmitInfo transfer_submit_info {};
+    transfer_submit_info.setPNext(&transfer_timeline_info);
+    transfer_submit_info.setCommandBufferCount(1);
+    transfer_submit_info.setPCommandBuffers(&_batch.transfer_command_buffer);
+    transfer_submit_info.setSignalSemaphoreCount(1);
+    transfer_submit_info.setPSignalSemaphores(&_timeline);
+
+    // Graphics part waits on it & signals the ticket
+    const vk::PipelineStageFlags wait_stage =
+        vk::PipelineStageFlagBits::eAllCommands;
+    vk::TimelineSemaphoreSubmitInfo graphics_timeline_info {};
+    graphics_timeline_info.setWaitSemaphoreValueCount(1);
+    graphics_timeline_info.setPWaitSemaphoreValues(&transfer_value);
+    graphics_timeline_info.setSignalSemaphoreValueCount(1);
+    graphics_timeline_info.setPSignalSemaphoreValues(&_batch.ticket);
+
+    vk::SubmitInfo graphics_submit_info {};
+    graphics_submit_info.setPNext(&graphics_timeline_info);
+    graphics_submit_info.setWaitSemaphoreCount(1);
+    graphics_submit_info.setPWaitSemaphores(&_timeline);
+    graphics_submit_info.setPWaitDstStageMask(&wait_stage);
+    graphics_submit_info.setCommandBufferCount(1);
+    graphics_submit_info.setPCommandBuffers(&_batch.graphics_command_buffer);
+    graphics_submit_info.setSignalSemaphoreCount(1);
+    graphics_submit_info.setPSignalSemaphores(&_timeline);
+
+    try {
+        _device->transfer_queue.submit(transfer_submit_info, nullptr);
+        _device->graphics_queue.submit(graphics_submit_info, nullptr);
+    } catch (const vk::SystemError& e) {
+        Logger::fatal(RENDERER_VULKAN_LOG, e.what());
+    }
+
+    _submitted_ticket = _batch.ticket;
+    _submission_count++;
+    _submitted_batches.push_back(_batch);
+    _recording = false;
+}
+
+void VulkanStagingBuffer::reclaim() {
+    // Batches finish in submission order
+    const UploadTicket completed =
+        _device->handle().getSemaphoreCounterValue(_timeline);
+    uint32 finished = 0;
+    for (auto& batch : _submitted_batches) {
+        if (batch.ticket > completed) break;
+        _used -= batch.size;
+        _idle_batches.push_back(batch);
+        finished++;
+    }
+    _submitted_batches.erase(
+        _submitted_batches.begin(), _submitted_batches.begin() + finished
+    );
+
+    // Nothing in use, start from the beginning
+    if (_used == 0) _head = 0;
+}
+
+UploadTicket VulkanStagingBuffer::get_ticket() const {
+    return _recording ? _batch.ticket : _submitted_ticket;
+}
+
+bool VulkanStagingBuffer::is_complete(const UploadTicket ticket) const {
+    return _device->handle().getSemaphoreCounterValue(_timeline) >= ticket;
+}
+
+void VulkanStagingBuffer::wait(const UploadTicket ticket) {
+    if (ticket > _submitted_ticket) submit();
+
+    vk::SemaphoreWaitInfo wait_info {};
+    wait_info.setSemaphoreCount(1);
+    wait_info.setPSemaphores(&_timeline);
+    wait_info.setPValues(&ticket);
+    try {
+        auto result = _device->handle().waitSemaphores(wait_info, UINT64_MAX);
+        if (result != vk::Result::eSuccess)
+            Logger::fatal(RENDERER_VULKAN_LOG, "Upload ticket wait failed.");
+    } catch (const vk::SystemError& e) {
+        Logger::fatal(RENDERER_VULKAN_LOG, e.what());
+    }
+    reclaim();
+}
+
+// ///////////////////////////////////// //
+// VULKAN STAGING BUFFER PRIVATE METHODS //
+// ///////////////////////////////////// //
+
+vk::DeviceSize VulkanStagingBuffer::reserve(
+    const vk::DeviceSize size, const vk::DeviceSize alignment
+) {
+    if (size > _size)
+        Logger::fatal(
+            RENDERER_VULKAN_LOG,
+            "Staging region of ",
+            size,
+            " bytes doesn't fit into the staging ring."
+        );
+
+    while (true) {
+        // Place after the head, or wrap around to the start
+        vk::DeviceSize offset = get_aligned(_head, alignment);
+        if (offset + size > _size) offset = 0;
+
+        // Ring bytes taken (including any skipped at the end)
+        const vk::DeviceSize taken =
+            (offset >= _head) ? offset + size - _head : _size - _head + size;
+        if (_used + taken <= _size) {
+            // Make sure the batch using this space is being recorded
+            if (!_recording) begin_batch();
+            _head        = offset + size;
+            _used       += taken;
+            _batch.size += taken;
+            return offset;
+        }
+
+        // Ring is full, submit what we have & wait for space to free up
+        submit();
+        wait_for_oldest_batch();
+    }
+}
+
+void VulkanStagingBuffer::begin_batch() {
+    if (_idle_batches.empty()) {
+        Batch batch {};
+        batch.transfer_command_buffer =
+            _transfer_command_pool->allocate_command_buffer();
+        batch.graphics_command_buffer =
+            _command_pool->allocate_command_buffer();
+        _idle_batches.push_back(batch);
+    }
+
+    _batch = _idle_batches.back();
+    _idle_batches.pop_back();
+    _batch.ticket = _submitted_ticket + 2;
+    _batch.size   = 0;
+
+    vk::CommandBufferBeginInfo begin_info {};
+    begin_info.setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+    _batch.transfer_command_buffer.reset();
+    _batch.transfer_command_buffer.begin(begin_info);
+    _batch.graphics_command_buffer.reset();
+    _batch.graphics_command_buffer.begin(begin_info);
+    _recording = true;
+}
+
+void VulkanStagingBuffer::record_buffer_copies() {
+    if (_buffer_copies.empty()) return;
+
+    SmallVector<vk::BufferMemoryBarrier, 16> barriers {};
+    barriers.reserve(_buffer_copies.size());
+    for (const auto& copy : _buffer_copies) {
+        _batch.transfer_command_buffer.copyBuffer(
+            _buffer->handle, copy.buffer->handle, 1, &copy.region
+        );
+
+        vk::BufferMemoryBarrier barrier {};
+        barrier.setBuffer(copy.buffer->handle);
+        barrier.setOffset(copy.region.dstOffset);
+        barrier.setSize(copy.region.size);
+        barrier.setSrcQueueFamilyIndex(_transfer_family);
+        barrier.setDstQueueFamilyIndex(_graphics_family);
+        barriers.push_back(barrier);
+    }
+    _buffer_copies.clear();
+
+    // Pass written ranges to the graphics queue
+    if (!_transfer_ownership) return;
+
+    // Release
+    for (auto& barrier : barriers)
+        barrier.setSrcAccessMask(vk::AccessFlagBits::eTransferWrite);
+    _batch.transfer_command_buffer.pipelineBarrier(
+        vk::PipelineStageFlagBits::eTransfer,
+        vk::PipelineStageFlagBits::eBottomOfPipe,
+        vk::DependencyFlags(),
+        0,
+        nullptr,
+        (uint32) barriers.size(),
+        barriers.data(),
+        0,
+        nullptr
+    );
+
+    // Acquire
+    for (auto& barrier : barriers) {
+        barrier.setSrcAccessMask(vk::AccessFlagBits::eNone);
+        barrier.setDstAccessMask(
+            vk::AccessFlagBits::eTransferRead |
+            vk::AccessFlagBits::eTransferWrite |
+            vk::AccessFlagBits::eVertexAttributeRead |
+            vk::AccessFlagBits::eIndexRead | vk::AccessFlagBits::eUniformRead
+        );
+    }
+    _batch.graphics_command_buffer.pipelineBarrier(
+        vk::PipelineStageFlagBits::eAllCommands,
+        vk::PipelineStageFlagBits::eAllCommands,
+        vk::DependencyFlags(),
+        0,
+        nullptr,
+        (uint32) barriers.size(),
+        barriers.data(),
+        0,
+        nullptr
+    );
+}
+
+void VulkanStagingBuffer::wait_for_oldest_batch() {
+    if (_submitted_batches.empty()) return;
+    wait(_submitted_batches[0].ticket);
+}
@@ -0,0 +1,340 @@
+#include "resources/image.hpp"
+
+#include "platform/platform.hpp"
+
+#include <algorithm> // min, max, swap
+#include <cmath>     // pow
+#include <cstdint>   // INT32_MAX
+#include <cstdlib>   // abs
+#include <cstring>   // memcpy
+
+// Helper function forward declaration
+void downsample_level(
+    const uint8* const source,
+    const uint32       width,
+    const uint32       height,
+    uint8* const       destination
+);
+void compress_color_block(const uint8 block[16][4], uint8* const destination);
+void compress_alpha_block(const uint8 block[16][4], uint8* const destination);
+
+// //////////////////// //
+// IMAGE PUBLIC METHODS //
+// //////////////////// //
+
+Result<void, RuntimeError> Image::compress(const ImageFormat format) {
+    if (_format != ImageFormat::RGBA8)
+        return Failure("Only RGBA8 images can be compressed.");
+    if (format == ImageFormat::RGBA8)
+        return Failure("Requested format isn't block compressed.");
+
+    const auto size =
+        get_mip_chain_size(format, _width, _height, _mip_level_count);
+    auto compressed = new (MemoryTag::Resource) byte[size];
+
+    auto   source      = (const uint8*) _pixels;
+    auto   destination = (uint8*) compressed;
+    uint32 width       = _width;
+    uint32 height      = _height;
+    for (uint32 level = 0; level < _mip_level_count; level++) {
+        for (uint32 block_y = 0; block_y < height; block_y += 4) {
+            for (uint32 block_x = 0; block_x < width; block_x += 4) {
+                // Gather block pixels, edge pixels are repeated for blocks
+                // which don't fit into the level
+                uint8 block[16][4];
+                for (uint32 i = 0; i < 16; i++) {
+                    const uint32 x = std::min(block_x + i % 4, width - 1);
+                    const uint32 y = std::min(block_y + i / 4, height - 1);
+                    memcpy(block[i], source + (y * width + x) * 4, 4);
+                }
+
+                if (format == ImageFormat::BC3) {
+                    compress_alpha_block(block, destination);
+                    destination += 8;
+                }
+                compress_color_block(block, destination);
+                destination += 8;
+            }
+        }
+        source += (uint64) width * height * 4;
+        width  = std::max(width / 2, 1u);
+        height = std::max(height / 2, 1u);
+    }
+
+    release_pixels();
+    _pixels = compressed;
+    _format = format;
+    return {};
+}
+
+byte* Image::create_mip_chain(
+    const byte* const pixels, const uint32 width, const uint32 height
+) {
+    const auto level_count = get_mip_level_count(width, height);
+    const auto size =
+        get_mip_chain_size(ImageFormat::RGBA8, width, height, level_count);
+    auto chain = new (MemoryTag::Resource) byte[size];
+    memcpy(chain, pixels, get_level_size(ImageFormat::RGBA8, width, height));
+
+    // Each level is computed from the previous one
+    auto   source       = (uint8*) chain;
+    uint32 level_width  = width;
+    uint32 level_height = height;
+    for (uint32 level = 1; level < level_count; level++) {
+        auto destination = source + (uint64) level_width * level_height * 4;
+        downsample_level(source, level_width, level_height, destination);
+
+        source       = destination;
+        level_width  = std::max(level_width / 2, 1u);
+        level_height = std::max(level_height / 2, 1u);
+    }
+
+    return chain;
+}
+
+uint32 Image::get_mip_level_count(const uint32 width, const uint32 height) {
+    uint32 level_count = 1;
+    for (uint32 size = std::max(width, height); size > 1; size /= 2)
+        level_count++;
+    return level_count;
+}
+
+uint32 Image::get_block_size(const ImageFormat format) {
+    switch (format) {
+    case ImageFormat::BC1: return 8;
+    case ImageFormat::BC3: return 16;
+    default: return 4;
+    }
+}
+uint32 Image::get_block_extent(const ImageFormat format) {
+    return format == ImageFormat::RGBA8 ? 1 : 4;
+}
+
+uint64 Image::get_level_size(
+    const ImageFormat format, const uint32 width, const uint32 height
+) {
+    const uint64 extent = get_block_extent(format);
+    return ((width + extent - 1) / extent) * ((height + extent - 1) / extent) *
+           get_block_size(format);
+}
+uint64 Image::get_mip_chain_size(
+    const ImageFormat format,
+    const uint32      width,
+    const uint32      height,
+    const uint32      level_count
+) {
+    uint64 size = 0;
+    for (uint32 level = 0; level < level_count; level++)
+        size += get_level_size(
+            format,
+            std::max(width >> level, 1u),
+            std::max(height >> level, 1u)
+        );
+    return size;
+}
+
+// ///////////////////// //
+// IMAGE PRIVATE METHODS //
+// ///////////////////// //
+
+void Image::release_pixels() {
+    if (_file_mapping) {
+        Platform::Memory::unmap_file(_file_mapping, _file_mapping_size);
+        _file_mapping = nullptr;
+    } else delete[] _pixels;
+    _pixels = nullptr;
+}
+
+// ////////////////////// //
+// IMAGE HELPER FUNCTIONS //
+// ////////////////////// //
+
+// sRGB conversion tables, linear values are quantized to 12 bits
+struct SrgbTables {
+    float32 to_linear[256];
+    uint8   to_srgb[4096];
+
+    SrgbTables() {
+        for (uint32 i = 0; i < 256; i++) {
+            const float32 value = i / 255.0f;
+            to_linear[i] =
+                value <= 0.04045f ? value / 12.92f
+                                  : std::pow((value + 0.055f) / 1.055f, 2.4f);
+        }
+        for (uint32 i = 0; i < 4096; i++) {
+            const float32 value = i / 4095.0f;
+            const float32 srgb =
+                value <= 0.0031308f
+                    ? value * 12.92f
+                    : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+            to_srgb[i] = (uint8) (srgb * 255.0f + 0.5f);
+        }
+    }
+};
+const SrgbTables& srgb_tables() {
+    static const SrgbTables tables {};
+    return tables;
+}
+
+void downsample_level(
+    const uint8* const source,
+    const uint32       width,
+    const uint32       height,
+    uint8* const       destination
+) {
+    const auto& tables = srgb_tables();
+
+    const uint32 new_width  = std::max(width / 2, 1u);
+    const uint32 new_height = std::max(height / 2, 1u);
+    for (uint32 y = 0; y < new_height; y++) {
+        // Odd dimensions repeat the last row / column
+        const auto row_0 = source + std::min(2 * y, height - 1) * width * 4;
+        const auto row_1 =
+            source + std::min(2 * y + 1, height - 1) * width * 4;
+        for (uint32 x = 0; x < new_width; x++) {
+            const uint32 x_0 = std::min(2 * x, width - 1) * 4;
+            const uint32 x_1 = std::min(2 * x + 1, width - 1) * 4;
+            auto         out = destination + (y * new_width + x) * 4;
+
+            // Colors are averaged in linear space
+            for (uint32 c = 0; c < 3; c++) {
+                const float32 sum =
+                    tables.to_linear[row_0[x_0 + c]] +
+                    tables.to_linear[row_0[x_1 + c]] +
+                    tables.to_linear[row_1[x_0 + c]] +
+                    tables.to_linear[row_1[x_1 + c]];
+                out[c] =
+                    tables.to_srgb[(uint32) (sum * 0.25f * 4095.0f + 0.5f)];
+            }
+            // Alpha is linear already
+            out[3] = (uint8) ((row_0[x_0 + 3] + row_0[x_1 + 3] +
+                               row_1[x_0 + 3] + row_1[x_1 + 3] + 2) /
+                              4);
+        }
+    }
+}
+
+uint16 pack_565(const uint8 color[3]) {
+    return (uint16) ((color[0] * 31 + 127) / 255) << 11 |
+           (uint16) ((color[1] * 63 + 127) / 255) << 5 |
+           (uint16) ((color[2] * 31 + 127) / 255);
+}
+void unpack_565(const uint16 packed, uint8 color[3]) {
+    const uint8 r = (packed >> 11) & 31;
+    const uint8 g = (packed >> 5) & 63;
+    const uint8 b = packed & 31;
+    color[0]      = (uint8) (r << 3 | r >> 2);
+    color[1]      = (uint8) (g << 2 | g >> 4);
+    color[2]      = (uint8) (b << 3 | b >> 2);
+}
+
+void compress_color_block(const uint8 block[16][4], uint8* const destination) {
+    // Endpoints are corners of the color bounding box
+    uint8 min[3] = { 255, 255, 255 };
+    uint8 max[3] = { 0, 0, 0 };
+    int32 mean[3] = { 0, 0, 0 };
+    for (uint32 i = 0; i < 16; i++) {
+        for (uint32 c = 0; c < 3; c++) {
+            min[c] = std::min(min[c], block[i][c]);
+            max[c] = std::max(max[c], block[i][c]);
+            mean[c] += block[i][c];
+        }
+    }
+
+    // Pick the box diagonal closest to the main color axis, by flipping
+    // channels which are anti-correlated with the widest one
+    uint32 widest = 0;
+    for (uint32 c = 1; c < 3; c++)
+        if (max[c] - min[c] > max[widest] - min[widest]) widest = c;
+    for (uint32 c = 0; c < 3; c++) {
+        if (c == widest) continue;
+        int32 covariance = 0;
+        for (uint32 i = 0; i < 16; i++)
+            covariance += (block[i][widest] * 16 - mean[widest]) *
+                          (block[i][c] * 16 - mean[c]);
+        if (covariance < 0) std::swap(min[c], max[c]);
+    }
+
+    // Inset endpoints slightly, extremes are rarely hit exactly
+    for (uint32 c = 0; c < 3; c++) {
+        const int32 inset = ((int32) max[c] - (int32) min[c]) / 16;
+        min[c]            = (uint8) (min[c] + inset);
+        max[c]            = (uint8) (max[c] - inset);
+    }
+
+    // 4 color mode requires color_0 > color_1
+    uint16 color_0 = pack_565(max);
+    uint16 color_1 = pack_565(min);
+    if (color_0 < color_1) std::swap(color_0, color_1);
+
+    uint32 indices = 0;
+    if (color_0 != color_1) {
+        uint8 palette[4][3];
+        unpack_565(color_0, palette[0]);
+        unpack_565(color_1, palette[1]);
+        for (uint32 c = 0; c < 3; c++) {
+            palette[2][c] = (uint8) ((2 * palette[0][c] + palette[1][c]) / 3);
+            palette[3][c] = (uint8) ((palette[0][c] + 2 * palette[1][c]) / 3);
+        }
+
+        for (uint32 i = 0; i < 16; i++) {
+            uint32 best_index    = 0;
+            int32  best_distance = INT32_MAX;
+            for (uint32 p = 0; p < 4; p++) {
+                int32 distance = 0;
+                for (uint32 c = 0; c < 3; c++) {
+                    const int32 d = (int32) block[i][c] - palette[p][c];
+                    distance += d * d;
+                }
+                if (distance < best_distance) {
+                    best_distance = distance;
+                    best_index    = p;
+                }
+            }
+            indices |= best_index << (2 * i);
+        }
+    }
+
+    // Little endian
+    destination[0] = (uint8) color_0;
+    destination[1] = (uint8) (color_0 >> 8);
+    destination[2] = (uint8) color_1;
+    destination[3] = (uint8) (color_1 >> 8);
+    for (uint32 i = 0; i < 4; i++)
+        destination[4 + i] = (uint8) (indices >> (8 * i));
+}
+
+void compress_alpha_block(const uint8 block[16][4], uint8* const destination) {
+    uint8 alpha_0 = 0;
+    uint8 alpha_1 = 255;
+    for (uint32 i = 0; i < 16; i++) {
+        alpha_0 = std::max(alpha_0, block[i][3]);
+        alpha_1 = std::min(alpha_1, block[i][3]);
+    }
+
+    // 8 alpha mode (alpha_0 > alpha_1), 6 values interpolated in between
+    uint64 indices = 0;
+    if (alpha_0 != alpha_1) {
+        uint8 palette[8] = { alpha_0, alpha_1 };
+        for (uint32 p = 2; p < 8; p++)
+            palette[p] = (uint8) (((8 - p) * alpha_0 + (p - 1) * alpha_1) / 7);
+
+        for (uint32 i = 0; i < 16; i++) {
+            uint64 best_index    = 0;
+            int32  best_distance = INT32_MAX;
+            for (uint32 p = 0; p < 8; p++) {
+                const int32 distance = std::abs(block[i][3] - palette[p]);
+                if (distance < best_distance) {
+                    best_distance = distance;
+                    best_index    = p;
+                }
+            }
+            indices |= best_index << (3 * i);
+        }
+    }
+
+    destination[0] = alpha_0;
+    destination[1] = alpha_1;
+    for (uint32 i = 0; i < 6; i++)
+        destination[2 + i] = (uint8) (indices >> (8 * i));
+}
@@ -1,7 +1,7 @@
 #include "resources/loaders/image_loader.hpp"
 
 #include "systems/resource_system.hpp"
-#include "resources/image.hpp"
+#include "resources/vktex.hpp"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -18,14 +18,32 @@ ImageLoader::~ImageLoader() {}
 // /////////////////////////// //
 
 Result<Resource*, RuntimeError> ImageLoader::load(const String name) {
-    // If name is not provided with an extension use default extension
     String file_name = name;
-    if (file_name.split('.').size() < 2) file_name = file_name + ".png";
     file_name.to_lower();
+    const auto name_parts    = file_name.split('.');
+    const bool has_extension = name_parts.size() >= 2;
+
+    // Compute texture directory path
+    const String directory =
+        ResourceSystem::base_path + "/" + _type_path + "/";
+
+    // If name is not provided with an extension prefer the packed engine
+    // format, falling back to the source image
+    if (!has_extension || name_parts.back() == "vktex") {
+        if (!has_extension) file_name = file_name + ".vktex";
+        auto image = load_vktex(name, directory + file_name);
+        if (image) return image;
+
+        if (has_extension) {
+            String error_message = "Failed to load texture image.";
+            Logger::error(RESOURCE_LOG, error_message);
+            return Failure(error_message);
+        }
+        file_name = name_parts[0] + ".png";
+    }
 
     // Compute full path
-    String file_path =
-        ResourceSystem::base_path + "/" + _type_path + "/" + file_name;
+    String file_path = directory + file_name;
 
     // Required channel cont
     const uint32 req_channel_count = 4;
@@ -59,9 +77,22 @@ Result<Resource*, RuntimeError> ImageLoader::load(const String name) {
         }
     }
 
+    // Generate mip levels on the CPU, so the renderer doesn't have to
+    auto mip_chain = Image::create_mip_chain(
+        (byte*) image_pixels, image_width, image_height
+    );
+    stbi_image_free(image_pixels);
+
     // Return image data
     Image* image = new (MemoryTag::Resource) Image(
-        name, image_width, image_height, req_channel_count, (byte*) image_pixels
+        name,
+        image_width,
+        image_height,
+        req_channel_count,
+        has_transparency,
+        mip_chain,
+        ImageFormat::RGBA8,
+        Image::get_mip_level_count(image_width, image_height)
     );
     image->full_path   = file_path;
     image->loader_type = ResourceType::Image;
@@ -73,3 +104,56 @@ void ImageLoader::unload(Resource* resource) {
     Image* res = (Image*) resource;
     delete res;
 }
+
+// //////////////////////////// //
+// IMAGE LOADER PRIVATE METHODS //
+// //////////////////////////// //
+
+Image* ImageLoader::load_vktex(const String& name, const String& file_path) {
+    uint64      file_size;
+    const void* file = Platform::Memory::map_file(file_path.c_str(), file_size);
+    if (file == nullptr) return nullptr;
+
+    auto header = VktexFile::validate(file, file_size);
+    if (header.has_error()) {
+        Logger::warning(
+            RESOURCE_LOG,
+            "Invalid texture file \"",
+            file_path,
+            "\" (",
+            header.error().what(),
+            ")."
+        );
+        Platform::Memory::unmap_file(file, file_size);
+        return nullptr;
+    }
+
+    // Pixels are used straight from the mapped pages, no decoding required
+    const auto pixels = (const byte*) file + VktexFile::data_offset;
+#ifndef NDEBUG
+    if (VktexFile::hash(pixels, header.value()->data_size) !=
+        header.value()->content_hash) {
+        Logger::warning(
+            RESOURCE_LOG, "Texture file \"", file_path, "\" is corrupted."
+        );
+        Platform::Memory::unmap_file(file, file_size);
+        return nullptr;
+    }
+#endif
+
+    Image* image = new (MemoryTag::Resource) Image(
+        name,
+        header.value()->width,
+        header.value()->height,
+        header.value()->channel_count,
+        header.value()->has_transparency != 0,
+        pixels,
+        (ImageFormat) header.value()->format,
+        header.value()->mip_level_count,
+        file,
+        file_size
+    );
+    image->full_path   = file_path;
+    image->loader_type = ResourceType::Image;
+    return image;
+}
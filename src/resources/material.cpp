@@ -6,7 +6,14 @@
 Material::Material(
     const String name, Shader* const shader, const glm::vec4 diffuse_color
 )
-    : _name(name), _shader(shader), _diffuse_color(diffuse_color) {}
+    : _name(name), _shader(shader), _diffuse_color(diffuse_color) {
+    // Resolve uniforms once, so that per frame updates skip the lookup
+    _uniform_index.projection      = find_uniform_index("projection"_uid);
+    _uniform_index.view            = find_uniform_index("view"_uid);
+    _uniform_index.model           = find_uniform_index("model"_uid);
+    _uniform_index.diffuse_color   = find_uniform_index("diffuse_color"_uid);
+    _uniform_index.diffuse_texture = find_uniform_index("diffuse_texture"_uid);
+}
 Material::~Material() {}
 
 // /////////////////////// //
@@ -16,55 +23,36 @@ Material::~Material() {}
 #define BUILTIN_MATERIAL_SHADER_NAME "builtin.material_shader"
 #define BUILTIN_UI_SHADER_NAME "builtin.ui_shader"
 
-#define set_uniform(uniform_name, uniform_value)                               \
+// Missing uniforms are reported once, by find_uniform_index
+#define set_uniform(uniform, uniform_value)                                    \
     {                                                                          \
-        auto uniform_id_res = _shader->get_uniform_index(uniform_name);        \
-        if (uniform_id_res.has_error()) {                                      \
-            Logger::error(                                                     \
-                MATERIAL_LOG,                                                  \
-                "Shader set_uniform method failed. No uniform is named \"",    \
-                uniform_name,                                                  \
-                "\". Nothing was done."                                        \
-            );                                                                 \
-            return;                                                            \
-        }                                                                      \
-        auto uniform_id = uniform_id_res.value();                              \
+        const auto uniform_id = _uniform_index.uniform;                        \
+        if (uniform_id == invalid_uniform_index) return;                       \
         auto set_result = _shader->set_uniform(uniform_id, &uniform_value);    \
         if (set_result.has_error()) {                                          \
             Logger::error(                                                     \
                 MATERIAL_LOG,                                                  \
-                "Shader set_uniform method failed for \"",                     \
-                uniform_name,                                                  \
-                "\". Nothing was done"                                         \
+                "Shader set_uniform method failed for \"" #uniform "\". ",     \
+                "Nothing was done"                                             \
             );                                                                 \
             return;                                                            \
         }                                                                      \
     }
-#define set_sampler(sampler_name, texture)                                     \
+#define set_sampler(sampler, texture)                                          \
     {                                                                          \
-        auto sampler_id_res = _shader->get_uniform_index(sampler_name);        \
-        if (sampler_id_res.has_error()) {                                      \
-            Logger::error(                                                     \
-                MATERIAL_LOG,                                                  \
-                "Shader set_sampler method failed. No sampler is named \"",    \
-                sampler_name,                                                  \
-                "\". Nothing was done."                                        \
-            );                                                                 \
-            return;                                                            \
-        }                                                                      \
-        auto sampler_id = sampler_id_res.value();                              \
+        const auto sampler_id = _uniform_index.sampler;                        \
+        if (sampler_id == invalid_uniform_index) return;                       \
         auto set_result = _shader->set_sampler(sampler_id, texture);           \
         if (set_result.has_error()) {                                          \
             Logger::error(                                                     \
                 MATERIAL_LOG,                                                  \
-                "Shader set_sampler method failed for \"",                     \
-                sampler_name,                                                  \
-                "\". Nothing was done"                                         \
+                "Shader set_sampler method failed for \"" #sampler "\". ",     \
+                "Nothing was done"                                             \
             );                                                                 \
             return;                                                            \
         }                                                                      \
     }
-#define set_uniform_s(uniform) set_uniform(#uniform, uniform)
+#define set_uniform_s(uniform) set_uniform(uniform, uniform)
 
 void Material::apply_global(const glm::mat4 projection, const glm::mat4 view) {
     // Apply globals
@@ -85,8 +73,28 @@ void Material::apply_instance() {
 
     // Apply locals
     _shader->bind_instance(internal_id.value());
-    set_uniform("diffuse_color", _diffuse_color);
-    set_sampler("diffuse_texture", _diffuse_map.texture);
+    set_uniform(diffuse_color, _diffuse_color);
+    set_sampler(diffuse_texture, _diffuse_map.texture);
     _shader->apply_instance();
 }
-void Material::apply_local(const glm::mat4 model) { set_uniform_s(model); }
\ No newline at end of file
+void Material::apply_local(const glm::mat4 model) { set_uniform_s(model); }
+
+// //////////////////////// //
+// MATERIAL PRIVATE METHODS //
+// //////////////////////// //
+
+uint16 Material::find_uniform_index(const StringId id) const {
+    auto result = _shader->get_uniform_index(id);
+    if (result.has_error()) {
+        Logger::error(
+            MATERIAL_LOG,
+            "Material \"",
+            _name,
+            "\" shader has no uniform with id ",
+            id,
+            ". Uniform won't be set."
+        );
+        return invalid_uniform_index;
+    }
+    return result.value();
+}
\ No newline at end of file
@@ -78,7 +78,7 @@ void Shader::apply_instance() {}
 uint32 Shader::acquire_instance_resources() { return -1; }
 void   Shader::release_instance_resources(uint32 instance_id) {}
 
-Result<uint16, InvalidArgument> Shader::get_uniform_index(const String name) {
+Result<uint16, InvalidArgument> Shader::get_uniform_index(const StringId name) {
     auto it = _uniforms_hash.find(name);
     if (it == _uniforms_hash.end())
         return Failure(InvalidArgument(
@@ -88,7 +88,7 @@ Result<uint16, InvalidArgument> Shader::get_uniform_index(const String name) {
 }
 
 Result<void, InvalidArgument> Shader::set_sampler(
-    const String name, const Texture* const texture
+    const StringId name, const Texture* const texture
 ) {
     return set_uniform<const Texture>(name, texture);
 }
@@ -173,7 +173,7 @@ void Shader::add_uniform(
     }
 
     _uniforms.push_back(entry);
-    _uniforms_hash[config.name] = entry.index;
+    _uniforms_hash[StringId::intern(config.name)] = entry.index;
 }
 
 // /////////////////////// //
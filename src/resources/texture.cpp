@@ -1,13 +1,39 @@
 #include "resources/texture.hpp"
 
 Texture::Texture(
-    const String name,
-    const int32  width,
-    const int32  height,
-    const int32  channel_count,
-    const bool   has_transparency
+    const String      name,
+    const int32       width,
+    const int32       height,
+    const int32       channel_count,
+    const bool        has_transparency,
+    const ImageFormat format,
+    const uint32      mip_level_count
 )
     : _name(name), _width(width), _height(height),
-      _channel_count(channel_count), _has_transparency(has_transparency) {
-    _total_size = width * height * channel_count;
+      _channel_count(channel_count), _has_transparency(has_transparency),
+      _format(format), _mip_level_count(mip_level_count) {
+    _total_size =
+        Image::get_mip_chain_size(format, width, height, mip_level_count);
+}
+
+// ////////////////////// //
+// TEXTURE PUBLIC METHODS //
+// ////////////////////// //
+
+void Texture::set_description(
+    const int32       width,
+    const int32       height,
+    const int32       channel_count,
+    const bool        has_transparency,
+    const ImageFormat format,
+    const uint32      mip_level_count
+) {
+    _width            = width;
+    _height           = height;
+    _channel_count    = channel_count;
+    _has_transparency = has_transparency;
+    _format           = format;
+    _mip_level_count  = mip_level_count;
+    _total_size =
+        Image::get_mip_chain_size(format, width, height, mip_level_count);
 }
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "resources/vktex.hpp"
+
+#include <cstring> // memset
+#include <fstream>
+
+// ///////////////////////// //
+// VKTEX FILE PUBLIC METHODS //
+// ///////////////////////// //
+
+Result<void, RuntimeError> VktexFile::write(
+    const String& file_path, Image* const image
+) {
+    const auto pixels    = image->pixels();
+    const auto data_size = image->get_size();
+
+    Header header;
+    memset(&header, 0, sizeof(Header));
+    header.magic            = magic;
+    header.version          = version;
+    header.width            = image->width;
+    header.height           = image->height;
+    header.mip_level_count  = image->mip_level_count;
+    header.format           = (uint8) image->format();
+    header.channel_count    = image->channel_count;
+    header.has_transparency = image->has_transparency;
+    header.data_size        = data_size;
+    header.content_hash     = hash(pixels, data_size);
+
+    std::ofstream file { file_path,
+                         std::ios::out | std::ios::binary | std::ios::trunc };
+    if (!file.is_open()) return Failure("Failed to open file: " + file_path);
+
+    // Header is padded to data offset
+    char padding[data_offset] {};
+    file.write((const char*) &header, sizeof(Header));
+    file.write(padding, data_offset - sizeof(Header));
+    file.write(pixels, data_size);
+    file.close();
+
+    if (file.fail()) return Failure("Failed to write file: " + file_path);
+    return {};
+}
+
+Result<const VktexFile::Header*, RuntimeError> VktexFile::validate(
+    const void* const data, const uint64 size
+) {
+    if (size < data_offset) return Failure("File too small for a header.");
+
+    const auto header = (const Header*) data;
+    if (header->magic != magic) return Failure("Not a vktex file.");
+    if (header->version != version)
+        return Failure("Unsupported vktex version.");
+    if (header->format > (uint8) ImageFormat::BC3)
+        return Failure("Unknown pixel format.");
+    if (header->width == 0 || header->height == 0 ||
+        header->mip_level_count == 0 ||
+        header->mip_level_count >
+            Image::get_mip_level_count(header->width, header->height))
+        return Failure("Invalid image dimensions.");
+
+    const auto expected_size = Image::get_mip_chain_size(
+        (ImageFormat) header->format,
+        header->width,
+        header->height,
+        header->mip_level_count
+    );
+    if (header->data_size != expected_size ||
+        size - data_offset < header->data_size)
+        return Failure("Pixel data size mismatch.");
+
+    return header;
+}
+
+uint64 VktexFile::hash(const void* const data, const uint64 size) {
+    auto   bytes = (const uint8*) data;
+    uint64 hash  = 0xcbf29ce484222325;
+    for (uint64 i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3;
+    }
+    return hash;
+}
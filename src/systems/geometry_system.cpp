@@ -74,7 +74,7 @@ void GeometrySystem::release(Geometry* geometry) {
     // Is the geometry still need, if not release it
     auto id = geometry->id.value();
     if (ref.auto_release && ref.reference_count < 1) {
-        _material_system->release(ref.handle->material()->name);
+        _material_system->release(ref.handle->material()->name());
         _renderer->destroy_geometry(ref.handle);
         delete ref.handle;
         _registered_geometries.erase(geometry->id.value());
@@ -90,6 +90,9 @@ void GeometrySystem::release(Geometry* geometry) {
 void GeometrySystem::create_default_geometries() {
     float f = 10.0f;
 
+    // Upload both together
+    _renderer->begin_upload_batch();
+
     // === Default for 3D ===
     Vector<Vertex> vertices = {
         { glm::vec3(-0.5f * f, -0.5f * f, 0.0f), glm::vec2(0.0f, 0.0f) },
@@ -120,4 +123,6 @@ void GeometrySystem::create_default_geometries() {
         new (MemoryTag::Resource) Geometry(_default_geometry_name + "2d");
     _renderer->create_geometry(_default_2d_geometry, vertices2d, indices2d);
     _default_2d_geometry->material = _material_system->default_material();
+
+    _renderer->end_upload_batch();
 }
\ No newline at end of file
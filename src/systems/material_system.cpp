@@ -9,7 +9,8 @@ MaterialSystem::MaterialSystem(
     ShaderSystem* const   shader_system
 )
     : _renderer(renderer), _resource_system(resource_system),
-      _texture_system(texture_system), _shader_system(shader_system) {
+      _texture_system(texture_system), _shader_system(shader_system),
+      _materials(_max_material_count, MemoryTag::MaterialInstance) {
     Logger::trace(MATERIAL_SYS_LOG, "Creating material system.");
 
     if (_max_material_count == 0)
@@ -37,7 +38,7 @@ MaterialSystem::~MaterialSystem() {
 // MATERIAL SYSTEM PUBLIC METHODS //
 // ////////////////////////////// //
 
-Material* MaterialSystem::acquire(const String name) {
+Material* MaterialSystem::acquire(const StringView name) {
     Logger::trace(MATERIAL_SYS_LOG, "Material \"", name, "\" requested.");
 
     // Check name validity
@@ -55,23 +56,23 @@ Material* MaterialSystem::acquire(const String name) {
         Logger::trace(MATERIAL_SYS_LOG, "Default material acquired.");
         return _default_material;
     }
-    if (name.compare_ci(_default_material_name) == 0) {
+    const StringId id { name };
+    if (id == _default_material_id) {
         return _default_material;
         Logger::trace(MATERIAL_SYS_LOG, "Default material acquired.");
     }
 
-    String s = name;
-    s.to_lower();
-    auto ref = _registered_materials.find(s);
+    auto ref = _registered_materials.find(id);
 
     if (ref != _registered_materials.end()) {
         ref->second.reference_count++;
         Logger::trace(MATERIAL_SYS_LOG, "Material acquired.");
-        return ref->second.handle;
+        return _materials.get(ref->second.handle);
     }
 
     // No material under this name found; load form resource system
-    auto config_result = _resource_system->load(name, ResourceType::Material);
+    auto config_result =
+        _resource_system->load(String(name), ResourceType::Material);
     if (config_result.has_error()) {
         Logger::error(
             MATERIAL_SYS_LOG,
@@ -89,13 +90,14 @@ Material* MaterialSystem::acquire(const String name) {
     auto material_ref = material_result.value();
 
     // Register created material
-    _registered_materials[name] = material_ref;
+    StringId::intern(name);
+    _registered_materials[id] = material_ref;
 
     // Free config
     _resource_system->unload(material_config);
 
     Logger::trace(MATERIAL_SYS_LOG, "Material \"", name, "\" acquired.");
-    return material_ref.handle;
+    return _materials.get(material_ref.handle);
 }
 Material* MaterialSystem::acquire(const MaterialConfig config) {
     Logger::trace(
@@ -103,8 +105,7 @@ Material* MaterialSystem::acquire(const MaterialConfig config) {
     );
 
     // Check name validity
-    String name = config.name;
-    name.to_lower();
+    const String& name = config.name;
     if (name.length() > Material::max_name_length) {
         Logger::error(
             MATERIAL_SYS_LOG,
@@ -119,13 +120,14 @@ Material* MaterialSystem::acquire(const MaterialConfig config) {
         Logger::trace(MATERIAL_SYS_LOG, "Default material acquired.");
         return _default_material;
     }
-    if (name.compare(_default_material_name) == 0) {
+    const StringId id { name };
+    if (id == _default_material_id) {
         Logger::trace(MATERIAL_SYS_LOG, "Default material acquired.");
         return _default_material;
     }
 
     // Get reference
-    auto ref = _registered_materials.find(name);
+    auto ref = _registered_materials.find(id);
     if (ref == _registered_materials.end()) {
         // Create material
         auto result = create_material(config);
@@ -135,33 +137,32 @@ Material* MaterialSystem::acquire(const MaterialConfig config) {
         auto material_ref = result.value();
 
         // Register created material
-        _registered_materials[name] = material_ref;
+        StringId::intern(name);
+        _registered_materials[id] = material_ref;
 
         Logger::trace(
             MATERIAL_SYS_LOG, "Material \"", config.name, "\" acquired."
         );
-        return material_ref.handle;
+        return _materials.get(material_ref.handle);
     }
     ref->second.reference_count++;
 
     Logger::trace(MATERIAL_SYS_LOG, "Material \"", config.name, "\" acquired.");
-    return ref->second.handle;
+    return _materials.get(ref->second.handle);
 }
 
-void MaterialSystem::release(const String name) {
-    if (name.compare_ci(_default_material_name) == 0) {
+void MaterialSystem::release(const StringId id) {
+    if (id == _default_material_id) {
         Logger::warning(MATERIAL_SYS_LOG, "Cannot release default material.");
         return;
     }
 
-    String s = name;
-    s.to_lower();
-    auto ref = _registered_materials.find(s);
+    auto ref = _registered_materials.find(id);
 
     if (ref == _registered_materials.end() ||
         ref->second.reference_count == 0) {
         Logger::warning(
-            MATERIAL_SYS_LOG, "Tried to release a non-existent material: ", name
+            MATERIAL_SYS_LOG, "Tried to release a non-existent material: ", id
         );
         return;
     }
@@ -170,10 +171,10 @@ void MaterialSystem::release(const String name) {
     // Release resource if it isn't needed
     if (ref->second.reference_count == 0 && ref->second.auto_release == true) {
         destroy_material(ref->second.handle);
-        _registered_materials.erase(s);
+        _registered_materials.erase(ref);
     }
 
-    Logger::trace(MATERIAL_SYS_LOG, "Material \"", name, "\" released.");
+    Logger::trace(MATERIAL_SYS_LOG, "Material \"", id, "\" released.");
 }
 
 // /////////////////////////////// //
@@ -193,7 +194,7 @@ void MaterialSystem::create_default_material() {
         );
 
     // Create default material
-    _default_material = new (MemoryTag::MaterialInstance)
+    _default_material = new (MemoryTag::Resource)
         Material(_default_material_name, shader, glm::vec4(1.0f));
     TextureMap diffuse_map         = { _texture_system->default_texture,
                                        TextureUse::MapDiffuse };
@@ -220,14 +221,25 @@ Result<MaterialSystem::MaterialRef, bool> MaterialSystem::create_material(
         return Failure(false);
     }
 
-    auto material = new (MemoryTag::MaterialInstance)
-        Material(config.name, shader, config.diffuse_color);
+    // Create material
+    auto handle = _materials.acquire(config.name, shader, config.diffuse_color);
+    if (handle.is_null()) {
+        Logger::error(
+            MATERIAL_SYS_LOG,
+            "Material couldn't be created. Maximum number of materials (",
+            _max_material_count,
+            ") reached. Default material returned instead."
+        );
+        return Failure(false);
+    }
+    auto material = _materials.get(handle);
 
     TextureMap diffuse_map = {};
     if (config.diffuse_map_name.length() > 0) {
         diffuse_map.use = TextureUse::MapDiffuse;
+        // Texture is streamed in, the default one is shown until then
         diffuse_map.texture =
-            _texture_system->acquire(config.diffuse_map_name, true);
+            _texture_system->acquire_async(config.diffuse_map_name, true);
     } else {
         // Note: Not needed. Set explicit for readability
         diffuse_map.use     = TextureUse::Unknown;
@@ -242,16 +254,21 @@ Result<MaterialSystem::MaterialRef, bool> MaterialSystem::create_material(
     // Assign to reference
     MaterialRef material_ref {};
     // Material
-    material_ref.handle          = material;
+    material_ref.handle          = handle;
+    material->id                 = handle.value;
     // Other
-    material_ref.handle->id      = (uint64) material_ref.handle;
     material_ref.auto_release    = config.auto_release;
     material_ref.reference_count = 1;
 
     return material_ref;
 }
 
-void MaterialSystem::destroy_material(Material* material) {
+void MaterialSystem::destroy_material(const ObjectHandle handle) {
+    auto material = _materials.get(handle);
+    if (material == nullptr)
+        Logger::fatal(
+            MATERIAL_SYS_LOG, "Tried to destroy a non-existent material."
+        );
     if (!material->internal_id.has_value())
         Logger::fatal(
             MATERIAL_SYS_LOG,
@@ -259,10 +276,9 @@ void MaterialSystem::destroy_material(Material* material) {
             material->name,
             "\" not properly initialized. Internal id not set."
         );
-    String texture_name = material->diffuse_map().texture->name;
-    _texture_system->release(texture_name);
+    _texture_system->release(material->diffuse_map().texture->name());
     material->shader()->release_instance_resources( //
         material->internal_id.value()
     );
-    delete material;
+    _materials.release(handle);
 }
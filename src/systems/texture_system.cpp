@@ -2,6 +2,8 @@
 
 #include "resources/image.hpp"
 
+#include <algorithm> // min, max
+
 #define TEXTURE_SYS_LOG "TextureSystem :: "
 
 void create_default_textures();
@@ -11,7 +13,8 @@ void destroy_default_textures();
 TextureSystem::TextureSystem(
     Renderer* const renderer, ResourceSystem* const resource_system
 )
-    : _renderer(renderer), _resource_system(resource_system) {
+    : _renderer(renderer), _resource_system(resource_system),
+      _textures(_max_texture_count, MemoryTag::Texture) {
     Logger::trace(TEXTURE_SYS_LOG, "Creating texture system.");
 
     if (_max_texture_count == 0)
@@ -20,13 +23,36 @@ TextureSystem::TextureSystem(
         );
     create_default_textures();
 
+    // Start decoding threads, leaving a core for the main thread
+    const uint32 worker_count = std::min(
+        std::max(std::thread::hardware_concurrency(), 2u) - 1,
+        _max_worker_count
+    );
+    for (uint32 i = 0; i < worker_count; i++)
+        _workers.emplace_back(&TextureSystem::worker_loop, this);
+
     Logger::trace(TEXTURE_SYS_LOG, "Texture system created.");
 }
 TextureSystem::~TextureSystem() {
-    for (auto& texture : _registered_textures) {
-        _renderer->destroy_texture(texture.second.handle);
-        delete texture.second.handle;
+    // Stop workers, pending jobs are dropped
+    {
+        std::lock_guard<std::mutex> lock { _job_lock };
+        _stopping = true;
     }
+    _job_signal.notify_all();
+    for (auto& worker : _workers)
+        worker.join();
+    _workers.clear();
+    for (const auto& job : _completed_jobs)
+        if (job.image) _resource_system->unload(job.image);
+    _completed_jobs.clear();
+    _pending_jobs.clear();
+    _next_pending_job = 0;
+
+    _textures.for_each([&](ObjectHandle, Texture& texture) {
+        if (!is_placeholder(&texture)) _renderer->destroy_texture(&texture);
+    });
+    _textures.clear();
     _registered_textures.clear();
     destroy_default_textures();
 
@@ -37,9 +63,136 @@ TextureSystem::~TextureSystem() {
 // TEXTURE SYSTEM PUBLIC METHODS //
 // ///////////////////////////// //
 
-Texture* TextureSystem::acquire(const String name, const bool auto_release) {
+Texture* TextureSystem::acquire(
+    const StringView name, const bool auto_release
+) {
     Logger::trace(TEXTURE_SYS_LOG, "Texture \"", name, "\" requested.");
 
+    const StringId id { name };
+    auto           registered = acquire_registered(name, id);
+    if (registered.has_value()) return registered.value();
+
+    // Texture was just added, load from asset folder
+    auto image = load_image(String(name));
+    if (image == nullptr) return _default_texture;
+
+    auto texture = create_texture(name, id, auto_release, image);
+
+    // Upload texture to GPU
+    _renderer->create_texture(texture, image->pixels);
+
+    // Release resources
+    _resource_system->unload(image);
+
+    Logger::trace(TEXTURE_SYS_LOG, "Texture \"", name, "\" acquired.");
+    return texture;
+}
+
+Texture* TextureSystem::acquire_async(
+    const StringView name, const bool auto_release
+) {
+    Logger::trace(TEXTURE_SYS_LOG, "Texture \"", name, "\" requested.");
+
+    // Fall back to blocking load if there are no workers
+    if (_workers.empty()) return acquire(name, auto_release);
+
+    const StringId id { name };
+    auto           registered = acquire_registered(name, id);
+    if (registered.has_value()) return registered.value();
+
+    // Placeholder uses default texture data until decoded
+    auto texture = create_texture(name, id, auto_release, nullptr);
+    texture->internal_data = _default_texture->internal_data();
+
+    // Queue for decoding
+    LoadJob job { String(name), _registered_textures[id].handle, nullptr };
+    {
+        std::lock_guard<std::mutex> lock { _job_lock };
+        _pending_jobs.push_back(job);
+    }
+    _job_signal.notify_one();
+
+    Logger::trace(TEXTURE_SYS_LOG, "Texture \"", name, "\" queued.");
+    return texture;
+}
+
+void TextureSystem::release(const StringId id) {
+    if (id == _default_texture_id) {
+        Logger::warning(TEXTURE_SYS_LOG, "Cannot release default texture.");
+        return;
+    }
+
+    auto ref = _registered_textures.find(id);
+
+    if (ref == _registered_textures.end() || ref->second.reference_count == 0) {
+        Logger::warning(
+            TEXTURE_SYS_LOG, "Tried to release a non-existent texture: ", id
+        );
+        return;
+    }
+    ref->second.reference_count--;
+
+    // Release resource if it isn't needed. Textures still loading share the
+    // default texture data, their decoded image gets dropped by update.
+    if (ref->second.reference_count == 0 && ref->second.auto_release == true) {
+        auto texture = _textures.get(ref->second.handle);
+        if (!is_placeholder(texture)) _renderer->destroy_texture(texture);
+        _textures.release(ref->second.handle);
+        _registered_textures.erase(ref);
+    }
+
+    Logger::trace(TEXTURE_SYS_LOG, "Texture \"", id, "\" released.");
+}
+
+void TextureSystem::update() {
+    {
+        std::lock_guard<std::mutex> lock { _job_lock };
+        if (_completed_jobs.empty()) return;
+        _uploaded_jobs.swap(_completed_jobs);
+    }
+
+    for (const auto& job : _uploaded_jobs) {
+        // Texture was released while loading
+        if (!_textures.is_valid(job.handle)) {
+            if (job.image) _resource_system->unload(job.image);
+            continue;
+        }
+        if (job.image == nullptr) {
+            Logger::error(
+                TEXTURE_SYS_LOG,
+                "Texture \"",
+                job.name,
+                "\" load failed. Default texture data kept."
+            );
+            continue;
+        }
+
+        auto texture = _textures.get(job.handle);
+        texture->set_description(
+            job.image->width,
+            job.image->height,
+            job.image->channel_count,
+            job.image->has_transparency,
+            job.image->format,
+            job.image->mip_level_count
+        );
+
+        // Upload texture to GPU, new internal data replaces the placeholder
+        _renderer->create_texture(texture, job.image->pixels);
+        _resource_system->unload(job.image);
+
+        Logger::trace(TEXTURE_SYS_LOG, "Texture \"", job.name, "\" loaded.");
+    }
+    _uploaded_jobs.clear();
+}
+
+// ////////////////////////////// //
+// TEXTURE SYSTEM PRIVATE METHODS //
+// ////////////////////////////// //
+
+Result<Texture*, bool> TextureSystem::acquire_registered(
+    const StringView name, const StringId id
+) {
     // Check name validity
     if (name.length() > Texture::max_name_length) {
         Logger::error(
@@ -53,7 +206,7 @@ Texture* TextureSystem::acquire(const String name, const bool auto_release) {
         );
         return _default_texture;
     }
-    if (name.compare_ci(_default_texture_name) == 0) {
+    if (id == _default_texture_id) {
         Logger::warning(
             TEXTURE_SYS_LOG,
             "To acquire the default texture from texture system use "
@@ -63,84 +216,154 @@ Texture* TextureSystem::acquire(const String name, const bool auto_release) {
     }
 
     // Get reference
-    String s = name;
-    s.to_lower();
-    auto ref = _registered_textures.find(s);
-
+    auto ref = _registered_textures.find(id);
     if (ref != _registered_textures.end()) {
         ref->second.reference_count++;
 
         Logger::trace(TEXTURE_SYS_LOG, "Texture acquired.");
-        return ref->second.handle;
+        return _textures.get(ref->second.handle);
     }
 
-    // Texture was just added, load from asset folder
+    // Check texture limit
+    if (_textures.size() == _textures.capacity()) {
+        Logger::error(
+            TEXTURE_SYS_LOG,
+            "Texture couldn't be acquired. Maximum number of textures (",
+            _max_texture_count,
+            ") reached. Default texture acquired instead."
+        );
+        return _default_texture;
+    }
+
+    return Failure(false);
+}
+
+Image* TextureSystem::load_image(const String& name) {
     auto result = _resource_system->load(name, ResourceType::Image);
     if (result.has_error()) {
         Logger::error(
             TEXTURE_SYS_LOG, "Texture load failed. Returning default_texture."
         );
-        return _default_texture;
+        return nullptr;
     }
     auto image = (Image*) result.value();
 
-    auto texture_ref   = TextureRef();
-    texture_ref.handle = new (MemoryTag::Texture) Texture(
-        name,
-        image->width,
-        image->height,
-        image->channel_count,
-        image->has_transparency()
-    );
-    texture_ref.handle->id      = (uint64) texture_ref.handle;
+    // Block compress if the renderer can sample compressed textures. Opaque
+    // textures don't need the alpha block.
+    auto compressed_format =
+        image->has_transparency ? ImageFormat::BC3 : ImageFormat::BC1;
+    if (_compress_textures && image->format == ImageFormat::RGBA8 &&
+        _renderer->supports_image_format(compressed_format)) {
+        auto compress_result = image->compress(compressed_format);
+        if (compress_result.has_error())
+            Logger::warning(
+                TEXTURE_SYS_LOG,
+                "Texture \"",
+                name,
+                "\" couldn't be compressed: ",
+                compress_result.error().what()
+            );
+    }
+
+    // Packed textures come precompressed, the device might not sample them.
+    // Source image is used instead, if there is one.
+    if (!_renderer->supports_image_format(image->format)) {
+        _resource_system->unload(image);
+
+        const String source_name = name.split('.')[0] + ".png";
+        if (source_name.compare_ci(name) == 0) {
+            Logger::error(
+                TEXTURE_SYS_LOG,
+                "Texture \"",
+                name,
+                "\" format isn't supported. Returning default_texture."
+            );
+            return nullptr;
+        }
+        Logger::warning(
+            TEXTURE_SYS_LOG,
+            "Texture \"",
+            name,
+            "\" format isn't supported. Loading \"",
+            source_name,
+            "\" instead."
+        );
+        return load_image(source_name);
+    }
+
+    return image;
+}
+
+Texture* TextureSystem::create_texture(
+    const StringView name,
+    const StringId   id,
+    const bool       auto_release,
+    Image* const     image
+) {
+    auto texture_ref = TextureRef();
+    if (image) {
+        texture_ref.handle = _textures.acquire(
+            String(name),
+            image->width,
+            image->height,
+            image->channel_count,
+            image->has_transparency,
+            image->format,
+            image->mip_level_count
+        );
+    } else {
+        // Placeholders take the default texture description
+        texture_ref.handle = _textures.acquire(
+            String(name),
+            _default_texture->width,
+            _default_texture->height,
+            _default_texture->channel_count,
+            _default_texture->has_transparency,
+            _default_texture->format,
+            _default_texture->mip_level_count
+        );
+    }
     texture_ref.auto_release    = auto_release;
     texture_ref.reference_count = 1;
 
-    // Upload texture to GPU
-    _renderer->create_texture(texture_ref.handle, image->pixels);
-
-    // Release resources
-    _resource_system->unload(image);
+    auto texture = _textures.get(texture_ref.handle);
+    texture->id  = texture_ref.handle.value;
 
     // Cache
-    _registered_textures[s] = texture_ref;
+    StringId::intern(name);
+    _registered_textures[id] = texture_ref;
+    return texture;
+}
 
-    Logger::trace(TEXTURE_SYS_LOG, "Texture \"", name, "\" acquired.");
-    return texture_ref.handle;
+bool TextureSystem::is_placeholder(const Texture* const texture) const {
+    return texture != _default_texture &&
+           texture->internal_data() == _default_texture->internal_data();
 }
 
-void TextureSystem::release(const String name) {
-    if (name.compare_ci(_default_texture_name) == 0) {
-        Logger::warning(TEXTURE_SYS_LOG, "Cannot release default texture.");
-        return;
-    }
+void TextureSystem::worker_loop() {
+    while (true) {
+        LoadJob job {};
+        {
+            std::unique_lock<std::mutex> lock { _job_lock };
+            _job_signal.wait(lock, [&] {
+                return _stopping || _next_pending_job < _pending_jobs.size();
+            });
+            if (_stopping) return;
+            job = std::move(_pending_jobs[_next_pending_job++]);
+            if (_next_pending_job == _pending_jobs.size()) {
+                _pending_jobs.clear();
+                _next_pending_job = 0;
+            }
+        }
 
-    String s = name;
-    s.to_lower();
-    auto ref = _registered_textures.find(s);
+        // Decode (and compress) without blocking the main thread
+        job.image = load_image(job.name);
 
-    if (ref == _registered_textures.end() || ref->second.reference_count == 0) {
-        Logger::warning(
-            TEXTURE_SYS_LOG, "Tried to release a non-existent texture: ", name
-        );
-        return;
-    }
-    ref->second.reference_count--;
-
-    // Release resource if it isn't needed
-    if (ref->second.reference_count == 0 && ref->second.auto_release == true) {
-        _renderer->destroy_texture(ref->second.handle);
-        delete ref->second.handle;
-        _registered_textures.erase(s);
+        std::lock_guard<std::mutex> lock { _job_lock };
+        _completed_jobs.push_back(job);
     }
-
-    Logger::trace(TEXTURE_SYS_LOG, "Texture \"", name, "\" released.");
 }
 
-// ////////////////////////////// //
-// TEXTURE SYSTEM PRIVATE METHODS //
-// ////////////////////////////// //
-
 void TextureSystem::create_default_textures() {
     const uint32 texture_dimension = 256;
     const uint32 channels          = 4;
@@ -159,15 +382,21 @@ void TextureSystem::create_default_textures() {
         }
     }
 
-    _default_texture = new (MemoryTag::Texture) Texture(
+    auto mip_chain =
+        Image::create_mip_chain(pixels, texture_dimension, texture_dimension);
+
+    _default_texture = new (MemoryTag::Resource) Texture(
         _default_texture_name,
         texture_dimension,
         texture_dimension,
         channels,
-        false
+        false,
+        ImageFormat::RGBA8,
+        Image::get_mip_level_count(texture_dimension, texture_dimension)
     );
     _default_texture->id = 0;
-    _renderer->create_texture(_default_texture, pixels);
+    _renderer->create_texture(_default_texture, mip_chain);
+    delete[] mip_chain;
 }
 void TextureSystem::destroy_default_textures() {
     if (_default_texture) {
@@ -0,0 +1,228 @@
+#include "logger.hpp"
+
+#include <atomic>
+#include <charconv> // to_chars
+#include <cstdio>   // snprintf
+#include <new>
+#include <thread>
+
+// Ring capacity in records, power of 2
+static constexpr uint64 ring_size        = 1024;
+static constexpr uint64 ring_mask        = ring_size - 1;
+static constexpr uint64 record_size      = 256;
+static constexpr uint64 record_text_size = record_size - 16;
+// Console output is gathered into batches of up to this size
+static constexpr uint64 batch_size       = 64 * 1024;
+// Empty drains before the background thread starts sleeping between drains
+static constexpr uint32 max_idle_rounds  = 256;
+
+/// @brief Ring slot, holding a message or a part of one. Longer messages
+/// occupy consecutive slots.
+struct alignas(64) LogRecord {
+    // Slot state, equal to the ring position of the slot when free and to
+    // the position + 1 once written
+    std::atomic<uint64> sequence;
+    uint16              length;
+    uint8               kind;
+    // Record holds the first part of a message
+    bool                first;
+    // Record holds the last part of a message
+    bool                last;
+    char                text[record_text_size];
+};
+static_assert(sizeof(LogRecord) == record_size, "Unexpected log record size.");
+
+/**
+ * @brief Bounded multi producer, single consumer ring of log records, drained
+ * by a background thread. Producers claim ring positions with a single atomic
+ * add, so they never lock. A message claims all its records at once, so
+ * messages of different threads never interleave.
+ */
+class LogSink {
+  public:
+    LogSink() {
+        for (uint64 i = 0; i < ring_size; i++)
+            _records[i].sequence.store(i, std::memory_order_relaxed);
+        _thread = std::thread([this] { drain_loop(); });
+        std::atexit([] { log_sink().shutdown(); });
+    }
+
+    void submit(
+        const uint32 kind, const char* const text, const uint64 length
+    ) {
+        // Registered before checking the state, so that the background
+        // thread can't stop between the check & the claim below
+        _producer_count.fetch_add(1, std::memory_order_seq_cst);
+
+        // Written after shutdown (e.g. by static destructors)
+        if (!_running.load(std::memory_order_seq_cst)) {
+            _producer_count.fetch_sub(1, std::memory_order_release);
+            Platform::Console::write(std::string(text, length), kind, true);
+            return;
+        }
+
+        const uint64 count = std::max(
+            (length + record_text_size - 1) / record_text_size, (uint64) 1
+        );
+        const uint64 first =
+            _write_position.fetch_add(count, std::memory_order_relaxed);
+
+        for (uint64 i = 0; i < count; i++) {
+            const uint64 position = first + i;
+            auto&        record   = _records[position & ring_mask];
+            // Ring is full, wait for the sink to catch up
+            while (record.sequence.load(std::memory_order_acquire) != position)
+                std::this_thread::yield();
+
+            const uint64 offset = i * record_text_size;
+            const uint64 part   = std::min(length - offset, record_text_size);
+
+            record.length = (uint16) part;
+            record.kind   = (uint8) kind;
+            record.first  = i == 0;
+            record.last   = i == count - 1;
+            memcpy(record.text, text + offset, part);
+            record.sequence.store(position + 1, std::memory_order_release);
+        }
+        _producer_count.fetch_sub(1, std::memory_order_release);
+    }
+
+    void flush() {
+        const uint64 target = _write_position.load(std::memory_order_acquire);
+        while (_written_position.load(std::memory_order_acquire) < target)
+            std::this_thread::yield();
+    }
+
+    /// @brief Write remaining messages & stop the background thread
+    void shutdown() {
+        _running.store(false, std::memory_order_seq_cst);
+        if (_thread.joinable()) _thread.join();
+    }
+
+    static LogSink& log_sink();
+
+  private:
+    LogRecord           _records[ring_size];
+    // Next ring position claimed by producers
+    std::atomic<uint64> _write_position { 0 };
+    // All records before this ring position are written to the console
+    std::atomic<uint64> _written_position { 0 };
+    std::atomic<bool>   _running { true };
+    // Producers between the state check & the end of their writes
+    std::atomic<uint32> _producer_count { 0 };
+
+    // Background thread state
+    std::thread _thread {};
+    uint64      _read_position = 0;
+    char        _batch[batch_size];
+
+    void drain_loop() {
+        uint32 idle_rounds = 0;
+        while (true) {
+            if (drain()) {
+                idle_rounds = 0;
+                continue;
+            }
+            // Nothing left to write, and no producer can claim more
+            if (!_running.load(std::memory_order_seq_cst) &&
+                _producer_count.load(std::memory_order_seq_cst) == 0 &&
+                _read_position ==
+                    _write_position.load(std::memory_order_acquire))
+                return;
+            // Stay responsive during bursts, sleep once logging goes quiet
+            if (idle_rounds < max_idle_rounds) {
+                idle_rounds++;
+                std::this_thread::yield();
+            } else Platform::sleep(1);
+        }
+    }
+
+    // Write all available records with a single console write
+    // Returns true if anything was written
+    bool drain() {
+        const char* const reset        = Platform::Console::get_default_style();
+        const uint64      reset_length = strlen(reset);
+
+        uint64 length = 0;
+        while (length + 2 * record_size <= batch_size) {
+            auto& record = _records[_read_position & ring_mask];
+            if (record.sequence.load(std::memory_order_acquire) !=
+                _read_position + 1)
+                break;
+
+            if (record.first) {
+                const char* const style =
+                    Platform::Console::get_style(record.kind);
+                const uint64 style_length = strlen(style);
+                memcpy(_batch + length, style, style_length);
+                length += style_length;
+            }
+            memcpy(_batch + length, record.text, record.length);
+            length += record.length;
+            if (record.last) {
+                memcpy(_batch + length, reset, reset_length);
+                length += reset_length;
+                _batch[length++] = '\n';
+            }
+
+            // Free the slot for the position one lap ahead
+            record.sequence.store(
+                _read_position + ring_size, std::memory_order_release
+            );
+            _read_position++;
+        }
+        if (length == 0) return false;
+
+        Platform::Console::write_raw(_batch, length);
+        _written_position.store(_read_position, std::memory_order_release);
+        return true;
+    }
+};
+
+LogSink& LogSink::log_sink() {
+    // Never destroyed, so objects destroyed after shutdown can still log
+    alignas(LogSink) static byte storage[sizeof(LogSink)];
+    static LogSink* const        sink = ::new (storage) LogSink();
+    return *sink;
+}
+
+// ///////////////////// //
+// LOGGER PUBLIC METHODS //
+// ///////////////////// //
+
+void Logger::flush() { LogSink::log_sink().flush(); }
+
+// ////////////////////// //
+// LOGGER PRIVATE METHODS //
+// ////////////////////// //
+
+Logger::MessageBuffer& Logger::message_buffer() {
+    thread_local MessageBuffer buffer;
+    return buffer;
+}
+
+void Logger::submit(
+    const uint32 kind, const char* const text, const uint64 length
+) {
+    LogSink::log_sink().submit(kind, text, length);
+}
+
+void Logger::append_signed(MessageBuffer& buffer, const int64 number) {
+    char       text[24];
+    const auto result = std::to_chars(text, text + sizeof(text), number);
+    buffer.append(text, result.ptr - text);
+}
+
+void Logger::append_unsigned(MessageBuffer& buffer, const uint64 number) {
+    char       text[24];
+    const auto result = std::to_chars(text, text + sizeof(text), number);
+    buffer.append(text, result.ptr - text);
+}
+
+void Logger::append_float(MessageBuffer& buffer, const long double number) {
+    // Fixed notation with 6 decimals, same as std::to_string
+    char      text[512];
+    const int length = snprintf(text, sizeof(text), "%Lf", number);
+    if (length < 0) return;
+    buffer.append(text, std::min((uint64) length, (uint64) sizeof(text) - 1));
+}
@@ -1,15 +1,23 @@
 #include "memory_allocators/allocator.hpp"
 
-#include <stdlib.h> /* malloc, free */
+#include "platform/platform.hpp"
+#include "logger.hpp"
+
+#include <algorithm> /* max, min */
+#include <stdlib.h>  /* malloc, free */
 
 Allocator::~Allocator() {
-    free(_start_ptr);
+    release_arenas();
     _start_ptr = nullptr;
 }
 
 void Allocator::init() {
-    if (_start_ptr != nullptr) { free(_start_ptr); }
-    _start_ptr = malloc(_total_size);
+    if (_arenas == nullptr) {
+        Arena* arena = add_arena(_total_size);
+        if (arena == nullptr)
+            Logger::fatal(ALLOCATOR_LOG, "Failed to reserve allocator memory.");
+        _start_ptr = arena->start;
+    }
     this->reset();
 }
 void* Allocator::allocate(const uint64 size, const uint64 alignment) {
@@ -17,7 +25,123 @@ void* Allocator::allocate(const uint64 size, const uint64 alignment) {
 }
 void Allocator::free(void* ptr) {}
 void Allocator::reset() {}
-bool Allocator::owns(void* ptr) {
-    return ptr >= _start_ptr &&
-           (uint64) ptr < (uint64) _start_ptr + _total_size;
-}
\ No newline at end of file
+bool Allocator::owns(void* ptr) { return find_arena(ptr) != nullptr; }
+
+uint64 Allocator::get_reserved() const {
+    uint64 reserved = 0;
+    for (Arena* arena = _arenas; arena != nullptr; arena = arena->next)
+        reserved += arena->size;
+    return reserved;
+}
+
+void Allocator::set_arena_callback(
+    const ArenaCallback callback, void* const user_data
+) {
+    _arena_callback      = callback;
+    _arena_callback_data = user_data;
+    if (callback == nullptr) return;
+
+    for (Arena* arena = _arenas; arena != nullptr; arena = arena->next)
+        callback(user_data, arena->start, arena->size, true);
+}
+
+// /////////////////////////// //
+// ALLOCATOR PROTECTED METHODS //
+// /////////////////////////// //
+
+Allocator::Arena* Allocator::add_arena(const uint64 min_size) {
+    // Grow geometrically, each arena is at least as big as all previous ones
+    const uint64 size = get_aligned(
+        std::max({ min_size, _total_size, get_reserved() }),
+        Platform::Memory::get_page_size()
+    );
+
+    void* start = Platform::Memory::reserve(size);
+    if (start == nullptr) return nullptr;
+
+    Arena* arena     = (Arena*) malloc(sizeof(Arena));
+    arena->start     = start;
+    arena->size      = size;
+    arena->committed = 0;
+    arena->next      = nullptr;
+
+    // Append
+    Arena** last = &_arenas;
+    while (*last != nullptr)
+        last = &(*last)->next;
+    *last = arena;
+
+    if (_arena_callback != nullptr)
+        _arena_callback(_arena_callback_data, start, size, true);
+
+    return arena;
+}
+
+Allocator::Arena* Allocator::find_arena(const void* ptr) const {
+    for (Arena* arena = _arenas; arena != nullptr; arena = arena->next)
+        if (ptr >= arena->start &&
+            (uint64) ptr < (uint64) arena->start + arena->size)
+            return arena;
+    return nullptr;
+}
+
+void Allocator::release_arenas(Arena* const after) {
+    Arena* arena = (after != nullptr) ? after->next : _arenas;
+    while (arena != nullptr) {
+        Arena* next = arena->next;
+        if (_arena_callback != nullptr)
+            _arena_callback(
+                _arena_callback_data, arena->start, arena->size, false
+            );
+        Platform::Memory::release(arena->start, arena->size);
+        std::free(arena);
+        arena = next;
+    }
+
+    if (after != nullptr) after->next = nullptr;
+    else _arenas = nullptr;
+}
+
+void Allocator::decommit_arenas(Arena* const after) {
+    for (Arena* arena = after->next; arena != nullptr; arena = arena->next) {
+        if (arena->committed == 0) continue;
+        Platform::Memory::decommit(arena->start, arena->size);
+        arena->committed = 0;
+    }
+}
+
+void Allocator::commit_range(const uint64 start, const uint64 size) {
+    const uint64 page_size = Platform::Memory::get_page_size();
+    const uint64 begin     = start & ~(page_size - 1);
+    const uint64 end       = get_aligned(start + size, page_size);
+    if (!Platform::Memory::commit((void*) begin, end - begin))
+        Logger::fatal(ALLOCATOR_LOG, "Failed to commit allocator memory.");
+}
+
+void Allocator::decommit_range(
+    Arena* const arena, const uint64 start, const uint64 size
+) {
+    const uint64 page_size = Platform::Memory::get_page_size();
+    const uint64 begin     = get_aligned(start, page_size);
+    const uint64 end       = (start + size) & ~(page_size - 1);
+    if (end <= begin) return;
+
+    Platform::Memory::decommit((void*) begin, end - begin);
+    arena->committed =
+        std::min(arena->committed, begin - (uint64) arena->start);
+}
+
+// ///////////////////////// //
+// ALLOCATOR PRIVATE METHODS //
+// ///////////////////////// //
+
+void Allocator::raise_committed(Arena* const arena, const uint64 end) {
+    // Whole steps are committed, but never past the arena end
+    const uint64 committed =
+        std::min(get_aligned(end, commit_step), arena->size);
+    if (committed <= arena->committed) return;
+    commit_range(
+        (uint64) arena->start + arena->committed, committed - arena->committed
+    );
+    arena->committed = committed;
+}
@@ -0,0 +1,177 @@
+#include "memory_allocators/concurrent_pool_allocator.hpp"
+
+#include "logger.hpp"
+
+#include <algorithm> // min, max
+
+// Stack head holds a node pointer in its lower 48 bits (user space addresses
+// fit) and a modification tag in the remaining upper bits
+static constexpr uint64 pointer_bits = 48;
+static constexpr uint64 pointer_mask = ((uint64) 1 << pointer_bits) - 1;
+
+static_assert(sizeof(void*) == 8, "Concurrent pool requires 64-bit pointers.");
+
+/// @brief Create new stack head pointing to a node, with tag incremented
+static inline uint64 pack_head(const void* const node, const uint64 old_head) {
+    const uint64 tag = (old_head >> pointer_bits) + 1;
+    return (tag << pointer_bits) | (uint64) node;
+}
+
+// Constructor & Destructor
+ConcurrentPoolAllocator::ConcurrentPoolAllocator(
+    const uint64 total_size, const uint64 chunk_size
+)
+    : Allocator(total_size) {
+    if (chunk_size < 8)
+        Logger::fatal(
+            ALLOCATOR_LOG,
+            "Pool allocator's chunk size must be greater or equal to 8."
+        );
+    if (total_size % chunk_size != 0)
+        Logger::fatal(
+            ALLOCATOR_LOG,
+            "Pool allocator's total size must be a multiple of Chunk Size."
+        );
+
+    this->_chunk_size = chunk_size;
+}
+
+// //////////////////////////////////////// //
+// CONCURRENT POOL ALLOCATOR PUBLIC METHODS //
+// //////////////////////////////////////// //
+
+void* ConcurrentPoolAllocator::allocate(
+    const uint64 allocation_size, const uint64 alignment
+) {
+    if (allocation_size != this->_chunk_size)
+        Logger::fatal(
+            ALLOCATOR_LOG,
+            "Allocation size for pool allocator must be equal to chunk size."
+        );
+
+    uint64 head = _head.load(std::memory_order_acquire);
+    while (true) {
+        Node* const node = (Node*) (head & pointer_mask);
+
+        // Carve new chunks if all are taken
+        if (node == nullptr) {
+            std::lock_guard<std::recursive_mutex> lock { _grow_lock };
+
+            // Another thread might have done it already
+            head = _head.load(std::memory_order_acquire);
+            if ((head & pointer_mask) != 0) continue;
+
+            carve_chunks();
+            head = _head.load(std::memory_order_acquire);
+            continue;
+        }
+
+        // Node can be taken (and overwritten) by another thread before the
+        // swap, in which case its next is garbage. Tag change then makes the
+        // swap fail. Arenas are never released during use, so the read itself
+        // is always safe.
+        Node* const next = __atomic_load_n(&node->next, __ATOMIC_RELAXED);
+        if (_head.compare_exchange_weak(
+                head,
+                pack_head(next, head),
+                std::memory_order_acquire,
+                std::memory_order_acquire
+            )) {
+            update_usage((int64) _chunk_size);
+            return (void*) node;
+        }
+    }
+}
+
+void ConcurrentPoolAllocator::free(void* ptr) {
+    update_usage(-(int64) _chunk_size);
+    push_chain((Node*) ptr, (Node*) ptr);
+}
+
+void ConcurrentPoolAllocator::reset() {
+    std::lock_guard<std::recursive_mutex> lock { _grow_lock };
+    _used = 0;
+    _peak = 0;
+
+    // Keep only the initial reserve
+    release_arenas(_arenas);
+    _head.store(0, std::memory_order_relaxed);
+    _carve_arena  = _arenas;
+    _carve_offset = 0;
+}
+
+bool ConcurrentPoolAllocator::owns(void* ptr) {
+    // Arena list may be growing
+    std::lock_guard<std::recursive_mutex> lock { _grow_lock };
+    return Allocator::owns(ptr);
+}
+
+uint64 ConcurrentPoolAllocator::get_reserved() const {
+    std::lock_guard<std::recursive_mutex> lock { _grow_lock };
+    return Allocator::get_reserved();
+}
+
+// ///////////////////////////////////////// //
+// CONCURRENT POOL ALLOCATOR PRIVATE METHODS //
+// ///////////////////////////////////////// //
+
+void ConcurrentPoolAllocator::carve_chunks() {
+    // Continue in the next arena, or add one, if this one is full
+    while (_carve_offset + _chunk_size > _carve_arena->size) {
+        if (_carve_arena->next == nullptr && add_arena(_total_size) == nullptr)
+            Logger::fatal(ALLOCATOR_LOG, "The pool allocator is full");
+        _carve_arena  = _carve_arena->next;
+        _carve_offset = 0;
+    }
+    if ((uint64) _carve_arena->start + _carve_arena->size > pointer_mask)
+        Logger::fatal(
+            ALLOCATOR_LOG,
+            "Concurrent pool allocator arena is outside of the 48-bit address "
+            "range."
+        );
+
+    // Carve a commit step worth of chunks (at least one), link them in
+    // address order, then publish them at once
+    const uint64 start     = (uint64) _carve_arena->start + _carve_offset;
+    const uint64 available = (_carve_arena->size - _carve_offset) / _chunk_size;
+    const uint64 count =
+        std::min(std::max(commit_step / _chunk_size, (uint64) 1), available);
+    const uint64 last = start + (count - 1) * _chunk_size;
+
+    _carve_offset += count * _chunk_size;
+    commit_arena(_carve_arena, _carve_offset);
+
+    for (uint64 address = start; address < last; address += _chunk_size)
+        ((Node*) address)->next = (Node*) (address + _chunk_size);
+    push_chain((Node*) start, (Node*) last);
+}
+
+void ConcurrentPoolAllocator::push_chain(Node* const first, Node* const last) {
+    uint64 head = _head.load(std::memory_order_relaxed);
+    do {
+        __atomic_store_n(
+            &last->next, (Node*) (head & pointer_mask), __ATOMIC_RELAXED
+        );
+    } while (!_head.compare_exchange_weak(
+        head,
+        pack_head(first, head),
+        std::memory_order_release,
+        std::memory_order_relaxed
+    ));
+}
+
+void ConcurrentPoolAllocator::update_usage(const int64 change) {
+    const uint64 used =
+        __atomic_add_fetch(&_used, (uint64) change, __ATOMIC_RELAXED);
+    if (change < 0) return;
+
+    uint64 peak = __atomic_load_n(&_peak, __ATOMIC_RELAXED);
+    while (used > peak && !__atomic_compare_exchange_n(
+                              &_peak,
+                              &peak,
+                              used,
+                              true,
+                              __ATOMIC_RELAXED,
+                              __ATOMIC_RELAXED
+                          )) {}
+}
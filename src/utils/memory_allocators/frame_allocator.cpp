@@ -0,0 +1,98 @@
+#include "memory_allocators/frame_allocator.hpp"
+
+#include "logger.hpp"
+
+#include <algorithm> // max
+
+// Constructor & Destructor
+FrameAllocator::FrameAllocator(
+    const uint64 frame_size, const uint32 frame_count
+)
+    : Allocator(frame_size * frame_count), _frame_count(frame_count),
+      _current_frame(0) {
+    if (frame_count == 0)
+        Logger::fatal(
+            ALLOCATOR_LOG, "Frame allocator requires at least one frame."
+        );
+
+    _frames = new LinearAllocator*[frame_count];
+    for (uint32 i = 0; i < frame_count; i++)
+        _frames[i] = new LinearAllocator(frame_size);
+}
+FrameAllocator::~FrameAllocator() {
+    for (uint32 i = 0; i < _frame_count; i++)
+        delete _frames[i];
+    delete[] _frames;
+}
+
+// ////////////////////////////// //
+// FRAME ALLOCATOR PUBLIC METHODS //
+// ////////////////////////////// //
+
+void FrameAllocator::init() {
+    for (uint32 i = 0; i < _frame_count; i++)
+        _frames[i]->init();
+    _current_frame = 0;
+    _used          = 0;
+    _peak          = 0;
+}
+
+void* FrameAllocator::allocate(const uint64 size, const uint64 alignment) {
+    auto         frame = _frames[_current_frame];
+    const uint64 used  = frame->get_used();
+    void*        ptr   = frame->allocate(size, alignment);
+
+    // Debug data
+    _used += frame->get_used() - used;
+    _peak = std::max(_peak, _used);
+
+    return ptr;
+}
+
+void FrameAllocator::free(void* ptr) {
+    // Released together with the rest of the frame
+    return;
+}
+
+void FrameAllocator::reset() {
+    for (uint32 i = 0; i < _frame_count; i++)
+        _frames[i]->reset();
+    _current_frame = 0;
+    _used          = 0;
+    _peak          = 0;
+}
+
+bool FrameAllocator::owns(void* ptr) {
+    for (uint32 i = 0; i < _frame_count; i++)
+        if (_frames[i]->owns(ptr)) return true;
+    return false;
+}
+
+uint64 FrameAllocator::get_reserved() const {
+    uint64 reserved = 0;
+    for (uint32 i = 0; i < _frame_count; i++)
+        reserved += _frames[i]->get_reserved();
+    return reserved;
+}
+
+void FrameAllocator::set_arena_callback(
+    const ArenaCallback callback, void* const user_data
+) {
+    for (uint32 i = 0; i < _frame_count; i++)
+        _frames[i]->set_arena_callback(callback, user_data);
+}
+
+void FrameAllocator::begin_frame(const uint32 frame_index) {
+    if (frame_index >= _frame_count)
+        Logger::fatal(
+            ALLOCATOR_LOG,
+            "Frame index out of range. Frame allocator was created with ",
+            _frame_count,
+            " frames."
+        );
+
+    auto frame = _frames[frame_index];
+    _used -= frame->get_used();
+    frame->reset();
+    _current_frame = frame_index;
+}
@@ -2,7 +2,7 @@
 
 #include "logger.hpp"
 
-#include <algorithm> // std::max
+#include <algorithm> // std::max, std::min
 
 // Constructor & Destructor
 FreeListAllocator::FreeListAllocator(
@@ -17,6 +17,12 @@ FreeListAllocator::FreeListAllocator(
 // ////////////////////////////////// //
 
 void* FreeListAllocator::allocate(const uint64 size, const uint64 alignment) {
+    if (alignment < 4)
+        Logger::fatal(
+            ALLOCATOR_LOG, "Free list allocation alignment must be at least 4."
+        );
+    if (_placement_policy == SegregatedFit)
+        return allocate_segregated(size, alignment);
     if (size < sizeof(Node))
         Logger::warning(
             ALLOCATOR_LOG,
@@ -24,10 +30,6 @@ void* FreeListAllocator::allocate(const uint64 size, const uint64 alignment) {
             sizeof(Node),
             ", which is sizeof(Node)."
         );
-    if (alignment < 4)
-        Logger::fatal(
-            ALLOCATOR_LOG, "Free list allocation alignment must be at least 4."
-        );
 
     // Search through the free list for a free block that has enough space to
     // allocate our data
@@ -35,10 +37,18 @@ void* FreeListAllocator::allocate(const uint64 size, const uint64 alignment) {
     Node * affected_node, *previous_node;
     find(size, alignment, padding, previous_node, affected_node);
 
-    if (affected_node == nullptr)
-        Logger::fatal(
-            ALLOCATOR_LOG, "Free list allocator out of memory error."
+    // If none is found reserve a new arena
+    if (affected_node == nullptr) {
+        Arena* arena = add_arena(
+            size + alignment + sizeof(AllocationHeader) + sizeof(uint64)
         );
+        if (arena == nullptr)
+            Logger::fatal(
+                ALLOCATOR_LOG, "Free list allocator out of memory error."
+            );
+        insert_arena(arena);
+        find(size, alignment, padding, previous_node, affected_node);
+    }
 
     const uint64 allocation_header_size = sizeof(AllocationHeader);
     const uint64 alignment_padding      = padding - allocation_header_size;
@@ -46,6 +56,13 @@ void* FreeListAllocator::allocate(const uint64 size, const uint64 alignment) {
 
     const uint64 rest = affected_node->data.block_size - required_size;
 
+    // Block (and the header of the split off free block) might reach above
+    // the arena's high-water mark
+    const uint64 touched_end =
+        (uint64) affected_node + required_size + sizeof(Node);
+    Arena* const arena = find_arena(affected_node);
+    commit_arena(arena, touched_end - (uint64) arena->start);
+
     if (rest >= sizeof(Node)) {
         // We have to split the block into the data block and a free block of
         // size 'rest'
@@ -69,6 +86,8 @@ void* FreeListAllocator::allocate(const uint64 size, const uint64 alignment) {
 }
 
 void FreeListAllocator::free(void* ptr) {
+    if (_placement_policy == SegregatedFit) return free_segregated(ptr);
+
     // Insert it in a sorted position by the address number
     const uint64 current_address = (uint64) ptr;
     const uint64 header_address  = current_address - sizeof(AllocationHeader);
@@ -81,29 +100,28 @@ void FreeListAllocator::free(void* ptr) {
     free_node->next            = nullptr;
 
     Node *it = _free_list.head, *it_prev = nullptr;
-    while (it != nullptr) {
-        if (ptr < it) {
-            _free_list.insert(it_prev, free_node);
-            break;
-        }
+    while (it != nullptr && it < free_node) {
         it_prev = it;
         it      = it->next;
     }
+    _free_list.insert(it_prev, free_node);
 
     _used -= free_node->data.block_size;
 
     // Merge contiguous nodes
-    coalescence(it_prev, free_node);
+    free_node = coalescence(it_prev, free_node);
+    decommit_if_idle((uint64) free_node, free_node->data.block_size);
 }
 
 void FreeListAllocator::reset() {
-    _used                       = 0;
-    _peak                       = 0;
-    Node* first_node            = (Node*) _start_ptr;
-    first_node->data.block_size = _total_size;
-    first_node->next            = nullptr;
-    _free_list.head             = nullptr;
-    _free_list.insert(nullptr, first_node);
+    _used = 0;
+    _peak = 0;
+    if (_placement_policy == SegregatedFit) return reset_segregated();
+
+    // Keep only the initial reserve
+    release_arenas(_arenas);
+    _free_list.head = nullptr;
+    insert_arena(_arenas);
 }
 
 // /////////////////////////////////// //
@@ -124,6 +142,12 @@ void FreeListAllocator::find(
     case FindBest:
         find_best(size, alignment, padding, previous_node, found_node);
         break;
+    case SegregatedFit:
+        // Segregated blocks aren't kept in the free list, they are found by
+        // find_segregated
+        Logger::fatal(
+            ALLOCATOR_LOG, "Free list search used with segregated fit policy."
+        );
     }
 }
 
@@ -159,7 +183,9 @@ void FreeListAllocator::find_best(
 ) {
     // Iterate WHOLE list keeping a pointer to the best fit
     uint64 smallest_diff = UINT64_MAX;
+    uint64 best_padding  = 0;
     Node*  best_block    = nullptr;
+    Node*  best_previous = nullptr;
 
     Node *it = _free_list.head, *it_prev = nullptr;
     while (it != nullptr) {
@@ -169,16 +195,22 @@ void FreeListAllocator::find_best(
         const uint64 required_space = size + padding;
         if (it->data.block_size >= required_space &&
             (it->data.block_size - required_space < smallest_diff)) {
-            best_block = it;
+            smallest_diff = it->data.block_size - required_space;
+            best_block    = it;
+            best_previous = it_prev;
+            best_padding  = padding;
         }
         it_prev = it;
         it      = it->next;
     }
-    previous_node = it_prev;
+    padding       = best_padding;
+    previous_node = best_previous;
     found_node    = best_block;
 }
 
-void FreeListAllocator::coalescence(Node* previous_node, Node* free_node) {
+FreeListAllocator::Node* FreeListAllocator::coalescence(
+    Node* previous_node, Node* free_node
+) {
     if (free_node->next != nullptr &&
         (uint64) free_node + free_node->data.block_size ==
             (uint64) free_node->next) {
@@ -191,5 +223,250 @@ void FreeListAllocator::coalescence(Node* previous_node, Node* free_node) {
             (uint64) free_node) {
         previous_node->data.block_size += free_node->data.block_size;
         _free_list.remove(previous_node, free_node);
+        return previous_node;
     }
+    return free_node;
+}
+
+void FreeListAllocator::insert_arena(Arena* const arena) {
+    // Last 8 bytes of each arena are never allocated. They keep blocks from
+    // merging across arenas which happen to be adjacent in memory
+    const uint64 start = get_aligned((uint64) arena->start, 8);
+    const uint64 end   = ((uint64) arena->start + arena->size) & ~(uint64) 7;
+    const uint64 size  = end - sizeof(uint64) - start;
+
+    // Only the first block header is written, the rest of the arena gets
+    // committed as allocations reach it
+    commit_arena(arena, start + sizeof(Block) - (uint64) arena->start);
+
+    if (_placement_policy == SegregatedFit) {
+        // Sentinel & the footer before it are outside the high-water mark
+        commit_range(end - 2 * sizeof(uint64), 2 * sizeof(uint64));
+
+        // Reserved bytes hold a zero sized allocated block tag
+        Block* const sentinel = (Block*) (end - sizeof(uint64));
+        Block* const block    = (Block*) start;
+
+        block->tag    = size | _block_free;
+        sentinel->tag = _block_previous_free;
+        *(uint64*) ((uint64) sentinel - sizeof(uint64)) = size;
+        insert_block(block);
+        return;
+    }
+
+    Node* const node      = (Node*) start;
+    node->data.block_size = size;
+    node->next            = nullptr;
+
+    Node *it = _free_list.head, *it_prev = nullptr;
+    while (it != nullptr && it < node) {
+        it_prev = it;
+        it      = it->next;
+    }
+    _free_list.insert(it_prev, node);
+}
+
+void FreeListAllocator::decommit_if_idle(
+    const uint64 address, const uint64 size
+) {
+    // Only whole free arenas are of interest
+    if (size + sizeof(uint64) < _total_size) return;
+
+    Arena* const arena = find_arena((void*) address);
+    if (arena == _arenas || get_aligned((uint64) arena->start, 8) != address ||
+        address + size + sizeof(uint64) <
+            (uint64) arena->start + arena->size)
+        return;
+
+    // Free block header (and footer) must stay intact
+    decommit_range(
+        arena, address + sizeof(Block), size - sizeof(Block) - sizeof(uint64)
+    );
+}
+
+// ////////////////////////////////////////////////// //
+// FREE LIST ALLOCATOR SEGREGATED FIT PRIVATE METHODS //
+// ////////////////////////////////////////////////// //
+
+void* FreeListAllocator::allocate_segregated(
+    const uint64 size, const uint64 alignment
+) {
+    // Block tag and allocation header are placed before the data. Block start
+    // is always 8 byte aligned, so larger alignments might require extra space
+    const uint64 alignment_extra = (alignment > 8) ? alignment - 8 : 0;
+    const uint64 required_size   = std::max(
+        get_aligned(
+            sizeof(uint64) + sizeof(AllocationHeader) + size + alignment_extra,
+            8
+        ),
+        _min_block_size
+    );
+
+    Block* block = find_segregated(required_size);
+
+    // If none is found reserve a new arena
+    if (block == nullptr) {
+        Arena* arena = add_arena(required_size + 2 * sizeof(uint64));
+        if (arena == nullptr)
+            Logger::fatal(
+                ALLOCATOR_LOG, "Free list allocator out of memory error."
+            );
+        insert_arena(arena);
+        block = find_segregated(required_size);
+    }
+    remove_block(block);
+
+    // Split the block if the rest is big enough to hold a free block
+    uint64       allocated_size = block_size(block);
+    Block* const next           = next_block(block);
+    const uint64 rest           = allocated_size - required_size;
+
+    // Block (and the tag of the split off free block) might reach above the
+    // arena's high-water mark. Blocks end at most at the arena sentinel.
+    const uint64 touched_end =
+        std::min((uint64) block + required_size + sizeof(Block), (uint64) next);
+    Arena* const arena = find_arena(block);
+    commit_arena(arena, touched_end - (uint64) arena->start);
+    if (rest >= _min_block_size) {
+        Block* rest_block = (Block*) ((uint64) block + required_size);
+        rest_block->tag   = rest | _block_free;
+        *(uint64*) ((uint64) next - sizeof(uint64)) = rest;
+        insert_block(rest_block);
+        allocated_size = required_size;
+    } else next->tag &= ~_block_previous_free;
+    block->tag = allocated_size;
+
+    // Setup data block
+    const uint64 header_address =
+        get_aligned(
+            (uint64) block + sizeof(uint64) + sizeof(AllocationHeader),
+            alignment
+        ) -
+        sizeof(AllocationHeader);
+    const uint64 data_address = header_address + sizeof(AllocationHeader);
+    ((AllocationHeader*) header_address)->block_size = allocated_size;
+    ((AllocationHeader*) header_address)->padding =
+        header_address - (uint64) block;
+
+    // Debug vars
+    _used += allocated_size;
+    _peak = std::max(_peak, _used);
+
+    return (void*) data_address;
+}
+
+void FreeListAllocator::free_segregated(void* ptr) {
+    const AllocationHeader* allocation_header =
+        (AllocationHeader*) ((uint64) ptr - sizeof(AllocationHeader));
+
+    Block* block = (Block*) ((uint64) allocation_header -
+                             allocation_header->padding);
+    uint64 size  = block_size(block);
+
+    _used -= size;
+
+    // Merge with the next block
+    Block* next = next_block(block);
+    if (next->tag & _block_free) {
+        remove_block(next);
+        size += block_size(next);
+    }
+
+    // Merge with the previous block
+    if (block->tag & _block_previous_free) {
+        const uint64 previous_size =
+            *(uint64*) ((uint64) block - sizeof(uint64));
+        block = (Block*) ((uint64) block - previous_size);
+        remove_block(block);
+        size += previous_size;
+    }
+
+    // Previous block is allocated, otherwise it would have been merged
+    block->tag = size | _block_free;
+    next       = next_block(block);
+    *(uint64*) ((uint64) next - sizeof(uint64)) = size;
+    next->tag |= _block_previous_free;
+    insert_block(block);
+
+    decommit_if_idle((uint64) block, size);
+}
+
+void FreeListAllocator::reset_segregated() {
+    _fl_bitmap = 0;
+    for (uint64 fl = 0; fl < _fl_count; fl++) {
+        _sl_bitmap[fl] = 0;
+        for (uint64 sl = 0; sl < _sl_count; sl++)
+            _bins[fl][sl] = nullptr;
+    }
+
+    // Keep only the initial reserve
+    release_arenas(_arenas);
+    insert_arena(_arenas);
+}
+
+FreeListAllocator::Block* FreeListAllocator::find_segregated(
+    const uint64 size
+) {
+    // Round size up to the next size class, so that any block found will fit
+    const uint64 fl_rounding = 63 - __builtin_clzll(size) - _sl_count_log2;
+    uint64       fl, sl;
+    mapping(size + ((uint64) 1 << fl_rounding) - 1, fl, sl);
+
+    // Search for a non empty bin in this, or any larger class
+    uint32 sl_bitmap = (fl < _fl_count) ? _sl_bitmap[fl] & (~(uint32) 0 << sl)
+                                        : 0;
+    if (sl_bitmap == 0) {
+        const uint64 fl_bitmap =
+            (fl + 1 < _fl_count) ? _fl_bitmap & (~(uint64) 0 << (fl + 1)) : 0;
+        if (fl_bitmap == 0) {
+            // Blocks from the class of the requested size might still fit
+            mapping(size, fl, sl);
+            Block* block = _bins[fl][sl];
+            while (block != nullptr && block_size(block) < size)
+                block = block->next_free;
+            return block;
+        }
+        fl        = __builtin_ctzll(fl_bitmap);
+        sl_bitmap = _sl_bitmap[fl];
+    }
+    sl = __builtin_ctz(sl_bitmap);
+
+    return _bins[fl][sl];
+}
+
+void FreeListAllocator::insert_block(Block* block) {
+    uint64 fl, sl;
+    mapping(block_size(block), fl, sl);
+
+    block->previous_free = nullptr;
+    block->next_free     = _bins[fl][sl];
+    if (block->next_free != nullptr) block->next_free->previous_free = block;
+    _bins[fl][sl] = block;
+
+    _fl_bitmap |= (uint64) 1 << fl;
+    _sl_bitmap[fl] |= (uint32) 1 << sl;
+}
+
+void FreeListAllocator::remove_block(Block* block) {
+    uint64 fl, sl;
+    mapping(block_size(block), fl, sl);
+
+    if (block->next_free != nullptr)
+        block->next_free->previous_free = block->previous_free;
+    if (block->previous_free != nullptr)
+        block->previous_free->next_free = block->next_free;
+    else {
+        _bins[fl][sl] = block->next_free;
+        if (_bins[fl][sl] == nullptr) {
+            _sl_bitmap[fl] &= ~((uint32) 1 << sl);
+            if (_sl_bitmap[fl] == 0) _fl_bitmap &= ~((uint64) 1 << fl);
+        }
+    }
+}
+
+void FreeListAllocator::mapping(const uint64 size, uint64& fl, uint64& sl) {
+    // First level is given by the highest set bit, second level by the next
+    // _sl_count_log2 bits. Blocks are at least 32 bytes so fl >= 5
+    fl = 63 - __builtin_clzll(size);
+    sl = (size >> (fl - _sl_count_log2)) ^ _sl_count;
 }
\ No newline at end of file
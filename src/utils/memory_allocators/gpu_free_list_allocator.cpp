@@ -41,27 +41,25 @@ void* GPUFreeListAllocator::allocate(
     // Search through the free list for a free block that has enough space to
     // allocate our data
     uint64 padding;
-    Node   previous_node, affected_node;
-    find(size, alignment, padding, previous_node, affected_node);
+    Node   affected_node;
+    find(size, alignment, padding, affected_node);
 
-    if (affected_node == _free_list.end())
+    if (affected_node == _free_list.size())
         Logger::fatal(
             ALLOCATOR_LOG, "Free list allocator out of memory error."
         );
 
-    const uint64 offset        = affected_node->offset;
+    auto&        free_block    = _free_list[affected_node];
+    const uint64 offset        = free_block.offset;
     const uint64 required_size = size + padding;
-    const uint64 rest          = affected_node->block_size - required_size;
+    const uint64 rest          = free_block.block_size - required_size;
 
     if (rest > 0) {
-        // We have to split the block into the data block and a free block of
-        // size 'rest'
-        FreeHeader new_free_node {};
-        new_free_node.block_size = rest;
-        new_free_node.offset     = affected_node->offset + required_size;
-        _free_list.insert_after(affected_node, new_free_node);
-    }
-    _free_list.erase_after(previous_node);
+        // Shrink the free block to the 'rest' behind our data. Its position in
+        // the list doesn't change.
+        free_block.block_size = rest;
+        free_block.offset     = offset + required_size;
+    } else _free_list.erase(_free_list.begin() + affected_node);
 
     // Setup data block
     const uint64 data_address = offset + padding;
@@ -75,25 +73,37 @@ void* GPUFreeListAllocator::allocate(
 }
 
 void GPUFreeListAllocator::free(void* ptr) {
-    const uint64           offset            = (uint64) ptr;
-    const AllocationHeader allocation_header = _allocated[offset];
-    _allocated.erase(offset);
+    const uint64 offset     = (uint64) ptr;
+    const auto   allocation = _allocated.find(offset);
+    if (allocation == _allocated.end()) {
+        Logger::error(
+            ALLOCATOR_LOG,
+            "Free called for an address which wasn't allocated. Nothing was ",
+            "done."
+        );
+        return;
+    }
+    const AllocationHeader allocation_header = allocation->second;
+    _allocated.erase(allocation);
 
     FreeHeader free_node {};
     free_node.block_size = allocation_header.block_size;
     free_node.offset     = offset - allocation_header.padding;
 
-    auto prev = _free_list.before_begin();
-    for (auto curr = _free_list.begin(); curr != _free_list.end(); curr++) {
-        if (offset < curr->offset) break;
-        prev = curr;
-    }
-    _free_list.insert_after(prev, free_node);
+    // First free block after the freed one
+    const auto next = std::upper_bound(
+        _free_list.begin(),
+        _free_list.end(),
+        free_node.offset,
+        [](const uint64 offset, const FreeHeader& block) {
+            return offset < block.offset;
+        }
+    );
 
     _used -= free_node.block_size;
 
     // Merge contiguous nodes
-    coalescence(prev, std::next(prev));
+    coalescence(next - _free_list.begin(), free_node);
 }
 
 void GPUFreeListAllocator::reset() {
@@ -104,16 +114,22 @@ void GPUFreeListAllocator::reset() {
     FreeHeader free_node {};
     free_node.block_size = _total_size;
     free_node.offset     = (uint64) _start_ptr;
-    _free_list.emplace_front(free_node);
+    _free_list.push_back(free_node);
+}
+
+bool GPUFreeListAllocator::owns(void* ptr) {
+    // Memory isn't reserved in arenas, only offsets are managed
+    return ptr >= _start_ptr &&
+           (uint64) ptr < (uint64) _start_ptr + _total_size;
 }
 
 bool GPUFreeListAllocator::allocated(const void* ptr, const uint64 size) {
-    // Get iterator to the closest allocated address <= to ptr
+    // Get iterator to the closest allocated address > ptr
     auto it = _allocated.upper_bound((uint64) ptr);
-    it--;
 
     // Check if ptr points to an address before the first allocated address
-    if (it == _allocated.end()) return false;
+    if (it == _allocated.begin()) return false;
+    it--;
     // if this iterator envelops the whole requested region we are good
     return it->first + it->second.block_size >= (uint64) ptr + size;
 }
@@ -126,15 +142,14 @@ void GPUFreeListAllocator::find(
     const uint64 size,
     const uint64 alignment,
     uint64&      padding,
-    Node&        previous_node,
     Node&        found_node
 ) {
     switch (_placement_policy) {
     case FindFirst:
-        find_first(size, alignment, padding, previous_node, found_node);
+        find_first(size, alignment, padding, found_node);
         break;
     case FindBest:
-        find_best(size, alignment, padding, previous_node, found_node);
+        find_best(size, alignment, padding, found_node);
         break;
     }
 }
@@ -143,18 +158,14 @@ void GPUFreeListAllocator::find_first(
     const uint64 size,
     const uint64 alignment,
     uint64&      padding,
-    Node&        previous_node,
     Node&        found_node
 ) {
     // Iterate list and return the first free block with a size >= than given
     // size
-    previous_node = _free_list.before_begin();
-    for (found_node = _free_list.begin(); found_node != _free_list.end();
-         found_node++) {
-        padding = calculate_padding(found_node->offset, alignment);
-        const auto required_space = size + padding;
-        if (found_node->block_size >= required_space) return;
-        previous_node = found_node;
+    for (found_node = 0; found_node < _free_list.size(); found_node++) {
+        const auto& block = _free_list[found_node];
+        padding           = calculate_padding(block.offset, alignment);
+        if (block.block_size >= size + padding) return;
     }
 }
 
@@ -162,42 +173,50 @@ void GPUFreeListAllocator::find_best(
     const uint64 size,
     const uint64 alignment,
     uint64&      padding,
-    Node&        previous_node,
     Node&        found_node
 ) {
-    return;
-    // // Iterate WHOLE list keeping a pointer to the best fit
-    // uint64 smallest_diff = UINT64_MAX;
-    // Node*  best_block    = nullptr;
-
-    // Node *it = _free_list.head, *it_prev = nullptr;
-    // while (it != nullptr) {
-    //     padding = calculate_padding_with_header(
-    //         (uint64) it, alignment, sizeof(AllocationHeader)
-    //     );
-    //     const uint64 required_space = size + padding;
-    //     if (it->data.block_size >= required_space &&
-    //         (it->data.block_size - required_space < smallest_diff)) {
-    //         best_block = it;
-    //     }
-    //     it_prev = it;
-    //     it      = it->next;
-    // }
-    // previous_node = it_prev;
-    // found_node    = best_block;
+    // Iterate WHOLE list keeping the index of the best fit
+    uint64 smallest_diff = UINT64_MAX;
+    uint64 best_padding  = 0;
+    found_node           = _free_list.size();
+
+    for (Node i = 0; i < _free_list.size(); i++) {
+        const auto& block          = _free_list[i];
+        const auto  block_padding  = calculate_padding(block.offset, alignment);
+        const auto  required_space = size + block_padding;
+        if (block.block_size >= required_space &&
+            block.block_size - required_space < smallest_diff) {
+            smallest_diff = block.block_size - required_space;
+            best_padding  = block_padding;
+            found_node    = i;
+        }
+    }
+    padding = best_padding;
 }
 
-void GPUFreeListAllocator::coalescence(Node previous_node, Node free_node) {
-    Node next_node = std::next(free_node);
-    if (next_node != _free_list.end() &&
-        free_node->offset + free_node->block_size == next_node->offset) {
-        free_node->block_size += next_node->block_size;
-        _free_list.erase_after(free_node);
-    }
-    if (previous_node != _free_list.before_begin() &&
-        previous_node->offset + previous_node->block_size ==
-            free_node->offset) {
-        previous_node->block_size += free_node->block_size;
-        _free_list.erase_after(previous_node);
-    }
-}
\ No newline at end of file
+void GPUFreeListAllocator::coalescence(
+    const Node next_node, const FreeHeader free_node
+) {
+    // Merge with contiguous neighbours in place, so the list only shifts when
+    // a block is inserted or two blocks are joined
+    const bool merge_previous =
+        next_node > 0 && _free_list[next_node - 1].offset +
+                                 _free_list[next_node - 1].block_size ==
+                             free_node.offset;
+    const bool merge_next =
+        next_node < _free_list.size() &&
+        free_node.offset + free_node.block_size == _free_list[next_node].offset;
+
+    if (merge_previous) {
+        auto& previous_block = _free_list[next_node - 1];
+        previous_block.block_size += free_node.block_size;
+        if (merge_next) {
+            previous_block.block_size += _free_list[next_node].block_size;
+            _free_list.erase(_free_list.begin() + next_node);
+        }
+    } else if (merge_next) {
+        auto& next_block = _free_list[next_node];
+        next_block.block_size += free_node.block_size;
+        next_block.offset = free_node.offset;
+    } else _free_list.insert(_free_list.begin() + next_node, free_node);
+}
@@ -0,0 +1,468 @@
+#include "memory_allocators/gpu_offset_allocator.hpp"
+
+#include "logger.hpp"
+#include "memory_system.hpp"
+
+#include <algorithm> // max
+
+#define GPU_OFFSET_ALLOCATOR_LOG "GPUOffsetAllocator :: "
+
+// Sizes are binned as small floats: 3 bit mantissa & 5 bit exponent
+static constexpr uint32 mantissa_bits  = 3;
+static constexpr uint32 mantissa_value = 1 << mantissa_bits;
+static constexpr uint32 mantissa_mask  = mantissa_value - 1;
+
+/// @brief Smallest bin whose every region can hold size bytes
+static uint32 get_bin_round_up(const uint32 size) {
+    if (size < mantissa_value) return size;
+
+    const uint32 highest_bit    = 31 - __builtin_clz(size);
+    const uint32 mantissa_start = highest_bit - mantissa_bits;
+    const uint32 exponent       = mantissa_start + 1;
+    uint32       mantissa       = (size >> mantissa_start) & mantissa_mask;
+
+    // Round up if any lower bits are set (may carry into the exponent)
+    const uint32 low_bits_mask = (1 << mantissa_start) - 1;
+    if ((size & low_bits_mask) != 0) mantissa++;
+
+    return (exponent << mantissa_bits) + mantissa;
+}
+/// @brief Bin into which a free region of size bytes is sorted
+static uint32 get_bin_round_down(const uint32 size) {
+    if (size < mantissa_value) return size;
+
+    const uint32 highest_bit    = 31 - __builtin_clz(size);
+    const uint32 mantissa_start = highest_bit - mantissa_bits;
+    const uint32 exponent       = mantissa_start + 1;
+    const uint32 mantissa       = (size >> mantissa_start) & mantissa_mask;
+
+    return (exponent << mantissa_bits) | mantissa;
+}
+/// @brief Smallest region size of a bin
+static uint32 get_bin_size(const uint32 bin) {
+    const uint32 exponent = bin >> mantissa_bits;
+    const uint32 mantissa = bin & mantissa_mask;
+    if (exponent == 0) return mantissa;
+    return (mantissa | mantissa_value) << (exponent - 1);
+}
+
+/// @brief Index of the lowest set bit at or after a given position (or 32)
+static uint32 find_lowest_bit_after(const uint32 mask, const uint32 start) {
+    if (start >= 32) return 32;
+    const uint32 masked = mask & ~((1u << start) - 1);
+    return (masked == 0) ? 32 : __builtin_ctz(masked);
+}
+
+// Constructor & Destructor
+GPUOffsetAllocator::GPUOffsetAllocator(
+    const uint32 total_size, const uint32 max_allocations
+)
+    : _total_size(total_size) {
+    if (total_size == 0 || max_allocations == 0)
+        Logger::fatal(
+            GPU_OFFSET_ALLOCATOR_LOG,
+            "Total size and max allocation count must be greater than 0."
+        );
+
+    // Every allocation takes one node, each free region between them another
+    _max_nodes  = 2 * max_allocations + 1;
+    _nodes      = new (MemoryTag::GPUBuffer) Node[_max_nodes];
+    _free_nodes = new (MemoryTag::GPUBuffer) uint32[_max_nodes];
+    reset();
+}
+GPUOffsetAllocator::~GPUOffsetAllocator() {
+    delete[] _nodes;
+    delete[] _free_nodes;
+}
+
+// /////////////////////////////////// //
+// GPU OFFSET ALLOCATOR PUBLIC METHODS //
+// /////////////////////////////////// //
+
+GPUOffsetAllocator::Allocation GPUOffsetAllocator::allocate(
+    const uint32 size, const uint32 alignment
+) {
+    const uint32 align        = (alignment > 0) ? alignment : 1;
+    const uint64 aligned_size = get_aligned((uint64) size, (uint64) align);
+    if (size == 0 || aligned_size > _total_size) return {};
+
+    uint32 node_index = allocate_node((uint32) aligned_size);
+
+    // Region isn't aligned (buffer was used with other alignments before), try
+    // again with space for padding
+    if (node_index != invalid_handle &&
+        _nodes[node_index].offset % align != 0) {
+        free(node_index);
+        if (aligned_size + align - 1 > _total_size) return {};
+        node_index = allocate_node((uint32) aligned_size + align - 1);
+    }
+    if (node_index == invalid_handle) return {};
+
+    const uint32 offset = _nodes[node_index].offset;
+    Allocation   allocation {};
+    allocation.offset = (uint32) get_aligned((uint64) offset, (uint64) align);
+    allocation.handle = node_index;
+
+    _peak = std::max(_peak, get_used());
+    return allocation;
+}
+
+void GPUOffsetAllocator::free(const uint32 handle) {
+    if (handle >= _max_nodes || !_nodes[handle].used)
+        Logger::fatal(
+            GPU_OFFSET_ALLOCATOR_LOG,
+            "Tried to free an invalid or already freed allocation."
+        );
+
+    Node&  node   = _nodes[handle];
+    uint32 offset = node.offset;
+    uint32 size   = node.size;
+
+    // Merge with free neighbors
+    if (node.neighbor_prev != invalid_handle &&
+        !_nodes[node.neighbor_prev].used) {
+        const Node& prev = _nodes[node.neighbor_prev];
+        offset           = prev.offset;
+        size            += prev.size;
+
+        const uint32 prev_index = node.neighbor_prev;
+        node.neighbor_prev      = prev.neighbor_prev;
+        remove_node_from_bin(prev_index);
+    }
+    if (node.neighbor_next != invalid_handle &&
+        !_nodes[node.neighbor_next].used) {
+        const Node& next = _nodes[node.neighbor_next];
+        size += next.size;
+
+        const uint32 next_index = node.neighbor_next;
+        node.neighbor_next      = next.neighbor_next;
+        remove_node_from_bin(next_index);
+    }
+
+    const uint32 neighbor_prev = node.neighbor_prev;
+    const uint32 neighbor_next = node.neighbor_next;
+
+    // Release allocation node & insert the merged region
+    node.used                       = false;
+    _free_nodes[_free_node_count++] = handle;
+    const uint32 merged_index       = insert_node_into_bin(offset, size);
+
+    // Relink neighbors
+    if (neighbor_prev != invalid_handle) {
+        _nodes[merged_index].neighbor_prev  = neighbor_prev;
+        _nodes[neighbor_prev].neighbor_next = merged_index;
+    } else _first_node = merged_index;
+    if (neighbor_next != invalid_handle) {
+        _nodes[merged_index].neighbor_next  = neighbor_next;
+        _nodes[neighbor_next].neighbor_prev = merged_index;
+    } else _last_node = merged_index;
+}
+
+void GPUOffsetAllocator::reset() {
+    _free_storage      = 0;
+    _peak              = 0;
+    _free_region_count = 0;
+    _used_bins_top     = 0;
+    for (uint32 i = 0; i < _top_bin_count; i++)
+        _used_bins[i] = 0;
+    for (uint32 i = 0; i < _leaf_bin_count; i++)
+        _bin_indices[i] = invalid_handle;
+
+    // Node stack pops in index order
+    _free_node_count = _max_nodes;
+    for (uint32 i = 0; i < _max_nodes; i++) {
+        _free_nodes[i] = _max_nodes - i - 1;
+        _nodes[i].used = false;
+    }
+
+    // Whole region starts as a single free node
+    _first_node = insert_node_into_bin(0, _total_size);
+    _last_node  = _first_node;
+}
+
+void GPUOffsetAllocator::grow(const uint32 total_size) {
+    if (total_size <= _total_size)
+        Logger::fatal(
+            GPU_OFFSET_ALLOCATOR_LOG,
+            "Managed region can only grow, but size ",
+            total_size,
+            " isn't larger than the current ",
+            _total_size,
+            "."
+        );
+
+    const uint32 added_size = total_size - _total_size;
+    Node&        last       = _nodes[_last_node];
+    uint32       offset     = _total_size;
+    uint32       size       = added_size;
+    uint32       previous   = _last_node;
+
+    // Extend the last region if free, otherwise add a new one after it
+    if (!last.used) {
+        offset   = last.offset;
+        size    += last.size;
+        previous = last.neighbor_prev;
+        remove_node_from_bin(_last_node);
+    } else if (_free_node_count == 0)
+        Logger::fatal(
+            GPU_OFFSET_ALLOCATOR_LOG,
+            "No nodes left to describe the grown region."
+        );
+
+    const uint32 index = insert_node_into_bin(offset, size);
+    if (previous != invalid_handle) {
+        _nodes[index].neighbor_prev    = previous;
+        _nodes[previous].neighbor_next = index;
+    } else _first_node = index;
+    _last_node  = index;
+    _total_size = total_size;
+}
+
+bool GPUOffsetAllocator::allocated(
+    const uint32 offset, const uint32 size
+) const {
+    // Walk all regions in address order
+    for (uint32 index = _first_node; index != invalid_handle;
+         index        = _nodes[index].neighbor_next) {
+        const Node& node = _nodes[index];
+        if (offset < node.offset || offset >= node.offset + node.size)
+            continue;
+        return node.used && (uint64) offset + size <=
+                                (uint64) node.offset + node.size;
+    }
+    return false;
+}
+
+uint32 GPUOffsetAllocator::get_largest_free_region() const {
+    if (_used_bins_top == 0) return 0;
+
+    const uint32 top_bin  = 31 - __builtin_clz(_used_bins_top);
+    const uint32 leaf_bin = 31 - __builtin_clz((uint32) _used_bins[top_bin]);
+    return get_bin_size((top_bin << mantissa_bits) | leaf_bin);
+}
+
+GPUOffsetAllocator::FragmentationStats GPUOffsetAllocator::get_fragmentation(
+) const {
+    FragmentationStats stats {};
+    stats.free_bytes        = _free_storage;
+    stats.free_region_count = _free_region_count;
+    if (_used_bins_top == 0) return stats;
+
+    // Largest region is in the highest used bin
+    const uint32 top_bin  = 31 - __builtin_clz(_used_bins_top);
+    const uint32 leaf_bin = 31 - __builtin_clz((uint32) _used_bins[top_bin]);
+    const uint32 bin      = (top_bin << mantissa_bits) | leaf_bin;
+    for (uint32 index = _bin_indices[bin]; index != invalid_handle;
+         index        = _nodes[index].bin_next)
+        stats.largest_free_region =
+            std::max(stats.largest_free_region, _nodes[index].size);
+
+    stats.fragmentation =
+        1.0f - (float32) stats.largest_free_region / stats.free_bytes;
+    return stats;
+}
+
+Vector<GPUOffsetAllocator::Region> GPUOffsetAllocator::get_used_regions(
+) const {
+    Vector<Region> regions {};
+    for (uint32 index = _first_node; index != invalid_handle;
+         index        = _nodes[index].neighbor_next) {
+        const Node& node = _nodes[index];
+        if (!node.used) continue;
+
+        // Merge with the previous range if adjacent
+        if (!regions.empty() &&
+            regions.back().offset + regions.back().size == node.offset)
+            regions.back().size += node.size;
+        else regions.push_back({ node.offset, node.size });
+    }
+    return regions;
+}
+
+uint32 GPUOffsetAllocator::plan_defragmentation(
+    const uint32 max_bytes, const uint32 alignment, Vector<Move>& moves
+) {
+    const uint32 align = (alignment > 0) ? alignment : 1;
+
+    uint32 planned_bytes = 0;
+    uint32 failed_moves  = 0;
+    uint32 index         = _last_node;
+    while (index != invalid_handle && failed_moves < _max_failed_moves) {
+        const uint32 offset = _nodes[index].offset;
+        const uint32 size   = _nodes[index].size;
+        if (!_nodes[index].used || _nodes[index].moving) {
+            index = _nodes[index].neighbor_prev;
+            continue;
+        }
+        if (planned_bytes + (uint64) size > max_bytes) {
+            failed_moves++;
+            index = _nodes[index].neighbor_prev;
+            continue;
+        }
+
+        // Destination must keep the offset modulo alignment
+        uint32 destination = allocate_node(size);
+        if (destination != invalid_handle &&
+            _nodes[destination].offset % align != offset % align) {
+            free(destination);
+            destination = (size + (uint64) align - 1 <= _total_size)
+                              ? allocate_node(size + align - 1)
+                              : invalid_handle;
+        }
+        if (destination == invalid_handle) break;
+
+        const uint32 destination_start  = _nodes[destination].offset;
+        const uint32 destination_offset =
+            destination_start +
+            (offset % align + align - destination_start % align) % align;
+
+        // Only moves toward the start help
+        if (destination_offset >= offset) {
+            free(destination);
+            failed_moves++;
+            index = _nodes[index].neighbor_prev;
+            continue;
+        }
+
+        Move move {};
+        move.source_handle      = index;
+        move.destination_handle = destination;
+        move.source_offset      = offset;
+        move.destination_offset = destination_offset;
+        move.size               = size;
+        moves.push_back(move);
+
+        // Source stays allocated until freed by the caller, skip it from now
+        _nodes[index].moving  = true;
+        planned_bytes        += size;
+        failed_moves          = 0;
+        index                 = _nodes[index].neighbor_prev;
+    }
+
+    _peak = std::max(_peak, get_used());
+    return planned_bytes;
+}
+
+// //////////////////////////////////// //
+// GPU OFFSET ALLOCATOR PRIVATE METHODS //
+// //////////////////////////////////// //
+
+uint32 GPUOffsetAllocator::allocate_node(const uint32 size) {
+    // Splitting a region requires a spare node
+    if (_free_node_count == 0) return invalid_handle;
+
+    // Find the smallest bin which is guaranteed to fit
+    const uint32 min_bin      = get_bin_round_up(size);
+    const uint32 min_top_bin  = min_bin >> mantissa_bits;
+    const uint32 min_leaf_bin = min_bin & mantissa_mask;
+
+    uint32 top_bin  = min_top_bin;
+    uint32 leaf_bin = 32;
+    if (_used_bins_top & (1u << top_bin))
+        leaf_bin = find_lowest_bit_after(_used_bins[top_bin], min_leaf_bin);
+    if (leaf_bin == 32) {
+        top_bin = find_lowest_bit_after(_used_bins_top, min_top_bin + 1);
+        if (top_bin != 32) leaf_bin = __builtin_ctz(_used_bins[top_bin]);
+    }
+
+    uint32 bin = (top_bin << mantissa_bits) | leaf_bin;
+    if (top_bin == 32) {
+        // Regions in the bin below might still fit, check its first one
+        bin = get_bin_round_down(size);
+        if (_bin_indices[bin] == invalid_handle ||
+            _nodes[_bin_indices[bin]].size < size)
+            return invalid_handle;
+    }
+
+    // Take the first region of the bin
+    const uint32 node_index  = _bin_indices[bin];
+    Node&        node        = _nodes[node_index];
+    const uint32 region_size = node.size;
+    remove_node_from_bin(node_index);
+
+    // Node was returned to the free node stack by removal, take it back
+    _free_node_count--;
+    node.size   = size;
+    node.used   = true;
+    node.moving = false;
+
+    // Return the rest of the region to bins
+    const uint32 remainder = region_size - size;
+    if (remainder > 0) {
+        const uint32 rest_index =
+            insert_node_into_bin(node.offset + size, remainder);
+        Node& rest = _nodes[rest_index];
+
+        if (node.neighbor_next != invalid_handle)
+            _nodes[node.neighbor_next].neighbor_prev = rest_index;
+        rest.neighbor_next = node.neighbor_next;
+        rest.neighbor_prev = node_index;
+        node.neighbor_next = rest_index;
+        if (rest.neighbor_next == invalid_handle) _last_node = rest_index;
+    }
+
+    return node_index;
+}
+
+uint32 GPUOffsetAllocator::insert_node_into_bin(
+    const uint32 offset, const uint32 size
+) {
+    const uint32 bin      = get_bin_round_down(size);
+    const uint32 top_bin  = bin >> mantissa_bits;
+    const uint32 leaf_bin = bin & mantissa_mask;
+
+    // Mark bin as used
+    if (_bin_indices[bin] == invalid_handle) {
+        _used_bins[top_bin] |= 1 << leaf_bin;
+        _used_bins_top |= 1u << top_bin;
+    }
+
+    // Push to the front of the bin list
+    const uint32 top_index  = _bin_indices[bin];
+    const uint32 node_index = _free_nodes[--_free_node_count];
+    Node&        node       = _nodes[node_index];
+
+    node.offset        = offset;
+    node.size          = size;
+    node.bin_prev      = invalid_handle;
+    node.bin_next      = top_index;
+    node.neighbor_prev = invalid_handle;
+    node.neighbor_next = invalid_handle;
+    node.used          = false;
+
+    if (top_index != invalid_handle) _nodes[top_index].bin_prev = node_index;
+    _bin_indices[bin] = node_index;
+
+    _free_storage += size;
+    _free_region_count++;
+    return node_index;
+}
+
+void GPUOffsetAllocator::remove_node_from_bin(const uint32 node_index) {
+    const Node& node = _nodes[node_index];
+
+    if (node.bin_prev != invalid_handle) {
+        // Not the first node of its bin, just unlink it
+        _nodes[node.bin_prev].bin_next = node.bin_next;
+        if (node.bin_next != invalid_handle)
+            _nodes[node.bin_next].bin_prev = node.bin_prev;
+    } else {
+        const uint32 bin      = get_bin_round_down(node.size);
+        const uint32 top_bin  = bin >> mantissa_bits;
+        const uint32 leaf_bin = bin & mantissa_mask;
+
+        _bin_indices[bin] = node.bin_next;
+        if (node.bin_next != invalid_handle)
+            _nodes[node.bin_next].bin_prev = invalid_handle;
+
+        // Mark bin as unused once empty
+        if (_bin_indices[bin] == invalid_handle) {
+            _used_bins[top_bin] &= ~(1 << leaf_bin);
+            if (_used_bins[top_bin] == 0) _used_bins_top &= ~(1u << top_bin);
+        }
+    }
+
+    _free_nodes[_free_node_count++] = node_index;
+    _free_storage -= node.size;
+    _free_region_count--;
+}
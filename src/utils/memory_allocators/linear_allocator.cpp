@@ -6,29 +6,46 @@
 
 // Constructor & Destructor
 LinearAllocator::LinearAllocator(const uint64 total_size)
-    : Allocator(total_size) {}
+    : Allocator(total_size), _offset(0), _current_arena(nullptr) {}
 
 // /////////////////////////////// //
 // LINEAR ALLOCATOR PUBLIC METHODS //
 // /////////////////////////////// //
 
 void* LinearAllocator::allocate(const uint64 size, const uint64 alignment) {
-    uint64       padding         = 0;
-    const uint64 current_address = (uint64) _start_ptr + _offset;
+    uint64 padding         = 0;
+    uint64 current_address = (uint64) _current_arena->start + _offset;
 
     // If alignment is required:
     // Find the next aligned memory address and update offset
-    if (alignment != 0 && _offset % alignment != 0)
+    if (alignment != 0 && current_address % alignment != 0)
         padding = calculate_padding(current_address, alignment);
 
-    if (_offset + padding + size > _total_size)
-        Logger::fatal(ALLOCATOR_LOG, "Linear allocator out of memory error.");
+    // Continue in the next arena if this one is full
+    while (_offset + padding + size > _current_arena->size) {
+        if (_current_arena->next == nullptr &&
+            add_arena(size + alignment) == nullptr)
+            Logger::fatal(
+                ALLOCATOR_LOG, "Linear allocator out of memory error."
+            );
+
+        // Skipped space counts as used
+        _used += _current_arena->size - _offset;
+
+        _current_arena  = _current_arena->next;
+        _offset         = 0;
+        current_address = (uint64) _current_arena->start;
+        padding         = 0;
+        if (alignment != 0)
+            padding = calculate_padding(current_address, alignment);
+    }
 
     _offset += padding + size; // Apply padding & Move by size
+    commit_arena(_current_arena, _offset);
     const uint64 next_address = current_address + padding;
 
     // Debug data
-    _used = _offset;
+    _used += padding + size;
     _peak = std::max(_peak, _used);
 
     return (void*) next_address;
@@ -43,7 +60,11 @@ void LinearAllocator::free(void* ptr) {
 }
 
 void LinearAllocator::reset() {
-    _offset = 0;
-    _used   = 0;
-    _peak   = 0;
+    // Arenas which weren't reached since the last reset are idle
+    if (_current_arena != nullptr) decommit_arenas(_current_arena);
+
+    _current_arena = _arenas;
+    _offset        = 0;
+    _used          = 0;
+    _peak          = 0;
 }
\ No newline at end of file
@@ -34,16 +34,15 @@ void* PoolAllocator::allocate(
             "Allocation size for pool allocator must be equal to chunk size."
         );
 
-    Node* free_position = _free_list.pop();
-
-    if (free_position == nullptr)
-        Logger::fatal(ALLOCATOR_LOG, "The pool allocator is full");
+    // Reuse freed chunks first
+    void* free_position = (_free_list.head != nullptr) ? _free_list.pop()
+                                                       : carve_chunk();
 
     // Debug info
     _used += _chunk_size;
     _peak = std::max(_peak, _used);
 
-    return (void*) free_position;
+    return free_position;
 }
 
 void PoolAllocator::free(void* ptr) {
@@ -55,10 +54,28 @@ void PoolAllocator::reset() {
     _used = 0;
     _peak = 0;
 
-    // Create a linked-list with all free positions
-    const int chunk_count = _total_size / _chunk_size;
-    for (int i = 0; i < chunk_count; ++i) {
-        uint64 address = (uint64) _start_ptr + i * _chunk_size;
-        _free_list.push((Node*) address);
+    // Keep only the initial reserve
+    release_arenas(_arenas);
+    _free_list.head = nullptr;
+    _carve_arena    = _arenas;
+    _carve_offset   = 0;
+}
+
+// ////////////////////////////// //
+// POOL ALLOCATOR PRIVATE METHODS //
+// ////////////////////////////// //
+
+void* PoolAllocator::carve_chunk() {
+    // Continue in the next arena, or add one, if this one is full
+    while (_carve_offset + _chunk_size > _carve_arena->size) {
+        if (_carve_arena->next == nullptr && add_arena(_total_size) == nullptr)
+            Logger::fatal(ALLOCATOR_LOG, "The pool allocator is full");
+        _carve_arena  = _carve_arena->next;
+        _carve_offset = 0;
     }
+
+    void* const chunk = (void*) ((uint64) _carve_arena->start + _carve_offset);
+    _carve_offset += _chunk_size;
+    commit_arena(_carve_arena, _carve_offset);
+    return chunk;
 }
\ No newline at end of file
@@ -6,34 +6,46 @@
 
 // Constructor & Destructor
 StackAllocator::StackAllocator(const uint64 total_size)
-    : Allocator(total_size) {}
+    : Allocator(total_size), _offset(0), _current_arena(nullptr) {}
 
 // ////////////////////////////// //
 // STACK ALLOCATOR PUBLIC METHODS //
 // ////////////////////////////// //
 
 void* StackAllocator::allocate(const uint64 size, const uint64 alignment) {
-    const uint64 current_address = (uint64) _start_ptr + _offset;
-
-    uint64 padding = calculate_padding_with_header(
+    uint64 current_address = (uint64) _current_arena->start + _offset;
+    uint64 padding         = calculate_padding_with_header(
         current_address, alignment, sizeof(AllocationHeader)
     );
 
-    if (_offset + padding + size > _total_size)
-        Logger::fatal(ALLOCATOR_LOG, "Linear allocator out of memory error.");
+    // Continue in the next arena if this one is full
+    while (_offset + padding + size > _current_arena->size) {
+        if (_current_arena->next == nullptr &&
+            add_arena(size + alignment + sizeof(AllocationHeader)) == nullptr)
+            Logger::fatal(
+                ALLOCATOR_LOG, "Stack allocator out of memory error."
+            );
+
+        // Skipped space counts as used
+        _used += _current_arena->size - _offset;
 
-    _offset += padding;
+        _current_arena  = _current_arena->next;
+        _offset         = 0;
+        current_address = (uint64) _current_arena->start;
+        padding         = calculate_padding_with_header(
+            current_address, alignment, sizeof(AllocationHeader)
+        );
+    }
 
-    const uint64      next_address   = current_address + padding;
-    const uint64      header_address = next_address - sizeof(AllocationHeader);
-    AllocationHeader  allocation_header { (uint8) padding };
-    AllocationHeader* header_ptr = (AllocationHeader*) header_address;
-    header_ptr                   = &allocation_header;
+    _offset += padding + size;
+    commit_arena(_current_arena, _offset);
 
-    _offset += size;
+    const uint64 next_address   = current_address + padding;
+    const uint64 header_address = next_address - sizeof(AllocationHeader);
+    ((AllocationHeader*) header_address)->padding = (uint8) padding;
 
     // Debug variables
-    _used = _offset;
+    _used += padding + size;
     _peak = std::max(_peak, _used);
 
     return (void*) next_address;
@@ -47,13 +59,28 @@ void StackAllocator::free(void* ptr) {
         (AllocationHeader*) header_address
     };
 
-    _offset =
-        current_address - (uint64) _start_ptr - allocation_header->padding;
-    _used = _offset;
+    // Stack top might move back to a previous arena
+    uint64 released = _offset;
+    if (ptr < _current_arena->start ||
+        current_address >= (uint64) _current_arena->start + _offset) {
+        _current_arena = find_arena(ptr);
+        released += _current_arena->size;
+
+        // Keep one arena above the top committed, to avoid thrashing
+        if (_current_arena->next != nullptr)
+            decommit_arenas(_current_arena->next);
+    }
+
+    _offset = current_address - (uint64) _current_arena->start -
+              allocation_header->padding;
+    _used -= released - _offset;
 }
 
 void StackAllocator::reset() {
-    _offset = 0;
-    _used   = 0;
-    _peak   = 0;
+    if (_current_arena != nullptr) decommit_arenas(_current_arena);
+
+    _current_arena = _arenas;
+    _offset        = 0;
+    _used          = 0;
+    _peak          = 0;
 }
\ No newline at end of file
@@ -0,0 +1,221 @@
+#include "memory_allocators/thread_cache.hpp"
+
+#include <new>
+#include <stdlib.h> /* malloc */
+
+MemorySystem::ThreadCache*
+    MemorySystem::ThreadCache::_registry[max_thread_caches] = {};
+std::atomic<uint32> MemorySystem::ThreadCache::_registry_size { 0 };
+std::mutex          MemorySystem::ThreadCache::_registry_lock {};
+
+thread_local MemorySystem::ThreadCache* MemorySystem::ThreadCache::_local =
+    nullptr;
+thread_local bool MemorySystem::ThreadCache::_released = false;
+
+// Constructor & Destructor
+MemorySystem::ThreadCache::ThreadCache(const uint8 id)
+    : _id(id), _active(true), _inbox(nullptr) {}
+MemorySystem::ThreadCache::~ThreadCache() {}
+
+MemorySystem::ThreadCache::Releaser::~Releaser() {
+    if (_local == nullptr) return;
+    _local->release();
+    _local    = nullptr;
+    _released = true;
+}
+
+// ////////////////////////////////// //
+// THREAD CACHE PUBLIC STATIC METHODS //
+// ////////////////////////////////// //
+
+MemorySystem::ThreadCache* MemorySystem::ThreadCache::get() {
+    if (_local != nullptr) return _local;
+    if (_released) return nullptr;
+
+    _local = acquire();
+    if (_local != nullptr) {
+        // Register release on thread exit
+        static thread_local Releaser releaser {};
+        (void) releaser;
+    }
+    return _local;
+}
+
+void MemorySystem::ThreadCache::free(void* block, const MEMORY_TAG_TYPE tag) {
+    const auto header = (AllocationHeader*) block;
+    auto       cache  = _local;
+
+    // Owned by this thread
+    if (cache != nullptr && header->owner == cache->_id) {
+        auto& magazine = cache->_magazines[tag][header->size_class];
+        cache->push(magazine, block);
+
+        // Keep at most two batches worth of blocks
+        if (magazine.count > 2 * magazine.batch_size)
+            cache->flush(tag, header->size_class, magazine.batch_size);
+        return;
+    }
+
+    // Thread is exiting, return block directly to its allocator
+    if (cache == nullptr) {
+        std::lock_guard<std::recursive_mutex> lock { *_allocator_locks[tag] };
+        _allocator_map[tag]->free(block);
+        return;
+    }
+
+    // Owned by another thread, push to its inbox
+    auto  owner = _registry[header->owner];
+    void* head  = owner->_inbox.load(std::memory_order_relaxed);
+    do {
+        next_of(block) = head;
+    } while (!owner->_inbox.compare_exchange_weak(
+        head, block, std::memory_order_release, std::memory_order_relaxed
+    ));
+}
+
+// /////////////////////////// //
+// THREAD CACHE PUBLIC METHODS //
+// /////////////////////////// //
+
+void* MemorySystem::ThreadCache::allocate(
+    const MEMORY_TAG_TYPE tag, const uint64 size
+) {
+    const uint8 size_class = get_size_class(tag, size);
+    if (size_class == 0) return nullptr;
+
+    // Reclaim blocks freed by other threads
+    if (_inbox.load(std::memory_order_relaxed) != nullptr) drain_inbox();
+
+    auto& magazine = _magazines[tag][size_class];
+    if (magazine.count == 0) {
+        const uint64 block_size = (size_class == fixed_size_class)
+                                      ? size
+                                      : size_classes[size_class];
+        refill(tag, size_class, block_size);
+    }
+
+    // Pop
+    void* block   = magazine.head;
+    magazine.head = next_of(block);
+    magazine.count--;
+
+    const auto header  = (AllocationHeader*) block;
+    header->size_class = size_class;
+    header->owner      = _id;
+
+    return block;
+}
+
+// /////////////////////////////////// //
+// THREAD CACHE PRIVATE STATIC METHODS //
+// /////////////////////////////////// //
+
+MemorySystem::ThreadCache* MemorySystem::ThreadCache::acquire() {
+    std::lock_guard<std::mutex> lock { _registry_lock };
+
+    // Adopt a cache of an exited thread
+    const uint32 registry_size = _registry_size.load();
+    for (uint32 i = 0; i < registry_size; i++) {
+        auto cache = _registry[i];
+        if (cache->_active.load()) continue;
+        cache->_active.store(true);
+        cache->drain_inbox();
+        return cache;
+    }
+
+    // Create a new one
+    if (registry_size == max_thread_caches) return nullptr;
+    void* memory = malloc(sizeof(ThreadCache));
+    if (memory == nullptr) return nullptr;
+
+    auto cache               = new (memory) ThreadCache((uint8) registry_size);
+    _registry[registry_size] = cache;
+    _registry_size.store(registry_size + 1);
+    return cache;
+}
+
+uint8 MemorySystem::ThreadCache::get_size_class(
+    const MEMORY_TAG_TYPE tag, const uint64 size
+) {
+    switch (_cache_policy[tag]) {
+    case CachePolicy::FixedSize: return fixed_size_class;
+    case CachePolicy::SizeClass:
+        for (uint8 i = 1; i < size_class_count; i++)
+            if (size <= size_classes[i]) return i;
+        return 0;
+    default: return 0;
+    }
+}
+
+uint32 MemorySystem::ThreadCache::get_batch_size(const uint64 block_size) {
+    // Move around 4 KB per batch
+    const uint64 batch_size = 4096 / block_size;
+    if (batch_size < 2) return 2;
+    if (batch_size > 32) return 32;
+    return (uint32) batch_size;
+}
+
+void*& MemorySystem::ThreadCache::next_of(void* block) {
+    // Header must stay intact, so link is stored right after it
+    return *(void**) ((uint64) block + MEMORY_PADDING);
+}
+
+// //////////////////////////// //
+// THREAD CACHE PRIVATE METHODS //
+// //////////////////////////// //
+
+void MemorySystem::ThreadCache::release() {
+    drain_inbox();
+    for (MEMORY_TAG_TYPE tag = 0; tag < _tag_count; tag++)
+        for (uint8 size_class = 0; size_class <= size_class_count;
+             size_class++)
+            flush(tag, size_class, _magazines[tag][size_class].count);
+    _active.store(false);
+}
+
+void MemorySystem::ThreadCache::drain_inbox() {
+    void* block = _inbox.exchange(nullptr, std::memory_order_acquire);
+    while (block != nullptr) {
+        void*      next   = next_of(block);
+        const auto header = (AllocationHeader*) block;
+        const auto tag    = (MEMORY_TAG_TYPE) (header->tag >> 4);
+        push(_magazines[tag][header->size_class], block);
+        block = next;
+    }
+}
+
+void MemorySystem::ThreadCache::push(Magazine& magazine, void* block) {
+    next_of(block) = magazine.head;
+    magazine.head  = block;
+    magazine.count++;
+}
+
+void MemorySystem::ThreadCache::refill(
+    const MEMORY_TAG_TYPE tag,
+    const uint8           size_class,
+    const uint64          block_size
+) {
+    auto& magazine      = _magazines[tag][size_class];
+    magazine.batch_size = get_batch_size(block_size);
+
+    std::lock_guard<std::recursive_mutex> lock { *_allocator_locks[tag] };
+    auto allocator = _allocator_map[tag];
+    for (uint32 i = 0; i < magazine.batch_size; i++)
+        push(magazine, allocator->allocate(block_size, MEMORY_PADDING));
+}
+
+void MemorySystem::ThreadCache::flush(
+    const MEMORY_TAG_TYPE tag, const uint8 size_class, const uint32 count
+) {
+    auto& magazine = _magazines[tag][size_class];
+    if (count == 0 || magazine.count == 0) return;
+
+    std::lock_guard<std::recursive_mutex> lock { *_allocator_locks[tag] };
+    auto allocator = _allocator_map[tag];
+    for (uint32 i = 0; i < count && magazine.head != nullptr; i++) {
+        void* block   = magazine.head;
+        magazine.head = next_of(block);
+        magazine.count--;
+        allocator->free(block);
+    }
+}
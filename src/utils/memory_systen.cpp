@@ -1,7 +1,14 @@
 #include "memory_system.hpp"
+#include "memory_allocators/thread_cache.hpp"
+#include "object_pool.hpp"
 
 #include "resources/material.hpp"
 
+#include <sstream>
+#include <iomanip>
+#include <algorithm> // upper_bound
+#include <stdlib.h>  // malloc
+
 static_assert(
     sizeof(MEMORY_TAG_TYPE) <= MEMORY_PADDING || MEMORY_PADDING >= 8,
     "Memory padding must be at least 8."
@@ -13,9 +20,308 @@ static_assert(
     "representation are used to recognize custom allocation)"
 );
 
+std::recursive_mutex*     MemorySystem::_allocator_locks[_tag_count] = {};
+MemorySystem::CachePolicy MemorySystem::_cache_policy[_tag_count]    = {};
+MemorySystem::TagCounters MemorySystem::_counters[_tag_count]        = {};
+std::atomic<uint64>       MemorySystem::_frame_count { 0 };
+uint64                    MemorySystem::_headerless_size[_tag_count] = {};
+std::atomic<MemorySystem::ArenaTable*> MemorySystem::_arena_table {
+    nullptr
+};
+std::mutex MemorySystem::_arena_table_lock {};
+
 Allocator** MemorySystem::_allocator_map =
     MemorySystem::initialize_allocator_map();
 
+// Tag names used in memory reports
+static const char* const tag_names[] = {
+    "Unknown",
+    "Temp",
+    "Frame",
+    "Array",
+    "List",
+    "Map",
+    "Set",
+    "String",
+    "Callback",
+    "Application",
+    "Surface",
+    "System",
+    "Renderer",
+    "GPUTexture",
+    "GPUBuffer",
+    "Resource",
+    "Texture",
+    "MaterialInstance",
+    "Geometry",
+    "Shader",
+    "Game",
+    "Job",
+    "Transform",
+    "Entity",
+    "EntityNode",
+    "Scene",
+};
+static_assert(
+    sizeof(tag_names) / sizeof(tag_names[0]) == (uint64) MemoryTag::MAX_TAGS,
+    "Every memory tag requires a name."
+);
+
+// Snapshot of all memory statistics
+struct MemoryReport {
+    struct AllocatorUsage {
+        const Allocator* allocator;
+        uint64           used;
+        uint64           peak;
+        uint64           reserved;
+        MEMORY_TAG_TYPE  tags[(uint64) MemoryTag::MAX_TAGS];
+        uint32           tag_count;
+    };
+
+    uint64                      frame;
+    MemorySystem::TagStatistics tags[(uint64) MemoryTag::MAX_TAGS];
+    AllocatorUsage              allocators[(uint64) MemoryTag::MAX_TAGS];
+    uint32                      allocator_count;
+};
+
+static String write_table_report(const MemoryReport& report) {
+    const uint32 tag_count = (uint32) MemoryTag::MAX_TAGS;
+
+    std::ostringstream out {};
+    out << "Memory report (frame " << report.frame << ")\n";
+#if !MEMORY_TELEMETRY_ENABLED
+    out << "Tag telemetry is disabled (MEMORY_TELEMETRY_ENABLED)\n";
+#endif
+
+    // Tag counters
+    out << std::left << std::setw(18) << "Tag" << std::right << std::setw(14)
+        << "Live" << std::setw(14) << "Peak" << std::setw(10) << "Count"
+        << std::setw(12) << "Allocs" << std::setw(12) << "Last frame"
+        << std::setw(12) << "Max frame" << "\n";
+    for (uint32 i = 0; i < tag_count; i++) {
+        const auto& tag = report.tags[i];
+        if (tag.allocation_count == 0) continue;
+        out << std::left << std::setw(18) << tag_names[i] << std::right
+            << std::setw(14) << tag.live_bytes << std::setw(14)
+            << tag.peak_bytes << std::setw(10) << tag.live_count
+            << std::setw(12) << tag.allocation_count << std::setw(12)
+            << tag.last_frame_allocations << std::setw(12)
+            << tag.max_frame_allocations << "\n";
+    }
+
+    // Size histogram
+    out << "\n" << std::left << std::setw(18) << "Size" << std::right;
+    for (uint32 j = 0; j + 1 < MemorySystem::histogram_bucket_count; j++)
+        out << std::setw(9) << ("<=" + std::to_string(16ull << j));
+    out << std::setw(9) << "more" << "\n";
+    for (uint32 i = 0; i < tag_count; i++) {
+        const auto& tag = report.tags[i];
+        if (tag.allocation_count == 0) continue;
+        out << std::left << std::setw(18) << tag_names[i] << std::right;
+        for (uint32 j = 0; j < MemorySystem::histogram_bucket_count; j++)
+            out << std::setw(9) << tag.size_histogram[j];
+        out << "\n";
+    }
+
+    // Allocators
+    out << "\n" << std::left << std::setw(18) << "Allocator" << std::right
+        << std::setw(14) << "Used" << std::setw(14) << "Peak"
+        << std::setw(14) << "Reserved" << "  Tags\n";
+    for (uint32 i = 0; i < report.allocator_count; i++) {
+        const auto& usage = report.allocators[i];
+        out << std::left << std::setw(18) << i << std::right << std::setw(14)
+            << usage.used << std::setw(14) << usage.peak << std::setw(14)
+            << usage.reserved << " ";
+        for (uint32 j = 0; j < usage.tag_count; j++)
+            out << " " << tag_names[usage.tags[j]];
+        out << "\n";
+    }
+
+    return out.str();
+}
+
+static String write_json_report(const MemoryReport& report) {
+    const uint32 tag_count = (uint32) MemoryTag::MAX_TAGS;
+
+    std::ostringstream out {};
+    out << "{\"frame\":" << report.frame << ",\"tags\":[";
+    for (uint32 i = 0; i < tag_count; i++) {
+        const auto& tag = report.tags[i];
+        out << (i > 0 ? "," : "") << "{\"tag\":\"" << tag_names[i] << "\""
+            << ",\"live_bytes\":" << tag.live_bytes
+            << ",\"peak_bytes\":" << tag.peak_bytes
+            << ",\"live_count\":" << tag.live_count
+            << ",\"allocation_count\":" << tag.allocation_count
+            << ",\"last_frame_allocations\":" << tag.last_frame_allocations
+            << ",\"max_frame_allocations\":" << tag.max_frame_allocations
+            << ",\"size_histogram\":[";
+        for (uint32 j = 0; j < MemorySystem::histogram_bucket_count; j++)
+            out << (j > 0 ? "," : "") << tag.size_histogram[j];
+        out << "]}";
+    }
+    out << "],\"allocators\":[";
+    for (uint32 i = 0; i < report.allocator_count; i++) {
+        const auto& usage = report.allocators[i];
+        out << (i > 0 ? "," : "") << "{\"used\":" << usage.used
+            << ",\"peak\":" << usage.peak
+            << ",\"reserved\":" << usage.reserved << ",\"tags\":[";
+        for (uint32 j = 0; j < usage.tag_count; j++)
+            out << (j > 0 ? "," : "") << "\"" << tag_names[usage.tags[j]]
+                << "\"";
+        out << "]}";
+    }
+    out << "]}";
+
+    return out.str();
+}
+
+// //////////////////////////// //
+// MEMORY SYSTEM PUBLIC METHODS //
+// //////////////////////////// //
+
+void* MemorySystem::allocate(uint64 size, const MemoryTag tag) {
+    const auto tag_index = (MEMORY_TAG_TYPE) tag;
+    const auto allocator = _allocator_map[tag_index];
+    void*      block     = nullptr;
+
+    // Thread safe allocators are used without locking
+    std::unique_lock<std::recursive_mutex> lock {
+        *_allocator_locks[tag_index], std::defer_lock
+    };
+
+    // No header, owner is recognized by address
+    if (_headerless_size[tag_index] != 0) {
+        if (!allocator->is_thread_safe()) lock.lock();
+        return allocator->allocate(size);
+    }
+
+    // Try thread local cache first
+    if (_cache_policy[tag_index] != CachePolicy::None) {
+        auto cache = ThreadCache::get();
+        if (cache != nullptr) block = cache->allocate(tag_index, size);
+    }
+    if (block == nullptr) {
+        if (!allocator->is_thread_safe()) lock.lock();
+        block = allocator->allocate(size, MEMORY_PADDING);
+        ((AllocationHeader*) block)->size_class = 0;
+    }
+
+    // If 4 bits of tag are 1111 we are using custom allocator
+    ((AllocationHeader*) block)->tag = (tag_index << 4) | 15;
+
+    return block;
+}
+
+void MemorySystem::deallocate(void* ptr, const MemoryTag tag) {
+    const auto tag_index = (MEMORY_TAG_TYPE) tag;
+
+    // Return to thread cache
+    if (_headerless_size[tag_index] == 0 &&
+        ((AllocationHeader*) ptr)->size_class != 0)
+        return ThreadCache::free(ptr, tag_index);
+
+    const auto allocator = _allocator_map[tag_index];
+
+    // Thread safe allocators are used without locking
+    std::unique_lock<std::recursive_mutex> lock {
+        *_allocator_locks[tag_index], std::defer_lock
+    };
+    if (!allocator->is_thread_safe()) lock.lock();
+
+    // Headerless blocks were already found by address
+    if (_headerless_size[tag_index] == 0 && !allocator->owns(ptr)) {
+        std::cout << MEMORY_SYS_LOG << "Wrong memory tag." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    allocator->free(ptr);
+}
+
+void MemorySystem::reset_memory(const MemoryTag tag) {
+    const auto tag_index = (MEMORY_TAG_TYPE) tag;
+    if (_cache_policy[tag_index] != CachePolicy::None) {
+        std::cout << MEMORY_SYS_LOG
+                  << "Thread cached memory can't be reset." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    std::lock_guard<std::recursive_mutex> lock { *_allocator_locks[tag_index] };
+    _allocator_map[tag_index]->reset();
+}
+
+void MemorySystem::begin_frame(const uint32 frame_index) {
+    const auto tag_index = (MEMORY_TAG_TYPE) MemoryTag::Frame;
+
+    std::lock_guard<std::recursive_mutex> lock { *_allocator_locks[tag_index] };
+    static_cast<FrameAllocator*>(_allocator_map[tag_index])
+        ->begin_frame(frame_index);
+}
+
+MemorySystem::TagStatistics MemorySystem::get_statistics(const MemoryTag tag) {
+    const auto&   counters   = _counters[(MEMORY_TAG_TYPE) tag];
+    TagStatistics statistics = {};
+
+    statistics.live_bytes       = counters.live_bytes.load();
+    statistics.peak_bytes       = counters.peak_bytes.load();
+    statistics.live_count       = counters.live_count.load();
+    statistics.allocation_count = counters.allocation_count.load();
+    statistics.last_frame_allocations = counters.last_frame_allocations.load();
+    statistics.max_frame_allocations  = counters.max_frame_allocations.load();
+    for (uint32 i = 0; i < histogram_bucket_count; i++)
+        statistics.size_histogram[i] = counters.size_histogram[i].load();
+
+    return statistics;
+}
+
+String MemorySystem::get_report(const ReportFormat format) {
+    MemoryReport report = {};
+    report.frame        = _frame_count.load();
+    for (MEMORY_TAG_TYPE i = 0; i < _tag_count; i++)
+        report.tags[i] = get_statistics((MemoryTag) i);
+
+    // Allocator usage (shared allocators are listed once)
+    for (MEMORY_TAG_TYPE i = 0; i < _tag_count; i++) {
+        auto allocator = _allocator_map[i];
+        auto usage     = report.allocators;
+        while (usage < report.allocators + report.allocator_count &&
+               usage->allocator != allocator)
+            usage++;
+
+        if (usage == report.allocators + report.allocator_count) {
+            std::lock_guard<std::recursive_mutex> lock { *_allocator_locks[i]
+            };
+            usage->allocator = allocator;
+            usage->used      = allocator->get_used();
+            usage->peak      = allocator->get_peak();
+            usage->reserved  = allocator->get_reserved();
+            report.allocator_count++;
+        }
+        usage->tags[usage->tag_count++] = i;
+    }
+
+    if (format == ReportFormat::JSON) return write_json_report(report);
+    return write_table_report(report);
+}
+
+void MemorySystem::next_frame() {
+#if MEMORY_TELEMETRY_ENABLED
+    for (auto& counters : _counters) {
+        const uint64 allocations = counters.frame_allocations.exchange(
+            0, std::memory_order_relaxed
+        );
+        counters.last_frame_allocations.store(
+            allocations, std::memory_order_relaxed
+        );
+        if (allocations > counters.max_frame_allocations.load())
+            counters.max_frame_allocations.store(allocations);
+    }
+    _frame_count.fetch_add(1, std::memory_order_relaxed);
+#endif
+}
+
+// ///////////////////////////// //
+// MEMORY SYSTEM PRIVATE METHODS //
+// ///////////////////////////// //
+
 Allocator** MemorySystem::initialize_allocator_map() {
     Allocator** allocator_map =
         new Allocator*[(MEMORY_TAG_TYPE) MemoryTag::MAX_TAGS]();
@@ -24,7 +330,7 @@ Allocator** MemorySystem::initialize_allocator_map() {
     CAllocator*        unknown_allocator = new CAllocator();
     StackAllocator*    temp_allocator    = new StackAllocator(1024 * 1024);
     FreeListAllocator* general_allocator = new FreeListAllocator(
-        1024 * 1024, FreeListAllocator::PlacementPolicy::FindFirst
+        1024 * 1024, FreeListAllocator::PlacementPolicy::SegregatedFit
     );
     FreeListAllocator* gpu_data_allocator = new FreeListAllocator(
         1024 * 1024, FreeListAllocator::PlacementPolicy::FindFirst
@@ -34,21 +340,37 @@ Allocator** MemorySystem::initialize_allocator_map() {
     );
     LinearAllocator* init_allocator = new LinearAllocator(1024 * 1024);
 
-    // Pools
-    uint64 max_texture_count  = 1024;
-    uint64 max_material_count = 1024;
+    // One linear allocator per frame in flight
+    FrameAllocator* frame_allocator =
+        new FrameAllocator(1024 * 1024, max_frames_in_flight);
+
+    // Slot chunks of the texture & material system object pools, sized for
+    // their default capacity (grow in steps of this many chunks when full)
+    uint64 texture_count  = 1024 / ObjectPool<Texture>::chunk_capacity;
+    uint64 material_count = 1024 / ObjectPool<Material>::chunk_capacity;
 
-    uint64 texture_size  = sizeof(Texture) + MEMORY_PADDING;
-    uint64 material_size = sizeof(Material) + MEMORY_PADDING;
+    uint64 texture_size =
+        sizeof(Texture) * ObjectPool<Texture>::chunk_capacity;
+    uint64 material_size =
+        sizeof(Material) * ObjectPool<Material>::chunk_capacity;
+#if !MEMORY_HEADERLESS_POOLS
+    texture_size  += MEMORY_PADDING;
+    material_size += MEMORY_PADDING;
+#endif
 
-    PoolAllocator* texture_pool =
-        new PoolAllocator(max_texture_count * texture_size, texture_size);
-    PoolAllocator* material_pool =
-        new PoolAllocator(max_material_count * material_size, material_size);
+    // Texture & material object pools can be acquired from any thread without
+    // locking, so their allocators are lock-free as well
+    ConcurrentPoolAllocator* texture_pool = new ConcurrentPoolAllocator(
+        texture_count * texture_size, texture_size
+    );
+    ConcurrentPoolAllocator* material_pool = new ConcurrentPoolAllocator(
+        material_count * material_size, material_size
+    );
 
     // Initialize allocators
     unknown_allocator->init();
     temp_allocator->init();
+    frame_allocator->init();
     general_allocator->init();
     gpu_data_allocator->init();
     resource_allocator->init();
@@ -59,6 +381,7 @@ Allocator** MemorySystem::initialize_allocator_map() {
     // Assign allocators
     allocator_map[(MEMORY_TAG_TYPE) MemoryTag::Unknown] = unknown_allocator;
     allocator_map[(MEMORY_TAG_TYPE) MemoryTag::Temp]    = temp_allocator;
+    allocator_map[(MEMORY_TAG_TYPE) MemoryTag::Frame]   = frame_allocator;
 
     allocator_map[(MEMORY_TAG_TYPE) MemoryTag::Array]       = general_allocator;
     allocator_map[(MEMORY_TAG_TYPE) MemoryTag::List]        = general_allocator;
@@ -89,21 +412,152 @@ Allocator** MemorySystem::initialize_allocator_map() {
     allocator_map[(MEMORY_TAG_TYPE) MemoryTag::EntityNode] = unknown_allocator;
     allocator_map[(MEMORY_TAG_TYPE) MemoryTag::Scene]      = unknown_allocator;
 
+    // Create one lock per allocator
+    for (uint64 i = 0; i < _tag_count; i++) {
+        for (uint64 j = 0; j < i; j++) {
+            if (allocator_map[j] != allocator_map[i]) continue;
+            _allocator_locks[i] = _allocator_locks[j];
+            break;
+        }
+        if (_allocator_locks[i] == nullptr)
+            _allocator_locks[i] = new std::recursive_mutex();
+    }
+
+    // Thread cached tags
+    for (auto tag : { MemoryTag::Array,
+                      MemoryTag::List,
+                      MemoryTag::Map,
+                      MemoryTag::Set,
+                      MemoryTag::String,
+                      MemoryTag::Callback,
+                      MemoryTag::Resource,
+                      MemoryTag::Shader })
+        _cache_policy[(MEMORY_TAG_TYPE) tag] = CachePolicy::SizeClass;
+#if MEMORY_HEADERLESS_POOLS
+    // Headerless tags (allocations are recognized by their arena)
+    for (auto tag : { MemoryTag::Texture, MemoryTag::MaterialInstance }) {
+        const auto tag_index = (MEMORY_TAG_TYPE) tag;
+        _headerless_size[tag_index] =
+            (tag == MemoryTag::Texture) ? texture_size : material_size;
+        allocator_map[tag_index]->set_arena_callback(
+            on_arena_change, (void*) (uint64) tag_index
+        );
+    }
+#else
+    for (auto tag : { MemoryTag::Texture, MemoryTag::MaterialInstance })
+        _cache_policy[(MEMORY_TAG_TYPE) tag] = CachePolicy::FixedSize;
+#endif
+
     return allocator_map;
 }
 
-// New
-void* operator new(std::size_t size, MemoryTag tag) {
-    void* full_ptr = MemorySystem::allocate(size + MEMORY_PADDING, tag);
-    void* data_ptr = (void*) ((uint64) full_ptr + MEMORY_PADDING);
+void MemorySystem::record_allocation(
+    const uint64 size, const MEMORY_TAG_TYPE tag
+) {
+    auto& counters = _counters[tag];
 
-    MEMORY_TAG_TYPE tag_data = ((MEMORY_TAG_TYPE) tag) << 4;
-    tag_data |= 15; // 1111
+    // Update peak
+    const uint64 live =
+        counters.live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+    uint64 peak = counters.peak_bytes.load(std::memory_order_relaxed);
+    while (live > peak && !counters.peak_bytes.compare_exchange_weak(
+                              peak, live, std::memory_order_relaxed
+                          )) {}
 
-    MemoryTag* header_ptr = (MemoryTag*) full_ptr;
-    *header_ptr           = (MemoryTag) tag_data;
+    counters.live_count.fetch_add(1, std::memory_order_relaxed);
+    counters.allocation_count.fetch_add(1, std::memory_order_relaxed);
+    counters.frame_allocations.fetch_add(1, std::memory_order_relaxed);
 
-    return data_ptr;
+    // Bucket 0 : [0, 16], bucket i : (8 << i, 16 << i]
+    uint32 bucket = 0;
+    if (size > 16) {
+        bucket = 64 - __builtin_clzll(size - 1) - 4;
+        if (bucket >= histogram_bucket_count)
+            bucket = histogram_bucket_count - 1;
+    }
+    counters.size_histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+void MemorySystem::record_deallocation(
+    const uint64 size, const MEMORY_TAG_TYPE tag
+) {
+    auto& counters = _counters[tag];
+    counters.live_bytes.fetch_sub(size, std::memory_order_relaxed);
+    counters.live_count.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void MemorySystem::on_arena_change(
+    void* user_data, const void* start, const uint64 size, const bool added
+) {
+    std::lock_guard<std::mutex> lock { _arena_table_lock };
+    const auto   old_table = _arena_table.load(std::memory_order_relaxed);
+    const uint32 old_size  = (old_table != nullptr) ? old_table->size : 0;
+    const uint32 new_size  = added ? old_size + 1 : old_size - 1;
+
+    // Copy table, with entry added or removed
+    auto table = (ArenaTable*) malloc(
+        sizeof(ArenaTable) + (uint64) new_size * sizeof(ArenaEntry)
+    );
+    table->size    = new_size;
+    table->entries = (ArenaEntry*) (table + 1);
+    table->retired = old_table;
+
+    const ArenaEntry entry { (uint64) start,
+                             (uint64) start + size,
+                             (MEMORY_TAG_TYPE) (uint64) user_data };
+    uint32 j = 0;
+    for (uint32 i = 0; i < old_size; i++) {
+        const auto& old_entry = old_table->entries[i];
+        if (added && j == i && old_entry.start > entry.start)
+            table->entries[j++] = entry;
+        if (!added && old_entry.start == entry.start) continue;
+        table->entries[j++] = old_entry;
+    }
+    if (added && j == old_size) table->entries[j] = entry;
+
+    // Readers might still use the old table, so it's only retired
+    _arena_table.store(table, std::memory_order_release);
+}
+
+bool MemorySystem::find_headerless_tag(
+    const void* const ptr, MEMORY_TAG_TYPE& out_tag
+) {
+    const auto table = _arena_table.load(std::memory_order_acquire);
+    if (table == nullptr) return false;
+
+    // Find last arena starting at or before ptr
+    const auto address = (uint64) ptr;
+    const auto entry   = std::upper_bound(
+        table->entries,
+        table->entries + table->size,
+        address,
+        [](const uint64 address, const ArenaEntry& entry) {
+            return address < entry.start;
+        }
+    );
+    if (entry == table->entries || address >= (entry - 1)->end) return false;
+
+    out_tag = (entry - 1)->tag;
+    return true;
+}
+
+// New
+void* operator new(std::size_t size, MemoryTag tag) {
+#if MEMORY_TELEMETRY_ENABLED
+    MemorySystem::record_allocation(size, (MEMORY_TAG_TYPE) tag);
+#endif
+#if MEMORY_HEADERLESS_POOLS
+    if (MemorySystem::_headerless_size[(MEMORY_TAG_TYPE) tag] != 0)
+        return MemorySystem::allocate(size, tag);
+#endif
+
+    void* full_ptr = MemorySystem::allocate(size + MEMORY_PADDING, tag);
+#if MEMORY_TELEMETRY_ENABLED
+    // Remember size for delete
+    ((MemorySystem::AllocationHeader*) full_ptr)->size =
+        (size < UINT32_MAX) ? (uint32) size : UINT32_MAX;
+#endif
+    return (void*) ((uint64) full_ptr + MEMORY_PADDING);
 }
 void* operator new[](std::size_t size, const MemoryTag tag) {
     return operator new(size, tag);
@@ -112,6 +566,21 @@ void* operator new[](std::size_t size, const MemoryTag tag) {
 // Delete
 void operator delete(void* p) noexcept {
     if (p == nullptr) return;
+
+#if MEMORY_HEADERLESS_POOLS
+    // Headerless allocations are recognized by their address
+    MEMORY_TAG_TYPE tag_index;
+    if (MemorySystem::find_headerless_tag(p, tag_index)) {
+#    if MEMORY_TELEMETRY_ENABLED
+        MemorySystem::record_deallocation(
+            MemorySystem::_headerless_size[tag_index], tag_index
+        );
+#    endif
+        MemorySystem::deallocate(p, (MemoryTag) tag_index);
+        return;
+    }
+#endif
+
     MEMORY_TAG_TYPE* tag_ptr = (MEMORY_TAG_TYPE*) ((uint64) p - MEMORY_PADDING);
     MemoryTag        tag     = (MemoryTag) ((*tag_ptr) >> 4);
 
@@ -123,6 +592,12 @@ void operator delete(void* p) noexcept {
     if (tag_type != 240) free(p);
     else {
         *tag_type_ptr &= 240;
+#if MEMORY_TELEMETRY_ENABLED
+        MemorySystem::record_deallocation(
+            ((MemorySystem::AllocationHeader*) tag_ptr)->size,
+            (MEMORY_TAG_TYPE) tag
+        );
+#endif
         MemorySystem::deallocate(tag_ptr, tag);
     }
 }
\ No newline at end of file
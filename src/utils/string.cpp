@@ -81,12 +81,8 @@ void String::trim() noexcept {
 }
 
 // Compare methods
-int32 String::compare_ci(const String& other) const {
-    String a = *this;
-    a.to_lower();
-    String b = other;
-    b.to_lower();
-    return a.compare(b);
+int32 String::compare_ci(const StringView other) const {
+    return StringView(*this).compare_ci(other);
 }
 
 // Split methods
@@ -172,6 +168,22 @@ Result<float128, InvalidArgument> String::parse_as_float128() {
     return result;
 }
 
+// //////////////////////////// //
+// STRING VIEW PUBLIC FUNCTIONS //
+// //////////////////////////// //
+
+// Compare methods
+int32 StringView::compare_ci(const StringView other) const noexcept {
+    const auto length = std::min(size(), other.size());
+    for (std::size_t i = 0; i < length; i++) {
+        const int32 a = std::tolower((uchar) (*this)[i]);
+        const int32 b = std::tolower((uchar) other[i]);
+        if (a != b) return a - b;
+    }
+    if (size() == other.size()) return 0;
+    return size() < other.size() ? -1 : 1;
+}
+
 // /////////////////////// //
 // STRING HELPER FUNCTIONS //
 // /////////////////////// //
@@ -235,4 +247,10 @@ void String::add_to_string<String>(
     String& out_string, String component
 ) noexcept {
     out_string += component;
+}
+template<>
+void String::add_to_string<StringView>(
+    String& out_string, StringView component
+) noexcept {
+    out_string += component;
 }
\ No newline at end of file
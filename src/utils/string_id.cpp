@@ -0,0 +1,77 @@
+#include "string_id.hpp"
+
+#include "flat_hash_map.hpp"
+#include "logger.hpp"
+
+#include <cstdio> // snprintf
+#include <mutex>
+
+#define STRING_ID_LOG "StringId :: "
+
+// Interned strings, shared by all threads. Strings are allocated separately
+// so references to them stay valid while the map grows.
+struct InternTable {
+    std::mutex                     lock {};
+    FlatHashMap<StringId, String*> strings { MemoryTag::String };
+
+    ~InternTable() {
+        for (const auto& entry : strings)
+            delete entry.second;
+    }
+};
+InternTable& intern_table() {
+    static InternTable table {};
+    return table;
+}
+
+// //////////////////////// //
+// STRING ID PUBLIC METHODS //
+// //////////////////////// //
+
+const String& StringId::str() const {
+    static const String empty {};
+
+    auto&                       table = intern_table();
+    std::lock_guard<std::mutex> lock { table.lock };
+    auto                        it = table.strings.find(*this);
+    return it != table.strings.end() ? *it->second : empty;
+}
+
+StringId StringId::intern(const StringView name) {
+    const StringId id { name };
+
+    auto&                       table = intern_table();
+    std::lock_guard<std::mutex> lock { table.lock };
+    auto                        it = table.strings.find(id);
+    if (it == table.strings.end())
+        table.strings.emplace(id, new String(name));
+    else if (it->second->compare_ci(name) != 0)
+        Logger::error(
+            STRING_ID_LOG,
+            "Hash collision between \"",
+            *it->second,
+            "\" and \"",
+            name,
+            "\". Both names identify the same object."
+        );
+    return id;
+}
+
+// ////////////////////////// //
+// STRING ID HELPER FUNCTIONS //
+// ////////////////////////// //
+
+template<>
+void String::add_to_string<StringId>(
+    String& out_string, StringId component
+) noexcept {
+    const auto& name = component.str();
+    if (!name.empty()) {
+        out_string += name;
+        return;
+    }
+    // Never interned, hash is all we have
+    char hex[20];
+    snprintf(hex, sizeof(hex), "#%016llx", component.value());
+    out_string += hex;
+}
@@ -0,0 +1,130 @@
+#include "resources/vktex.hpp"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+/// @brief Source image formats converted
+const char* const source_extensions[] = { ".png", ".jpg", ".jpeg", ".tga",
+                                          ".bmp" };
+
+bool is_source_image(const fs::path& path) {
+    auto extension = path.extension().string();
+    for (auto& c : extension)
+        c = (char) std::tolower(c);
+    for (const auto source_extension : source_extensions)
+        if (extension == source_extension) return true;
+    return false;
+}
+
+bool import_image(const fs::path& source_path, const bool compress) {
+    // Decode
+    const uint32 channel_count = 4;
+    int32        width, height, source_channels;
+    stbi_uc*     pixels = stbi_load(
+        source_path.string().c_str(),
+        &width,
+        &height,
+        &source_channels,
+        channel_count
+    );
+    if (!pixels) {
+        std::cout << "Failed to decode " << source_path << " ("
+                  << stbi_failure_reason() << ")." << std::endl;
+        return false;
+    }
+
+    // Check for transparency
+    auto         has_transparency = false;
+    const uint64 total_size       = (uint64) width * height * channel_count;
+    if (source_channels > 3) {
+        for (uint64 i = 3; i < total_size; i += channel_count) {
+            if (pixels[i] < (stbi_uc) 255) {
+                has_transparency = true;
+                break;
+            }
+        }
+    }
+
+    auto mip_chain = Image::create_mip_chain((byte*) pixels, width, height);
+    stbi_image_free(pixels);
+
+    // Loader lowercases names, so should the packed file
+    auto name = source_path.stem().string();
+    for (auto& c : name)
+        c = (char) std::tolower(c);
+
+    Image image {
+        name,
+        (uint32) width,
+        (uint32) height,
+        channel_count,
+        has_transparency,
+        mip_chain,
+        ImageFormat::RGBA8,
+        Image::get_mip_level_count(width, height)
+    };
+
+    // Opaque textures don't need the alpha block
+    if (compress) {
+        auto result = image.compress(
+            has_transparency ? ImageFormat::BC3 : ImageFormat::BC1
+        );
+        if (result.has_error()) {
+            std::cout << "Failed to compress " << source_path << " ("
+                      << result.error().what() << ")." << std::endl;
+            return false;
+        }
+    }
+
+    const auto output_path =
+        (source_path.parent_path() / (name + ".vktex")).string();
+    auto result = VktexFile::write(output_path, &image);
+    if (result.has_error()) {
+        std::cout << result.error().what() << std::endl;
+        return false;
+    }
+
+    std::cout << source_path.string() << " -> " << output_path << " ("
+              << image.width() << "x" << image.height() << ", "
+              << image.mip_level_count() << " mips, "
+              << image.get_size() / 1024 << " KiB)" << std::endl;
+    return true;
+}
+
+// Usage: VulkanEngine_vktex_import [--uncompressed] [image | directory]...
+// Converts all images in ../assets/textures if no paths are given.
+int main(int argc, char** argv) {
+    auto             compress = true;
+    Vector<fs::path> paths {};
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--uncompressed") == 0) compress = false;
+        else paths.push_back(argv[i]);
+    }
+    if (paths.empty()) paths.push_back("../assets/textures");
+
+    uint32 failed_count = 0;
+    for (const auto& path : paths) {
+        std::error_code error;
+        if (fs::is_directory(path, error)) {
+            for (const auto& entry : fs::directory_iterator(path, error))
+                if (entry.is_regular_file() && is_source_image(entry.path()))
+                    if (!import_image(entry.path(), compress)) failed_count++;
+        } else if (!import_image(path, compress)) failed_count++;
+
+        if (error) {
+            std::cout << "Failed to read " << path << " (" << error.message()
+                      << ")." << std::endl;
+            failed_count++;
+        }
+    }
+
+    return failed_count == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}